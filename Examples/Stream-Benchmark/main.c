@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "StreamBuffer.h"
+
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    #include <pthread.h>
+#endif
+
+/**
+ * Compare single value functions in loop with array functions,
+ * both byte orders, different element counts, with mutex driver if enabled,
+ * then compare 20 field message with and without transaction,
+ * and snprintf text line through staging buffer with Stream_reserve/Stream_commit in place,
+ * then compare uint32 codecs, fixed width array, LEB128 varint and packed (stream-vbyte) array
+ */
+
+#define STREAM_SIZE                 20000
+#define TOTAL_ELEMENTS              (4UL * 1024UL * 1024UL)
+#define TOTAL_MESSAGES              (1024UL * 1024UL)
+#define MESSAGE_LEN                 (5 * (1 + 2 + 4 + 4))
+#define TEXT_LEN                    32
+#define CODEC_COUNT                 2048
+
+typedef void (*Bench_Fn)(StreamBuffer* stream, void* val, Stream_LenType len);
+typedef void (*Codec_Fn)(StreamBuffer* stream, uint32_t* val, Stream_LenType len);
+
+static uint8_t streamBuff[STREAM_SIZE];
+static uint8_t values[2048 * sizeof(uint64_t)];
+static unsigned long lockCount;
+static uint32_t codecValues[CODEC_COUNT];
+static uint32_t codecOut[CODEC_COUNT];
+
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+static Stream_MutexResult Pthread_mutexInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    pthread_mutexattr_t attr;
+    pthread_mutex_t* m = malloc(sizeof(pthread_mutex_t));
+    if (!m) {
+        return -1;
+    }
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(m, &attr);
+    pthread_mutexattr_destroy(&attr);
+    *mutex = m;
+    return 0;
+}
+static Stream_MutexResult Pthread_mutexLock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    lockCount++;
+    return pthread_mutex_lock((pthread_mutex_t*) *mutex);
+}
+static Stream_MutexResult Pthread_mutexUnlock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return pthread_mutex_unlock((pthread_mutex_t*) *mutex);
+}
+static Stream_MutexResult Pthread_mutexDeInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    pthread_mutex_destroy((pthread_mutex_t*) *mutex);
+    free(*mutex);
+    *mutex = NULL;
+    return 0;
+}
+static const Stream_MutexDriver PTHREAD_MUTEX_DRIVER = {
+    .init = Pthread_mutexInit,
+    .lock = Pthread_mutexLock,
+    .unlock = Pthread_mutexUnlock,
+    .deinit = Pthread_mutexDeInit,
+};
+#endif
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+#define BENCH_FUNCTIONS(TYPE, VAL_TY) \
+static void loop ##TYPE(StreamBuffer* stream, void* val, Stream_LenType len) { \
+    VAL_TY* p = (VAL_TY*) val; \
+    Stream_LenType i; \
+    for (i = 0; i < len; i++) { \
+        Stream_write ##TYPE(stream, p[i]); \
+    } \
+    for (i = 0; i < len; i++) { \
+        p[i] = Stream_read ##TYPE(stream); \
+    } \
+} \
+static void array ##TYPE(StreamBuffer* stream, void* val, Stream_LenType len) { \
+    Stream_write ##TYPE ##Array(stream, (VAL_TY*) val, len); \
+    Stream_read ##TYPE ##Array(stream, (VAL_TY*) val, len); \
+}
+
+BENCH_FUNCTIONS(UInt16, uint16_t)
+BENCH_FUNCTIONS(UInt32, uint32_t)
+BENCH_FUNCTIONS(UInt64, uint64_t)
+
+static double runBench(Bench_Fn fn, ByteOrder order, Stream_LenType count) {
+    StreamBuffer stream;
+    unsigned long iterations = TOTAL_ELEMENTS / count;
+    unsigned long i;
+    double elapsed;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    Stream_setMutex(&stream, &PTHREAD_MUTEX_DRIVER);
+    Stream_mutexInit(&stream);
+#endif
+#if STREAM_BYTE_ORDER
+    Stream_setByteOrder(&stream, order);
+#endif
+
+    elapsed = now();
+    for (i = 0; i < iterations; i++) {
+        fn(&stream, values, count);
+    }
+    elapsed = now() - elapsed;
+
+    Stream_deinit(&stream);
+    // ns per element for write + read
+    return elapsed * 1e9 / (iterations * count);
+}
+
+static void bench(const char* name, Bench_Fn loopFn, Bench_Fn arrayFn) {
+    static const Stream_LenType COUNTS[] = {16, 256, 2048};
+    static const char* ORDERS[] = {"LE", "BE"};
+    ByteOrder order;
+    int i;
+
+    for (order = ByteOrder_LittleEndian; order <= ByteOrder_BigEndian; order++) {
+        for (i = 0; i < (int) (sizeof(COUNTS) / sizeof(COUNTS[0])); i++) {
+            double loopNs = runBench(loopFn, order, COUNTS[i]);
+            double arrayNs = runBench(arrayFn, order, COUNTS[i]);
+            printf("%-8s %-2s %6d %10.2f %10.2f %8.1fx\n",
+                name, ORDERS[order], (int) COUNTS[i], loopNs, arrayNs, loopNs / arrayNs);
+        }
+    }
+}
+
+/**
+ * @brief write and read message with 20 fields, 5 x (UInt8, UInt16, UInt32, Float)
+ */
+static void message(StreamBuffer* stream, uint32_t seq) {
+    int i;
+    for (i = 0; i < 5; i++) {
+        Stream_writeUInt8(stream, (uint8_t) seq);
+        Stream_writeUInt16(stream, (uint16_t) seq);
+        Stream_writeUInt32(stream, seq);
+        Stream_writeFloat(stream, (float) seq);
+    }
+    for (i = 0; i < 5; i++) {
+        seq += Stream_readUInt8(stream);
+        seq += Stream_readUInt16(stream);
+        seq += Stream_readUInt32(stream);
+        seq += (uint32_t) Stream_readFloat(stream);
+    }
+}
+#if STREAM_TRANSACTION
+static void messageTransaction(StreamBuffer* stream, uint32_t seq) {
+    int i;
+    Stream_beginWrite(stream, MESSAGE_LEN);
+    for (i = 0; i < 5; i++) {
+        Stream_writeUInt8(stream, (uint8_t) seq);
+        Stream_writeUInt16(stream, (uint16_t) seq);
+        Stream_writeUInt32(stream, seq);
+        Stream_writeFloat(stream, (float) seq);
+    }
+    Stream_endWrite(stream);
+    Stream_beginRead(stream, MESSAGE_LEN);
+    for (i = 0; i < 5; i++) {
+        seq += Stream_readUInt8(stream);
+        seq += Stream_readUInt16(stream);
+        seq += Stream_readUInt32(stream);
+        seq += (uint32_t) Stream_readFloat(stream);
+    }
+    Stream_endRead(stream);
+}
+#endif
+
+/**
+ * @brief format text line with snprintf, into staging buffer then copy into stream
+ */
+static void textStaging(StreamBuffer* stream, uint32_t seq) {
+    char line[TEXT_LEN];
+    int len = snprintf(line, sizeof(line), "id=%u value=%u\n", seq, seq * 7);
+
+    Stream_writeBytes(stream, (uint8_t*) line, (Stream_LenType) len);
+    Stream_moveReadPos(stream, (Stream_LenType) len);
+}
+#if STREAM_WRITE_RESERVE
+/**
+ * @brief format text line with snprintf directly into ring, staging only when region wrap
+ */
+static void textReserve(StreamBuffer* stream, uint32_t seq) {
+    uint8_t* ptr;
+    int len;
+
+    if (Stream_reserve(stream, TEXT_LEN, &ptr) == Stream_Ok) {
+        len = snprintf((char*) ptr, TEXT_LEN, "id=%u value=%u\n", seq, seq * 7);
+        Stream_commit(stream, (Stream_LenType) len);
+    }
+    else {
+        char line[TEXT_LEN];
+        len = snprintf(line, sizeof(line), "id=%u value=%u\n", seq, seq * 7);
+        Stream_writeBytes(stream, (uint8_t*) line, (Stream_LenType) len);
+    }
+    Stream_moveReadPos(stream, (Stream_LenType) len);
+}
+#endif
+
+static void benchMessage(const char* name, void (*fn)(StreamBuffer* stream, uint32_t seq)) {
+    StreamBuffer stream;
+    unsigned long i;
+    double elapsed;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    Stream_setMutex(&stream, &PTHREAD_MUTEX_DRIVER);
+    Stream_mutexInit(&stream);
+#endif
+    lockCount = 0;
+
+    elapsed = now();
+    for (i = 0; i < TOTAL_MESSAGES; i++) {
+        fn(&stream, (uint32_t) i);
+    }
+    elapsed = now() - elapsed;
+
+    Stream_deinit(&stream);
+    printf("%-12s %10.2f %12.1f\n", name, elapsed * 1e9 / TOTAL_MESSAGES, (double) lockCount / TOTAL_MESSAGES);
+}
+
+static void fixedWrite(StreamBuffer* stream, uint32_t* val, Stream_LenType len) {
+    Stream_writeUInt32Array(stream, val, len);
+}
+static void fixedRead(StreamBuffer* stream, uint32_t* val, Stream_LenType len) {
+    Stream_readUInt32Array(stream, val, len);
+}
+#if STREAM_WRITE_VAR_INT && STREAM_READ_VAR_INT
+static void varIntWrite(StreamBuffer* stream, uint32_t* val, Stream_LenType len) {
+    Stream_LenType i;
+    for (i = 0; i < len; i++) {
+        Stream_writeVarUInt32(stream, val[i]);
+    }
+}
+static void varIntRead(StreamBuffer* stream, uint32_t* val, Stream_LenType len) {
+    Stream_LenType i;
+    for (i = 0; i < len; i++) {
+        Stream_readVarUInt32(stream, &val[i]);
+    }
+}
+#endif
+#if STREAM_WRITE_ARRAY_PACKED && STREAM_READ_ARRAY_PACKED
+static void packedWrite(StreamBuffer* stream, uint32_t* val, Stream_LenType len) {
+    Stream_writeUInt32ArrayPacked(stream, val, len);
+}
+static void packedRead(StreamBuffer* stream, uint32_t* val, Stream_LenType len) {
+    Stream_readUInt32ArrayPacked(stream, val, len);
+}
+#endif
+
+/**
+ * @brief write and read CODEC_COUNT values, decode speed in GB/s of uint32 output
+ */
+static void benchCodec(const char* name, Codec_Fn writeFn, Codec_Fn readFn) {
+    StreamBuffer stream;
+    unsigned long iterations = TOTAL_ELEMENTS / CODEC_COUNT;
+    unsigned long i;
+    double writeTime = 0;
+    double readTime = 0;
+    double start;
+    Stream_LenType encoded = 0;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    Stream_setMutex(&stream, &PTHREAD_MUTEX_DRIVER);
+    Stream_mutexInit(&stream);
+#endif
+
+    for (i = 0; i < iterations; i++) {
+        start = now();
+        writeFn(&stream, codecValues, CODEC_COUNT);
+        writeTime += now() - start;
+        encoded = Stream_available(&stream);
+        start = now();
+        readFn(&stream, codecOut, CODEC_COUNT);
+        readTime += now() - start;
+    }
+
+    Stream_deinit(&stream);
+    printf("%-8s %10.2f %10.2f %10.2f %10.2f %s\n", name,
+        (double) encoded / CODEC_COUNT,
+        writeTime * 1e9 / (iterations * CODEC_COUNT),
+        readTime * 1e9 / (iterations * CODEC_COUNT),
+        (double) iterations * CODEC_COUNT * sizeof(uint32_t) / readTime / 1e9,
+        memcmp(codecValues, codecOut, sizeof(codecValues)) ? "FAILED" : "");
+}
+
+int main()
+{
+    int i;
+    for (i = 0; i < (int) sizeof(values); i++) {
+        values[i] = (uint8_t) i;
+    }
+    // mostly small values, 5/8 fit in 1 byte, 2/8 in 2 bytes, 1/8 full width
+    for (i = 0; i < CODEC_COUNT; i++) {
+        uint32_t r = (uint32_t) i * 2654435761UL;
+        codecValues[i] = (i & 7) < 5 ? r >> 24 : (i & 7) < 7 ? r >> 16 : r;
+    }
+
+    printf("%-8s %-2s %6s %10s %10s %9s\n", "Type", "BO", "Count", "Loop ns", "Array ns", "Speedup");
+    bench("UInt16", loopUInt16, arrayUInt16);
+    bench("UInt32", loopUInt32, arrayUInt32);
+    bench("UInt64", loopUInt64, arrayUInt64);
+
+    printf("\n%-12s %10s %12s\n", "Message", "ns/msg", "locks/msg");
+    benchMessage("Fields", message);
+#if STREAM_TRANSACTION
+    benchMessage("Transaction", messageTransaction);
+#endif
+    benchMessage("Staging", textStaging);
+#if STREAM_WRITE_RESERVE
+    benchMessage("Reserve", textReserve);
+#endif
+
+    printf("\n%-8s %10s %10s %10s %10s\n", "Codec", "bytes/val", "write ns", "read ns", "read GB/s");
+    benchCodec("Fixed", fixedWrite, fixedRead);
+#if STREAM_WRITE_VAR_INT && STREAM_READ_VAR_INT
+    benchCodec("VarInt", varIntWrite, varIntRead);
+#endif
+#if STREAM_WRITE_ARRAY_PACKED && STREAM_READ_ARRAY_PACKED
+    benchCodec("Packed", packedWrite, packedRead);
+#endif
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "StreamFd.h"
+
+/**
+ * Pipe throughput test, OStream write into pipe and IStream read from other side in same thread,
+ * compare StreamFd driver (readv/writev over both segments) with hand written read/write driver
+ * that use one syscall for each segment
+ */
+
+#if !STREAM_FD
+    #error "Stream-Fd example need STREAM_FD"
+#endif
+
+#define STREAM_SIZE                 5000
+#define CHUNK_SIZE                  1000
+#define TOTAL_BYTES                 (256UL * 1024UL * 1024UL)
+
+typedef Stream_Result (*Fd_InitInFn)(StreamIn* stream, int fd, uint8_t* buff, Stream_LenType size);
+typedef Stream_Result (*Fd_InitOutFn)(StreamOut* stream, int fd, uint8_t* buff, Stream_LenType size);
+typedef Stream_Result (*Fd_HandleInFn)(StreamIn* stream);
+typedef Stream_Result (*Fd_HandleOutFn)(StreamOut* stream);
+
+static uint8_t inBuff[STREAM_SIZE];
+static uint8_t outBuff[STREAM_SIZE];
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/* ------------------------ Segment driver, old glue code ------------------------ */
+static Stream_Result Segment_receive(StreamIn* stream, uint8_t* buff, Stream_LenType len) {
+    ssize_t n = read(IStream_getFd(stream), buff, len);
+    if (n > 0) {
+        return IStream_handle(stream, (Stream_LenType) n);
+    }
+    return n < 0 && errno == EAGAIN ? Stream_Ok : Stream_ReceiveFailed;
+}
+static Stream_Result Segment_transmit(StreamOut* stream, uint8_t* buff, Stream_LenType len) {
+    ssize_t n = write(OStream_getFd(stream), buff, len);
+    if (n > 0) {
+        Stream_Result res = OStream_handle(stream, (Stream_LenType) n);
+        return res == Stream_NoAvailable ? Stream_Ok : res;
+    }
+    return n < 0 && errno == EAGAIN ? Stream_Ok : Stream_TransmitFailed;
+}
+static Stream_Result Segment_initIn(StreamIn* stream, int fd, uint8_t* buff, Stream_LenType size) {
+    // use fd driver only for non-blocking mode
+    IStream_initFd(stream, fd, buff, size);
+    stream->receive = Segment_receive;
+    return Stream_Ok;
+}
+static Stream_Result Segment_initOut(StreamOut* stream, int fd, uint8_t* buff, Stream_LenType size) {
+    OStream_initFd(stream, fd, buff, size);
+    stream->transmit = Segment_transmit;
+    return Stream_Ok;
+}
+static Stream_Result Segment_handleIn(StreamIn* stream) {
+    if (IStream_inReceive(stream)) {
+        return Segment_receive(stream, IStream_getDataPtr(stream), stream->Buffer.PendingBytes);
+    }
+    return IStream_receive(stream);
+}
+static Stream_Result Segment_handleOut(StreamOut* stream) {
+    Stream_Result res;
+    if (stream->Buffer.InTransmit) {
+        return Segment_transmit(stream, OStream_getDataPtr(stream), stream->Buffer.PendingBytes);
+    }
+    res = OStream_flush(stream);
+    return res == Stream_NoAvailable ? Stream_Ok : res;
+}
+/* -------------------------------------------------------------------------------- */
+static int runTest(const char* name, Fd_InitInFn initIn, Fd_InitOutFn initOut, Fd_HandleInFn handleIn, Fd_HandleOutFn handleOut) {
+    uint8_t chunk[CHUNK_SIZE];
+    StreamIn in;
+    StreamOut out;
+    unsigned long sent = 0;
+    unsigned long received = 0;
+    uint8_t writeSeq = 0;
+    uint8_t readSeq = 0;
+    Stream_LenType len;
+    double elapsed;
+    int errors = 0;
+    int fds[2];
+    int i;
+
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return 1;
+    }
+    initIn(&in, fds[0], inBuff, sizeof(inBuff));
+    initOut(&out, fds[1], outBuff, sizeof(outBuff));
+
+    elapsed = now();
+    while (received < TOTAL_BYTES && !errors) {
+        while (sent < TOTAL_BYTES && OStream_space(&out) >= CHUNK_SIZE) {
+            for (i = 0; i < CHUNK_SIZE; i++) {
+                chunk[i] = writeSeq++;
+            }
+            OStream_writeBytes(&out, chunk, CHUNK_SIZE);
+            sent += CHUNK_SIZE;
+        }
+        if (handleOut(&out) != Stream_Ok) {
+            errors++;
+        }
+        handleIn(&in);
+        while ((len = IStream_available(&in)) > 0) {
+            len = len < CHUNK_SIZE ? len : CHUNK_SIZE;
+            IStream_readBytes(&in, chunk, len);
+            for (i = 0; i < len; i++) {
+                if (chunk[i] != readSeq++) {
+                    errors++;
+                    break;
+                }
+            }
+            received += len;
+        }
+    }
+    elapsed = now() - elapsed;
+
+    printf("%-10s %6.1f MB in %7.3f s, %8.1f MB/s %s\n",
+        name, received / (1024.0 * 1024.0), elapsed, received / (1024.0 * 1024.0) / elapsed,
+        errors ? "FAILED" : "OK");
+
+    close(fds[0]);
+    close(fds[1]);
+    return errors;
+}
+
+int main()
+{
+    int errors = 0;
+
+    errors += runTest("Segment", Segment_initIn, Segment_initOut, Segment_handleIn, Segment_handleOut);
+    errors += runTest("StreamFd", IStream_initFd, OStream_initFd, IStream_handleFd, OStream_handleFd);
+
+    return errors != 0;
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "StreamLoop.h"
+
+/**
+ * Socketpair echo stress test, each client send fixed size message with timestamp and server
+ * echo it back, client send next message when echo received, all connections driven by single
+ * StreamLoop, report messages/sec and p99 round trip latency for different number of connections
+ */
+
+#if !STREAM_LOOP
+    #error "Stream-Loop example need STREAM_LOOP"
+#endif
+
+#define MAX_CONNS                   1024
+#define STREAM_SIZE                 1024
+#define MSG_SIZE                    64
+#define TOTAL_MESSAGES              200000UL
+
+typedef struct {
+    StreamIn            In;
+    StreamOut           Out;
+    StreamLoop_Conn     Conn;
+    uint8_t             InBuff[STREAM_SIZE];
+    uint8_t             OutBuff[STREAM_SIZE];
+} Peer;
+
+static Peer clients[MAX_CONNS];
+static Peer servers[MAX_CONNS];
+static uint32_t remaining[MAX_CONNS];
+static uint64_t latency[TOTAL_MESSAGES];
+static unsigned long received;
+static int errors;
+
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static int compareU64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+    return x < y ? -1 : x > y;
+}
+
+static void sendMessage(Peer* client) {
+    uint8_t msg[MSG_SIZE];
+    uint64_t ts = nowNs();
+
+    memset(msg, 0x5A, sizeof(msg));
+    memcpy(msg, &ts, sizeof(ts));
+    OStream_writeBytes(&client->Out, msg, sizeof(msg));
+    if (StreamLoop_flush(&client->Conn) != Stream_Ok) {
+        errors++;
+    }
+}
+/**
+ * @brief server echo each complete message
+ */
+static void Server_onReceive(StreamIn* stream, Stream_LenType len) {
+    Peer* server = (Peer*) stream;
+    uint8_t msg[MSG_SIZE];
+
+    while (IStream_available(&server->In) >= MSG_SIZE) {
+        IStream_readBytes(&server->In, msg, sizeof(msg));
+        OStream_writeBytes(&server->Out, msg, sizeof(msg));
+    }
+    if (StreamLoop_flush(&server->Conn) != Stream_Ok) {
+        errors++;
+    }
+}
+/**
+ * @brief client record latency of each echo and send next message
+ */
+static void Client_onReceive(StreamIn* stream, Stream_LenType len) {
+    int index = (int) ((Peer*) stream - clients);
+    uint8_t msg[MSG_SIZE];
+    uint64_t ts;
+
+    while (IStream_available(&clients[index].In) >= MSG_SIZE) {
+        IStream_readBytes(&clients[index].In, msg, sizeof(msg));
+        memcpy(&ts, msg, sizeof(ts));
+        latency[received++] = nowNs() - ts;
+        if (remaining[index] > 0) {
+            remaining[index]--;
+            sendMessage(&clients[index]);
+        }
+    }
+}
+
+static void Peer_init(Peer* peer, StreamLoop* loop, int fd, IStream_OnReceiveFn onReceive) {
+    IStream_initFd(&peer->In, fd, peer->InBuff, STREAM_SIZE);
+    OStream_initFd(&peer->Out, fd, peer->OutBuff, STREAM_SIZE);
+    IStream_onReceive(&peer->In, onReceive);
+    if (StreamLoop_add(loop, &peer->Conn, &peer->In, &peer->Out) != Stream_Ok) {
+        errors++;
+    }
+}
+
+static int runTest(int conns) {
+    StreamLoop loop;
+    unsigned long total;
+    uint64_t elapsed;
+    int fds[2];
+    int i;
+
+    total = (TOTAL_MESSAGES / conns) * conns;
+    received = 0;
+    errors = 0;
+    if (StreamLoop_init(&loop) != Stream_Ok) {
+        perror("epoll_create1");
+        return 1;
+    }
+    for (i = 0; i < conns; i++) {
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            perror("socketpair");
+            return 1;
+        }
+        // Peer start with StreamIn, so stream pointer is peer pointer
+        Peer_init(&clients[i], &loop, fds[0], Client_onReceive);
+        Peer_init(&servers[i], &loop, fds[1], Server_onReceive);
+        remaining[i] = (uint32_t) (total / conns) - 1;
+    }
+
+    elapsed = nowNs();
+    for (i = 0; i < conns; i++) {
+        sendMessage(&clients[i]);
+    }
+    while (received < total && !errors) {
+        if (StreamLoop_run(&loop, 1000) <= 0) {
+            errors++;
+        }
+    }
+    elapsed = nowNs() - elapsed;
+
+    qsort(latency, received, sizeof(latency[0]), compareU64);
+    printf("%5d conns %8lu msgs in %7.3f s, %10.0f msg/s, p50 %7.1f us, p99 %7.1f us %s\n",
+        conns, received, elapsed / 1e9, received / (elapsed / 1e9),
+        received ? latency[received / 2] / 1e3 : 0.0,
+        received ? latency[(received * 99) / 100] / 1e3 : 0.0,
+        errors ? "FAILED" : "OK");
+
+    for (i = 0; i < conns; i++) {
+        StreamLoop_remove(&clients[i].Conn);
+        StreamLoop_remove(&servers[i].Conn);
+        close(IStream_getFd(&clients[i].In));
+        close(IStream_getFd(&servers[i].In));
+    }
+    StreamLoop_deinit(&loop);
+    return errors;
+}
+
+int main()
+{
+    static const int CONNS[] = { 1, 16, 64, 256, 1024 };
+    int failed = 0;
+    unsigned i;
+
+    for (i = 0; i < sizeof(CONNS) / sizeof(CONNS[0]); i++) {
+        failed += runTest(CONNS[i]);
+    }
+
+    return failed != 0;
+}
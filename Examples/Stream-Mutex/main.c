@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "StreamMutex.h"
+
+/**
+ * Contention test, N producer threads write UInt32 values into one stream
+ * and N consumer threads read them, all threads lock same stream for every value,
+ * each value take 3 nested lock/unlock pairs (outer lock, space/available check and copy).
+ * Stream-Mutex run bundled drivers (pthread, spin, atomic) through Stream_MutexDriver,
+ * Stream-Mutex-BuiltIn build with STREAM_MUTEX_BUILT_IN and atomic lock inlined,
+ * run both of them to compare cost of each lock and driver indirection
+ */
+
+#if !STREAM_MUTEX_POSIX || (STREAM_MUTEX != STREAM_MUTEX_DRIVER && STREAM_MUTEX != STREAM_MUTEX_BUILT_IN)
+    #error "Stream-Mutex example need STREAM_MUTEX_POSIX with STREAM_MUTEX_DRIVER or STREAM_MUTEX_BUILT_IN"
+#endif
+
+#define STREAM_SIZE                 4096
+#define TOTAL_VALUES                (1024UL * 1024UL)
+#define MAX_THREADS                 4
+
+typedef struct {
+    const char*                 Name;
+    const Stream_MutexDriver*   Driver;
+} Lock;
+
+static uint8_t streamBuff[STREAM_SIZE];
+static StreamBuffer stream;
+static unsigned long perThread;
+static uint64_t sums[MAX_THREADS];
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/**
+ * @brief many producers write same stream, so space check and write must happen under one lock,
+ * stream functions lock again inside it (recursive), NoSpace only mean retry
+ */
+static void* producer(void* args) {
+    Stream_Result res;
+    uint32_t val;
+    unsigned long i;
+
+    for (i = 0; i < perThread; i++) {
+        val = (uint32_t) i;
+        do {
+            Stream_mutexLock(&stream);
+            res = Stream_writeBytes(&stream, (uint8_t*) &val, sizeof(val));
+            Stream_mutexUnlock(&stream);
+            if (res != Stream_Ok) {
+                sched_yield();
+            }
+        } while (res != Stream_Ok);
+    }
+    return NULL;
+}
+
+static void* consumer(void* args) {
+    uint64_t* sum = (uint64_t*) args;
+    Stream_Result res;
+    uint32_t val;
+    unsigned long i;
+
+    for (i = 0; i < perThread; i++) {
+        do {
+            Stream_mutexLock(&stream);
+            res = Stream_readBytes(&stream, (uint8_t*) &val, sizeof(val));
+            Stream_mutexUnlock(&stream);
+            if (res != Stream_Ok) {
+                sched_yield();
+            }
+        } while (res != Stream_Ok);
+        *sum += val;
+    }
+    return NULL;
+}
+
+static int runTest(const Lock* lock, int threads) {
+    pthread_t producers[MAX_THREADS];
+    pthread_t consumers[MAX_THREADS];
+    uint64_t expected;
+    uint64_t sum = 0;
+    double elapsed;
+    int i;
+
+    perThread = TOTAL_VALUES / threads;
+    expected = (uint64_t) threads * ((uint64_t) perThread * (perThread - 1) / 2);
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    Stream_setMutex(&stream, lock->Driver);
+    if (Stream_mutexInit(&stream) != 0) {
+        printf("%-8s mutex init failed\n", lock->Name);
+        return 1;
+    }
+#endif
+
+    elapsed = now();
+    for (i = 0; i < threads; i++) {
+        sums[i] = 0;
+        pthread_create(&consumers[i], NULL, consumer, &sums[i]);
+        pthread_create(&producers[i], NULL, producer, NULL);
+    }
+    for (i = 0; i < threads; i++) {
+        pthread_join(producers[i], NULL);
+        pthread_join(consumers[i], NULL);
+        sum += sums[i];
+    }
+    elapsed = now() - elapsed;
+
+    Stream_deinit(&stream);
+
+    printf("%-8s %d+%d threads %8lu values in %7.3f s, %7.1f ns/value %s\n",
+        lock->Name, threads, threads, perThread * threads, elapsed,
+        elapsed * 1e9 / (perThread * threads), sum != expected ? "FAILED" : "OK");
+
+    return sum != expected;
+}
+
+int main()
+{
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    static const Lock LOCKS[] = {
+        { "pthread", &STREAM_MUTEX_PTHREAD_DRIVER },
+        { "spin", &STREAM_MUTEX_SPIN_DRIVER },
+        { "atomic", &STREAM_MUTEX_ATOMIC_DRIVER },
+    };
+#else
+    static const Lock LOCKS[] = {
+        { "built-in", NULL },
+    };
+#endif
+    int errors = 0;
+    unsigned i;
+    int threads;
+
+    for (i = 0; i < sizeof(LOCKS) / sizeof(LOCKS[0]); i++) {
+        for (threads = 1; threads <= MAX_THREADS; threads *= 2) {
+            errors += runTest(&LOCKS[i], threads);
+        }
+    }
+
+    return errors != 0;
+}
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#include "StreamBuffer.h"
+
+/**
+ * Two thread throughput test, one producer thread write into stream
+ * and one consumer thread read from it and verify data.
+ * Stream-SPSC build with STREAM_MUTEX_DRIVER and Stream-SPSC-LockFree build with STREAM_SPSC,
+ * run both of them to compare results
+ */
+
+#define STREAM_SIZE                 4096
+#define CHUNK_SIZE                  64
+#define TOTAL_BYTES                 (64UL * 1024UL * 1024UL)
+#define TOTAL_VALUES                (4UL * 1024UL * 1024UL)
+
+#if STREAM_SPSC
+    #define MODE_NAME               "STREAM_SPSC"
+#elif STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    #define MODE_NAME               "STREAM_MUTEX_DRIVER"
+#else
+    #error "Stream-SPSC example need STREAM_SPSC or STREAM_MUTEX_DRIVER"
+#endif
+
+typedef void* (*Thread_Fn)(void* args);
+
+static uint8_t streamBuff[STREAM_SIZE];
+static StreamBuffer stream;
+static volatile int errors = 0;
+
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+static Stream_MutexResult Pthread_mutexInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    pthread_mutexattr_t attr;
+    pthread_mutex_t* m = malloc(sizeof(pthread_mutex_t));
+    if (!m) {
+        return -1;
+    }
+    // stream functions lock again in nested calls, so mutex must be recursive
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(m, &attr);
+    pthread_mutexattr_destroy(&attr);
+    *mutex = m;
+    return 0;
+}
+static Stream_MutexResult Pthread_mutexLock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return pthread_mutex_lock((pthread_mutex_t*) *mutex);
+}
+static Stream_MutexResult Pthread_mutexUnlock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return pthread_mutex_unlock((pthread_mutex_t*) *mutex);
+}
+static Stream_MutexResult Pthread_mutexDeInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    pthread_mutex_destroy((pthread_mutex_t*) *mutex);
+    free(*mutex);
+    *mutex = NULL;
+    return 0;
+}
+static const Stream_MutexDriver PTHREAD_MUTEX_DRIVER = {
+    .init = Pthread_mutexInit,
+    .lock = Pthread_mutexLock,
+    .unlock = Pthread_mutexUnlock,
+    .deinit = Pthread_mutexDeInit,
+};
+#endif
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* producerBytes(void* args) {
+    uint8_t chunk[CHUNK_SIZE];
+    uint8_t seq = 0;
+    unsigned long sent = 0;
+
+    while (sent < TOTAL_BYTES && !errors) {
+        if (Stream_space(&stream) < CHUNK_SIZE) {
+            sched_yield();
+            continue;
+        }
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            chunk[i] = seq++;
+        }
+        Stream_writeBytes(&stream, chunk, CHUNK_SIZE);
+        sent += CHUNK_SIZE;
+    }
+    return NULL;
+}
+
+static void* consumerBytes(void* args) {
+    uint8_t chunk[CHUNK_SIZE];
+    uint8_t seq = 0;
+    unsigned long received = 0;
+
+    while (received < TOTAL_BYTES) {
+        if (Stream_available(&stream) < CHUNK_SIZE) {
+            sched_yield();
+            continue;
+        }
+        Stream_readBytes(&stream, chunk, CHUNK_SIZE);
+        for (int i = 0; i < CHUNK_SIZE; i++) {
+            if (chunk[i] != seq++) {
+                errors++;
+                return NULL;
+            }
+        }
+        received += CHUNK_SIZE;
+    }
+    return NULL;
+}
+
+static void* producerValues(void* args) {
+    uint32_t val = 0;
+
+    while (val < TOTAL_VALUES && !errors) {
+        if (Stream_space(&stream) < sizeof(uint32_t)) {
+            sched_yield();
+            continue;
+        }
+        Stream_writeUInt32(&stream, val);
+        val++;
+    }
+    return NULL;
+}
+
+static void* consumerValues(void* args) {
+    uint32_t expected = 0;
+    uint32_t val;
+
+    while (expected < TOTAL_VALUES) {
+        if (Stream_available(&stream) < sizeof(uint32_t)) {
+            sched_yield();
+            continue;
+        }
+        Stream_readUInt32Safe(&stream, val);
+        if (val != expected++) {
+            errors++;
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+static void runTest(const char* name, Thread_Fn producer, Thread_Fn consumer, unsigned long bytes) {
+    pthread_t producerThread;
+    pthread_t consumerThread;
+    double elapsed;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    Stream_setMutex(&stream, &PTHREAD_MUTEX_DRIVER);
+    Stream_mutexInit(&stream);
+#endif
+
+    elapsed = now();
+    pthread_create(&consumerThread, NULL, consumer, NULL);
+    pthread_create(&producerThread, NULL, producer, NULL);
+    pthread_join(producerThread, NULL);
+    pthread_join(consumerThread, NULL);
+    elapsed = now() - elapsed;
+
+    printf("[%s] %-14s %6.1f MB in %7.3f s, %8.1f MB/s %s\n",
+        MODE_NAME, name, bytes / (1024.0 * 1024.0), elapsed,
+        bytes / (1024.0 * 1024.0) / elapsed, errors ? "FAILED" : "OK");
+
+    Stream_deinit(&stream);
+}
+
+int main()
+{
+    runTest("Bytes x64", producerBytes, consumerBytes, TOTAL_BYTES);
+    runTest("UInt32 x1", producerValues, consumerValues, TOTAL_VALUES * sizeof(uint32_t));
+
+    return errors != 0;
+}
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "StreamFd.h"
+
+/**
+ * Pipe throughput test, OStream write into pipe and child process read from other side,
+ * compare StreamFd driver (writev copy bytes into pipe) with splice driver (vmsplice reference
+ * ring pages), for different flush sizes
+ */
+
+#if !STREAM_FD || !STREAM_FD_SPLICE || !STREAM_LEN_LARGE
+    #error "Stream-Splice example need STREAM_FD, STREAM_FD_SPLICE and STREAM_LEN_LARGE"
+#endif
+
+#ifndef F_SETPIPE_SZ
+    #define F_SETPIPE_SZ            1031
+#endif
+
+#define MAX_FLUSH_SIZE              (4UL * 1024UL * 1024UL)
+#define TOTAL_BYTES                 (2048UL * 1024UL * 1024UL)
+#define READ_SIZE                   (256UL * 1024UL)
+
+typedef Stream_Result (*Splice_HandleFn)(StreamOut* stream);
+
+static uint8_t outBuff[MAX_FLUSH_SIZE * 2];
+static uint8_t readBuff[READ_SIZE];
+static OStream_Splice splice;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+/**
+ * @brief child process, read until end of file and check first and last byte of each read,
+ * each flush block filled with index of block
+ */
+static int reader(int fd, unsigned long flushSize) {
+    unsigned long pos = 0;
+    ssize_t len;
+
+    while ((len = read(fd, readBuff, sizeof(readBuff))) > 0) {
+        if (readBuff[0] != (uint8_t) (pos / flushSize) ||
+            readBuff[len - 1] != (uint8_t) ((pos + len - 1) / flushSize)) {
+            return 1;
+        }
+        pos += (unsigned long) len;
+    }
+    return len < 0 || pos != TOTAL_BYTES;
+}
+
+static Stream_Result Fd_init(StreamOut* stream, int fd, unsigned long size) {
+    return OStream_initFd(stream, fd, outBuff, (Stream_LenType) size);
+}
+
+static Stream_Result Splice_init(StreamOut* stream, int fd, unsigned long size) {
+    return OStream_initSplice(stream, &splice, fd, outBuff, (Stream_LenType) size);
+}
+
+static int runTest(const char* name, unsigned long flushSize,
+                   Stream_Result (*init)(StreamOut*, int, unsigned long), Splice_HandleFn handle) {
+    struct pollfd pfd;
+    StreamOut out;
+    unsigned long sent = 0;
+    double elapsed;
+    int errors = 0;
+    int status;
+    int fds[2];
+    pid_t pid;
+
+    if (pipe(fds) != 0) {
+        perror("pipe");
+        return 1;
+    }
+    // larger pipe, ignore error if pipe-max-size is smaller
+    fcntl(fds[1], F_SETPIPE_SZ, (int) (flushSize < 1024UL * 1024UL ? flushSize : 1024UL * 1024UL));
+
+    elapsed = now();
+    pid = fork();
+    if (pid == 0) {
+        close(fds[1]);
+        _exit(reader(fds[0], flushSize));
+    }
+    close(fds[0]);
+
+    init(&out, fds[1], flushSize * 2);
+    pfd.fd = fds[1];
+    pfd.events = POLLOUT;
+
+    while (sent < TOTAL_BYTES && !errors) {
+        while (OStream_space(&out) < flushSize && !errors) {
+            poll(&pfd, 1, 1);
+            errors += handle(&out) != Stream_Ok;
+        }
+        OStream_writePadding(&out, (uint8_t) (sent / flushSize), (Stream_LenType) flushSize);
+        sent += flushSize;
+        errors += handle(&out) != Stream_Ok;
+    }
+    while (OStream_pendingBytes(&out) > 0 && !errors) {
+        poll(&pfd, 1, 1);
+        errors += handle(&out) != Stream_Ok;
+    }
+    close(fds[1]);
+
+    waitpid(pid, &status, 0);
+    elapsed = now() - elapsed;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        errors++;
+    }
+
+    printf("%-9s flush %5lu KB %7.1f MB in %7.3f s, %8.1f MB/s %s\n",
+        name, flushSize / 1024, sent / (1024.0 * 1024.0), elapsed, sent / (1024.0 * 1024.0) / elapsed,
+        errors ? "FAILED" : "OK");
+
+    return errors;
+}
+
+int main()
+{
+    static const unsigned long FLUSH_SIZES[] = { 64UL * 1024UL, 256UL * 1024UL, 1024UL * 1024UL, MAX_FLUSH_SIZE };
+    int errors = 0;
+    unsigned i;
+
+    for (i = 0; i < sizeof(FLUSH_SIZES) / sizeof(FLUSH_SIZES[0]); i++) {
+        errors += runTest("write", FLUSH_SIZES[i], Fd_init, OStream_handleFd);
+        errors += runTest("vmsplice", FLUSH_SIZES[i], Splice_init, OStream_handleSplice);
+    }
+
+    return errors != 0;
+}
@@ -10,6 +10,36 @@
     #include "InputStream.h"
 #endif
 
+#if STREAM_FD
+    #include "StreamFd.h"
+    #include <unistd.h>
+#endif
+#if STREAM_FD_SPLICE
+    #include <signal.h>
+#endif
+#if STREAM_MUTEX_POSIX
+    #include "StreamMutex.h"
+#endif
+#if STREAM_LOOP
+    #include "StreamLoop.h"
+    #include <sys/socket.h>
+    #include <stdlib.h>
+#endif
+#if STREAM_CRC
+    #include "StreamCrc.h"
+#endif
+#if STREAM_PIPELINE
+    #include "StreamPipeline.h"
+#endif
+#if STREAM_COBS || STREAM_SLIP
+    #include "StreamCodec.h"
+#endif
+#if STREAM_URING
+    #include "StreamUring.h"
+    #include <unistd.h>
+    #include <sys/socket.h>
+#endif
+
 #include <time.h>
 
 #define CYCLES_NUM                          20
@@ -22,6 +52,19 @@
 #define START_CALCULATE_TIME()              SYSTEM_TIME_TYPE elapsed = GET_SYSTEM_TIME()
 #define CALCULATE_TIME()                    elapsed = GET_SYSTEM_TIME() - elapsed; \
                                             PRINTF("\n[Elapsed Time: %lu]\n\n", elapsed)
+// lock-free mode keep one byte of buffer empty, buffer that must hold N bytes need N + TEST_SPARE
+#if STREAM_SPSC
+    #define TEST_SPARE                      1
+#else
+    #define TEST_SPARE                      0
+#endif
+// size of stream buffer for N bytes, next power of two in STREAM_SIZE_POW2 mode
+#if STREAM_SIZE_POW2
+    #define TEST_SIZE(N)                    ((N) <= 8 ? 8 : (N) <= 16 ? 16 : (N) <= 32 ? 32 : (N) <= 64 ? 64 : (N) <= 128 ? 128 : \
+                                            (N) <= 256 ? 256 : (N) <= 512 ? 512 : 1024)
+#else
+    #define TEST_SIZE(N)                    (N)
+#endif
 
 volatile uint32_t assertResult;
 volatile uint8_t cycles;
@@ -63,10 +106,12 @@ void printHeader(const char* header, char c);
 typedef uint32_t (*Test_Fn)(void);
 
 #if STREAM_MUTEX
+#if STREAM_MUTEX != STREAM_MUTEX_BUILT_IN
 Stream_MutexResult TestStream_mutexInit(StreamBuffer* stream, Stream_Mutex* mutex);
 Stream_MutexResult TestStream_mutexLock(StreamBuffer* stream, Stream_Mutex* mutex);
 Stream_MutexResult TestStream_mutexUnlock(StreamBuffer* stream, Stream_Mutex* mutex);
 Stream_MutexResult TestStream_mutexDeInit(StreamBuffer* stream, Stream_Mutex* mutex);
+#endif
 
 #if   STREAM_MUTEX == STREAM_MUTEX_CUSTOM
     #define __setMutexDriver(S)         Stream_setMutex((S), TestStream_mutexInit, TestStream_mutexLock, TestStream_mutexUnlock, TestStream_mutexDeInit); \
@@ -91,6 +136,9 @@ Stream_MutexResult TestStream_mutexDeInit(StreamBuffer* stream, Stream_Mutex* mu
 
     #define __setMutexDriver(S)         Stream_setMutex(&TestStream_MutexDriver); \
                                         Stream_mutexInit((S))
+#elif STREAM_MUTEX == STREAM_MUTEX_BUILT_IN
+    // lock initialized by Stream_init
+    #define __setMutexDriver(S)
 #endif
 #else
     #define __setMutexDriver(S)
@@ -106,7 +154,7 @@ uint32_t Test_readWrite(void);
     uint32_t Test_IO_readStream(void);
 #endif
 #endif
-#if STREAM_WRITE_FLIP && STREAM_READ_FLIP
+#if STREAM_WRITE_FLIP && STREAM_READ_FLIP && !STREAM_SPSC
     uint32_t Test_flip(void);
 #endif
 #if STREAM_WRITE_ARRAY && STREAM_READ_ARRAY
@@ -142,6 +190,72 @@ uint32_t Test_readWrite(void);
     uint32_t Test_IO_transpose(void);
 #endif
 #endif
+#if STREAM_GET_AT && STREAM_SET_AT && STREAM_UINT8 && STREAM_UINT32
+    uint32_t Test_pow2(void);
+#endif
+#if STREAM_MIRRORED
+    uint32_t Test_mirrored(void);
+#endif
+#if STREAM_MEM_IO_BUILT_IN
+    uint32_t Test_memReverse(void);
+#endif
+#if STREAM_FIND_COMPILED_AT && STREAM_GET_AT && STREAM_READ_UNTIL_AT
+    uint32_t Test_findCompiled(void);
+#endif
+#if STREAM_FIND_ANY_OF_AT && STREAM_GET_AT && STREAM_READ_UNTIL_AT
+    uint32_t Test_findAnyOf(void);
+#endif
+#if STREAM_FIND_RESUME && STREAM_READ_UNTIL_AT && STREAM_FIND_COMPILED_AT && STREAM_FIND_ANY_OF_AT
+    uint32_t Test_findResume(void);
+#endif
+#if STREAM_IO_VEC
+    uint32_t Test_ioVec(void);
+#endif
+#if STREAM_TRANSFER
+    uint32_t Test_transfer(void);
+#endif
+#if STREAM_TRANSACTION && STREAM_WRITE_VALUE && STREAM_READ_VALUE
+    uint32_t Test_transaction(void);
+#endif
+#if STREAM_WRITE_RESERVE && STREAM_READ
+    uint32_t Test_reserve(void);
+#endif
+#if STREAM_BIP && STREAM_READ && STREAM_FIND
+    uint32_t Test_bip(void);
+#endif
+#if STREAM_FRAME && STREAM_BYTE_ORDER
+    uint32_t Test_frame(void);
+#endif
+#if STREAM_WRITE_VAR_INT && STREAM_READ_VAR_INT && STREAM_GET_AT_VAR_INT && STREAM_FIND_AT_VAR_INT && STREAM_FIND
+    uint32_t Test_varInt(void);
+#endif
+#if STREAM_WRITE_ARRAY_PACKED && STREAM_READ_ARRAY_PACKED
+    uint32_t Test_packed(void);
+#endif
+#if STREAM_CRC
+    uint32_t Test_crc(void);
+#endif
+#if STREAM_PIPELINE
+    uint32_t Test_pipeline(void);
+#endif
+#if STREAM_COBS && STREAM_SLIP
+    uint32_t Test_codec(void);
+#endif
+#if STREAM_MUTEX_POSIX && (STREAM_MUTEX == STREAM_MUTEX_DRIVER || STREAM_MUTEX == STREAM_MUTEX_BUILT_IN)
+    uint32_t Test_mutex(void);
+#endif
+#if STREAM_FD && ISTREAM && OSTREAM
+    uint32_t Test_fd(void);
+#endif
+#if STREAM_FD && STREAM_FD_SPLICE && OSTREAM
+    uint32_t Test_splice(void);
+#endif
+#if STREAM_URING && ISTREAM && OSTREAM
+    uint32_t Test_uring(void);
+#endif
+#if STREAM_LOOP
+    uint32_t Test_loop(void);
+#endif
 
 static const Test_Fn TESTS[] = {
     Test_readWrite,
@@ -154,7 +268,7 @@ static const Test_Fn TESTS[] = {
     Test_IO_readStream,
 #endif
 #endif
-#if STREAM_WRITE_FLIP && STREAM_READ_FLIP
+#if STREAM_WRITE_FLIP && STREAM_READ_FLIP && !STREAM_SPSC
     Test_flip,
 #endif
 #if STREAM_WRITE_ARRAY && STREAM_READ_ARRAY
@@ -190,6 +304,72 @@ static const Test_Fn TESTS[] = {
     Test_IO_transpose,
 #endif
 #endif
+#if STREAM_GET_AT && STREAM_SET_AT && STREAM_UINT8 && STREAM_UINT32
+    Test_pow2,
+#endif
+#if STREAM_MIRRORED
+    Test_mirrored,
+#endif
+#if STREAM_MEM_IO_BUILT_IN
+    Test_memReverse,
+#endif
+#if STREAM_FIND_COMPILED_AT && STREAM_GET_AT && STREAM_READ_UNTIL_AT
+    Test_findCompiled,
+#endif
+#if STREAM_FIND_ANY_OF_AT && STREAM_GET_AT && STREAM_READ_UNTIL_AT
+    Test_findAnyOf,
+#endif
+#if STREAM_FIND_RESUME && STREAM_READ_UNTIL_AT && STREAM_FIND_COMPILED_AT && STREAM_FIND_ANY_OF_AT
+    Test_findResume,
+#endif
+#if STREAM_IO_VEC
+    Test_ioVec,
+#endif
+#if STREAM_TRANSFER
+    Test_transfer,
+#endif
+#if STREAM_TRANSACTION && STREAM_WRITE_VALUE && STREAM_READ_VALUE
+    Test_transaction,
+#endif
+#if STREAM_WRITE_RESERVE && STREAM_READ
+    Test_reserve,
+#endif
+#if STREAM_BIP && STREAM_READ && STREAM_FIND
+    Test_bip,
+#endif
+#if STREAM_FRAME && STREAM_BYTE_ORDER
+    Test_frame,
+#endif
+#if STREAM_WRITE_VAR_INT && STREAM_READ_VAR_INT && STREAM_GET_AT_VAR_INT && STREAM_FIND_AT_VAR_INT && STREAM_FIND
+    Test_varInt,
+#endif
+#if STREAM_WRITE_ARRAY_PACKED && STREAM_READ_ARRAY_PACKED
+    Test_packed,
+#endif
+#if STREAM_CRC
+    Test_crc,
+#endif
+#if STREAM_PIPELINE
+    Test_pipeline,
+#endif
+#if STREAM_COBS && STREAM_SLIP
+    Test_codec,
+#endif
+#if STREAM_MUTEX_POSIX && (STREAM_MUTEX == STREAM_MUTEX_DRIVER || STREAM_MUTEX == STREAM_MUTEX_BUILT_IN)
+    Test_mutex,
+#endif
+#if STREAM_FD && ISTREAM && OSTREAM
+    Test_fd,
+#endif
+#if STREAM_FD && STREAM_FD_SPLICE && OSTREAM
+    Test_splice,
+#endif
+#if STREAM_URING && ISTREAM && OSTREAM
+    Test_uring,
+#endif
+#if STREAM_LOOP
+    Test_loop,
+#endif
 };
 static const uint32_t TESTES_LEN = sizeof(TESTS) / sizeof(TESTS[0]);
 
@@ -271,7 +451,7 @@ uint32_t Test_readWrite(void) {
         0x1C, 0x2C, 0x3C, 0x4C,
     };
     uint8_t tempBuff[20];
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamBuffer stream;
 
     Stream_init(&stream, streamBuff, sizeof(streamBuff));
@@ -431,7 +611,7 @@ uint32_t Test_IO_readWrite(void) {
         0x1C, 0x2C, 0x3C, 0x4C,
     };
     uint8_t tempBuff[20];
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamOut stream;
 
     OStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
@@ -566,8 +746,8 @@ uint32_t Test_readStream(void) {
     };
 
     uint8_t tempBuff[40];
-    uint8_t inBuff[40];
-    uint8_t outBuff[40];
+    uint8_t inBuff[TEST_SIZE(40)];
+    uint8_t outBuff[TEST_SIZE(40)];
     StreamBuffer in;
     StreamBuffer out;
     int cycles;
@@ -607,8 +787,8 @@ uint32_t Test_IO_readStream(void) {
     };
 
     uint8_t tempBuff[40];
-    uint8_t inBuff[40];
-    uint8_t outBuff[40];
+    uint8_t inBuff[TEST_SIZE(40)];
+    uint8_t outBuff[TEST_SIZE(40)];
     StreamIn in;
     StreamOut out;
     int cycles;
@@ -655,10 +835,41 @@ uint32_t Test_readWriteArray(void) {
                                                 } \
                                             } \
                                         }
+    // compare array functions with single value functions, items straddle end of buffer
+    #define testCross(TYPE, VAL_TY, L)  { \
+                                            VAL_TY val[L] = {0}; \
+                                            VAL_TY tmp[L] = {0}; \
+                                            PRINTF("Array/Value " #TYPE ", %ux\n", L);\
+                                            for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                for (assertIndex = 0; assertIndex < L; assertIndex++) {\
+                                                    val[assertIndex] = (VAL_TY) ((cycles * L + assertIndex) * 0x01030507UL);\
+                                                    tmp[assertIndex] = ~val[assertIndex];\
+                                                } \
+                                                Stream_write ##TYPE ##Array (&stream, val, L); \
+                                                for (assertIndex = 0; assertIndex < L; assertIndex++) { \
+                                                    assert(TYPE, Stream_get ##TYPE ##At (&stream, assertIndex * sizeof(VAL_TY)), val[assertIndex]); \
+                                                } \
+                                                Stream_set ##TYPE ##ArrayAt (&stream, 0, tmp, L); \
+                                                for (assertIndex = 0; assertIndex < L; assertIndex++) { \
+                                                    assert(TYPE, Stream_read ##TYPE (&stream), (VAL_TY) ~val[assertIndex]); \
+                                                } \
+                                                for (assertIndex = 0; assertIndex < L; assertIndex++) { \
+                                                    Stream_write ##TYPE (&stream, val[assertIndex]); \
+                                                } \
+                                                Stream_get ##TYPE ##ArrayAt (&stream, 0, tmp, L); \
+                                                for (assertIndex = 0; assertIndex < L; assertIndex++) { \
+                                                    assert(TYPE, tmp[assertIndex], val[assertIndex]); \
+                                                } \
+                                                Stream_read ##TYPE ##Array (&stream, tmp, L); \
+                                                for (assertIndex = 0; assertIndex < L; assertIndex++) { \
+                                                    assert(TYPE, tmp[assertIndex], val[assertIndex]); \
+                                                } \
+                                            } \
+                                        }
 
     printHeader("Read/Write Array", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamBuffer stream;
 
     Stream_init(&stream, streamBuff, sizeof(streamBuff));
@@ -731,12 +942,26 @@ uint32_t Test_readWriteArray(void) {
     test(Double, double, 4);
 #endif
 
+#if STREAM_GET_AT_ARRAY && STREAM_SET_AT_ARRAY && STREAM_GET_AT_VALUE
+#if STREAM_UINT16
+    testCross(UInt16, uint16_t, 7);
+#endif
+#if STREAM_UINT32
+    testCross(UInt32, uint32_t, 3);
+    testCross(UInt32, uint32_t, 7);
+#endif
+#if STREAM_UINT64
+    testCross(UInt64, uint64_t, 4);
+#endif
+#endif
+
 #if STREAM_BYTE_ORDER
     }
 #endif // STREAM_BYTE_ORDER
 
     return 0;
 #undef test
+#undef testCross
 }
 /********************************************************/
 #if OSTREAM && ISTREAM
@@ -759,7 +984,7 @@ uint32_t Test_IO_readWriteArray(void) {
 
     printHeader("IO Read/Write Array", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamOut stream;
 
     OStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
@@ -859,7 +1084,7 @@ uint32_t Test_get(void) {
 
     printHeader("Get", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamBuffer stream;
 
     Stream_init(&stream, streamBuff, sizeof(streamBuff));
@@ -956,7 +1181,7 @@ uint32_t Test_IO_get(void) {
 
     printHeader("IO Get", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamIn stream;
 
     IStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
@@ -1055,7 +1280,7 @@ uint32_t Test_set(void) {
 
     printHeader("Set", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamBuffer stream;
 
     Stream_init(&stream, streamBuff, sizeof(streamBuff));
@@ -1152,7 +1377,7 @@ uint32_t Test_IO_set(void) {
 
     printHeader("IO Set", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamOut stream;
 
     OStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
@@ -1251,7 +1476,7 @@ uint32_t Test_find(void) {
 
     printHeader("Find", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamBuffer stream;
 
     Stream_init(&stream, streamBuff, sizeof(streamBuff));
@@ -1328,6 +1553,16 @@ uint32_t Test_find(void) {
     }
 #endif // STREAM_BYTE_ORDER
 
+    PRINTF("Find Not Found\n");
+    Stream_resetIO(&stream);
+    Stream_writeBytes(&stream, (uint8_t*) "ABCD", 4);
+    assert(UInt32, Stream_findByte(&stream, 'X'), (uint32_t) STREAM_NOT_FOUND);
+    assert(UInt32, Stream_findByteAt(&stream, 5, 'A'), (uint32_t) STREAM_NOT_FOUND);
+    assert(UInt32, Stream_findPattern(&stream, (uint8_t*) "CDE", 3), (uint32_t) STREAM_NOT_FOUND);
+    assert(UInt32, Stream_findPattern(&stream, (uint8_t*) "BC", 2), 1);
+    assert(Int8, Stream_compareAt(&stream, 6, (uint8_t*) "A", 1), -2);
+    Stream_resetIO(&stream);
+
     return 0;
 #undef test
 }
@@ -1349,7 +1584,7 @@ uint32_t Test_IO_find(void) {
 
     printHeader("IO Find", '#');
 
-    uint8_t streamBuff[37];
+    uint8_t streamBuff[TEST_SIZE(37)];
     StreamIn stream;
 
     IStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
@@ -1432,7 +1667,7 @@ uint32_t Test_IO_find(void) {
 #endif
 #endif
 /********************************************************/
-#if STREAM_WRITE_FLIP && STREAM_READ_FLIP
+#if STREAM_WRITE_FLIP && STREAM_READ_FLIP && !STREAM_SPSC
 uint32_t Test_flip(void) {
     #define testFlipWrite(N, W, R, O)           Stream_init(&stream, streamBuff, sizeof(streamBuff));\
                                                 __setMutexDriver(&stream); \
@@ -1452,7 +1687,7 @@ uint32_t Test_flip(void) {
 
     printHeader("Flip", '#');
 
-    uint8_t streamBuff[36];
+    uint8_t streamBuff[TEST_SIZE(36)];
     StreamBuffer stream;
 
     testFlipWrite(0, 0, 0, 0);
@@ -1485,11 +1720,11 @@ uint32_t Test_lock(void) {
     #define testLock(PAT, N)                    PRINTF("Lock R/W " #PAT " , %ux\n", N);\
                                                 for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
                                                     for (assertIndex = 0; assertIndex < N; assertIndex++) {\
-                                                        assert(UInt32, Stream_space(&stream), stream.Size - assertIndex * sizeof(PAT));\
+                                                        assert(UInt32, Stream_space(&stream), stream.Size - TEST_SPARE - assertIndex * sizeof(PAT));\
                                                         Stream_lockWrite(&stream, &lock, sizeof(PAT));\
                                                         assert(UInt32, Stream_space(&lock), sizeof(PAT));\
                                                         Stream_unlockWrite(&stream, &lock);\
-                                                        assert(UInt32, Stream_space(&stream), stream.Size - assertIndex * sizeof(PAT));\
+                                                        assert(UInt32, Stream_space(&stream), stream.Size - TEST_SPARE - assertIndex * sizeof(PAT));\
                                                         Stream_lockWrite(&stream, &lock, sizeof(PAT));\
                                                         assert(UInt32, Stream_space(&lock), sizeof(PAT));\
                                                         Stream_writeBytes(&lock, (uint8_t*) PAT, sizeof(PAT));\
@@ -1520,7 +1755,7 @@ uint32_t Test_lock(void) {
     const uint8_t PAT5[36] = {0};
 
     uint8_t tempBuff[36];
-    uint8_t streamBuff[36];
+    uint8_t streamBuff[TEST_SIZE(36 + TEST_SPARE)];
     StreamBuffer stream;
     StreamBuffer lock;
 
@@ -1558,41 +1793,81 @@ uint32_t Test_lock(void) {
 #endif
 #if STREAM_TRANSPOSE
 Stream_Result Test_Transpose_UInt8(void* arg, uint8_t* buf, Stream_LenType len) {
+#if STREAM_SIZE_POW2
+    // chunk length can be any size and not open as stream, so values copied in system byte order like a new stream
+    uint8_t val;
+    for (uint32_t i = 0; i < len / sizeof(val); i++) {
+        val = (uint8_t) i;
+        memcpy(&buf[i * sizeof(val)], &val, sizeof(val));
+    }
+#else
     StreamBuffer steram;
-    Stream_init(&steram, buf, len);
+    // spare byte after buf never written
+    Stream_init(&steram, buf, len + TEST_SPARE);
     for (uint32_t i = 0; i < len; i++) {
         Stream_writeUInt8(&steram, i);
     }
+#endif // STREAM_SIZE_POW2
 
     return Stream_Ok;
 }
 
 Stream_Result Test_Transpose_UInt16(void* arg, uint8_t* buf, Stream_LenType len) {
+#if STREAM_SIZE_POW2
+    // chunk length can be any size and not open as stream, so values copied in system byte order like a new stream
+    uint16_t val;
+    for (uint32_t i = 0; i < len / sizeof(val); i++) {
+        val = (uint16_t) i;
+        memcpy(&buf[i * sizeof(val)], &val, sizeof(val));
+    }
+#else
     StreamBuffer steram;
-    Stream_init(&steram, buf, len);
+    // spare byte after buf never written
+    Stream_init(&steram, buf, len + TEST_SPARE);
     for (uint32_t i = 0; i < len; i++) {
         Stream_writeUInt16(&steram, i);
     }
+#endif // STREAM_SIZE_POW2
 
     return Stream_Ok;
 }
 
 Stream_Result Test_Transpose_UInt32(void* arg, uint8_t* buf, Stream_LenType len) {
+#if STREAM_SIZE_POW2
+    // chunk length can be any size and not open as stream, so values copied in system byte order like a new stream
+    uint32_t val;
+    for (uint32_t i = 0; i < len / sizeof(val); i++) {
+        val = (uint32_t) i;
+        memcpy(&buf[i * sizeof(val)], &val, sizeof(val));
+    }
+#else
     StreamBuffer steram;
-    Stream_init(&steram, buf, len);
+    // spare byte after buf never written
+    Stream_init(&steram, buf, len + TEST_SPARE);
     for (uint32_t i = 0; i < len; i++) {
         Stream_writeUInt32(&steram, i);
     }
+#endif // STREAM_SIZE_POW2
 
     return Stream_Ok;
 }
 
 Stream_Result Test_Transpose_UInt64(void* arg, uint8_t* buf, Stream_LenType len) {
+#if STREAM_SIZE_POW2
+    // chunk length can be any size and not open as stream, so values copied in system byte order like a new stream
+    uint64_t val;
+    for (uint32_t i = 0; i < len / sizeof(val); i++) {
+        val = (uint64_t) i;
+        memcpy(&buf[i * sizeof(val)], &val, sizeof(val));
+    }
+#else
     StreamBuffer steram;
-    Stream_init(&steram, buf, len);
+    // spare byte after buf never written
+    Stream_init(&steram, buf, len + TEST_SPARE);
     for (uint32_t i = 0; i < len; i++) {
         Stream_writeUInt64(&steram, i);
     }
+#endif // STREAM_SIZE_POW2
 
     return Stream_Ok;
 }
@@ -1613,7 +1888,7 @@ uint32_t Test_transpose(void) {
     printHeader("Transpose", '#');
 
     uint8_t tmpBuf[127];
-    uint8_t streamBuff[255];
+    uint8_t streamBuff[TEST_SIZE(255)];
 
     StreamBuffer stream;
     Stream_init(&stream, streamBuff, sizeof(streamBuff));
@@ -1678,7 +1953,7 @@ uint32_t Test_transpose(void) {
 #undef testTranspose
 }
 // ------------------------------------------ Mutex Implementation ------------------------------------------
-#if STREAM_MUTEX
+#if STREAM_MUTEX && STREAM_MUTEX != STREAM_MUTEX_BUILT_IN
 #include <stdlib.h>
 #include <errno.h>
 
@@ -1804,7 +2079,7 @@ uint32_t Test_IO_transpose(void) {
     printHeader("IO Transpose", '#');
 
     uint8_t tmpBuf[127];
-    uint8_t streamBuff[255];
+    uint8_t streamBuff[TEST_SIZE(255)];
 
     StreamOut stream;
     OStream_init(&stream, NULL, streamBuff, sizeof(streamBuff));
@@ -1871,42 +2146,1906 @@ uint32_t Test_IO_transpose(void) {
 #endif
 #endif
 /********************************************************/
-#define ASSERT_NUM(TYPE, DTYPE)     uint32_t Assert_ ##TYPE (DTYPE num1, DTYPE num2, uint16_t line, uint8_t cycle, uint8_t assertIndex) {\
-                                        if (num1 != num2) {\
-                                            PRINTF("Expected: %ld, Found: %ld\n", (long int) num2, (long int) num1);\
-                                                return line << 16 | assertIndex << 8 | cycle;\
-                                        }\
-                                        return 0;\
-                                    }
+#if STREAM_GET_AT && STREAM_SET_AT && STREAM_UINT8 && STREAM_UINT32
+uint32_t Test_pow2(void) {
+    printHeader("Power Of Two", '#');
 
-ASSERT_NUM(Char, char)
-ASSERT_NUM(Int8, int8_t)
-ASSERT_NUM(Int16, int16_t)
-ASSERT_NUM(Int32, int32_t)
-ASSERT_NUM(UInt8, uint8_t)
-ASSERT_NUM(UInt16, uint16_t)
-ASSERT_NUM(UInt32, uint32_t)
-ASSERT_NUM(Float, float)
-#if STREAM_UINT64
-    ASSERT_NUM(Int64, int64_t)
-    ASSERT_NUM(UInt64, uint64_t)
-#endif // STREAM_UINT64
-#if STREAM_DOUBLE
-    ASSERT_NUM(Double, double)
-#endif // STREAM_DOUBLE
+    static STREAM_BUFFER_POW2(streamBuff, 16);
+    uint8_t oddBuff[20];
+    StreamBuffer stream;
 
-uint32_t Assert_Bytes(uint8_t* a, uint8_t* b, uint32_t len, uint16_t line, uint8_t cycle, uint8_t assertIndex) {
-    if (memcmp(a, b, len) != 0) {
-        return line << 16 | assertIndex << 8 | cycle;
+    PRINTF("Init Size\n");
+    Stream_init(&stream, oddBuff, sizeof(oddBuff));
+#if STREAM_SIZE_POW2
+    // odd size rejected, nothing can write
+    assert(UInt32, Stream_getBufferSize(&stream), 0);
+    assert(UInt8, Stream_writeUInt8(&stream, 1), Stream_NoSpace);
+    assert(UInt32, Stream_available(&stream), 0);
+    assert(UInt8, Stream_initPow2(&stream, oddBuff, sizeof(oddBuff)), Stream_BadArgument);
+    assert(UInt32, Stream_getBufferSize(&stream), 0);
+    assert(UInt8, Stream_initPow2(&stream, oddBuff, 16), Stream_Ok);
+    assert(UInt32, Stream_getBufferSize(&stream), 16);
+#else
+    assert(UInt32, Stream_getBufferSize(&stream), sizeof(oddBuff));
+#endif // STREAM_SIZE_POW2
+
+    // each step use 5 bytes, so values straddle end of buffer in different offsets
+    PRINTF("Wrap Get/Set UInt32, 16x\n");
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+
+    __setMutexDriver(&stream);
+
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        for (assertIndex = 0; assertIndex < 16; assertIndex++) {
+            Stream_writeUInt8(&stream, assertIndex);
+            Stream_writeUInt32(&stream, 0);
+            Stream_setUInt32At(&stream, 1, cycles * 16 + assertIndex);
+            assert(UInt32, Stream_getUInt32At(&stream, 1), cycles * 16 + assertIndex);
+            assert(UInt8, *Stream_getReadPtrAt(&stream, 0), assertIndex);
+            Stream_moveReadPos(&stream, 1);
+            assert(UInt32, Stream_readUInt32(&stream), cycles * 16 + assertIndex);
+            assert(UInt32, Stream_available(&stream), 0);
+        }
     }
+
     return 0;
 }
+#endif
+/********************************************************/
+#if STREAM_MIRRORED
+uint32_t Test_mirrored(void) {
+    #define testMirrored(PAT, N)                PRINTF("Mirrored R/W " #PAT ", %ux\n", N);\
+                                                for (cycles = 0; cycles < CYCLES_NUM; cycles++) {\
+                                                    for (assertIndex = 0; assertIndex < N; assertIndex++) {\
+                                                        Stream_writeBytes(&stream, (uint8_t*) PAT, sizeof(PAT));\
+                                                    }\
+                                                    assert(UInt32, Stream_directAvailable(&stream), Stream_available(&stream));\
+                                                    assert(UInt32, Stream_directSpace(&stream), Stream_space(&stream));\
+                                                    assert(UInt32, Stream_findPatternAt(&stream, 1, (uint8_t*) PAT, sizeof(PAT)), sizeof(PAT));\
+                                                    assert(Int8, Stream_compareAt(&stream, sizeof(PAT) * (N - 1), (uint8_t*) PAT, sizeof(PAT)), 0);\
+                                                    for (assertIndex = 0; assertIndex < N; assertIndex++) {\
+                                                        Stream_getBytesAt(&stream, 0, tempBuff, sizeof(PAT));\
+                                                        assert(Bytes, tempBuff, (uint8_t*) PAT, sizeof(PAT));\
+                                                        Stream_readBytes(&stream, tempBuff, sizeof(PAT));\
+                                                        assert(Bytes, tempBuff, (uint8_t*) PAT, sizeof(PAT));\
+                                                    }\
+                                                    Stream_writePadding(&stream, 0x5A, sizeof(PAT));\
+                                                    Stream_readBytes(&stream, tempBuff, sizeof(PAT));\
+                                                    assert(Bytes, tempBuff, padding, sizeof(PAT));\
+                                                }
 
-void Assert_dump(StreamBuffer* stream) {
-    uint8_t* ptr = stream->Data;
-    Stream_LenType len = stream->Size;
-    PRINTF("----------------------- Stream Dump -----------------------\n");
-    PRINTF("RPos: %u, WPos: %u, Size: %u, Available: %u, Space: %u, Overflow: %u\n", stream->RPos, stream->WPos, stream->Size, Stream_available(stream), Stream_space(stream), stream->Overflow);
+    printHeader("Mirrored", '#');
+
+    uint8_t PAT1[1000];
+    uint8_t PAT2[333];
+    uint8_t tempBuff[1000];
+    uint8_t padding[1000];
+    StreamBuffer stream;
+
+    for (assertIndex = 0; assertIndex < 250; assertIndex++) {
+        PAT1[assertIndex * 4] = assertIndex;
+        PAT1[assertIndex * 4 + 1] = ~assertIndex;
+        PAT1[assertIndex * 4 + 2] = assertIndex ^ 0x55;
+        PAT1[assertIndex * 4 + 3] = 0xAA;
+    }
+    memcpy(PAT2, PAT1 + 17, sizeof(PAT2));
+    memset(padding, 0x5A, sizeof(padding));
+
+    assert(UInt8, Stream_initMirrored(&stream, 3000), Stream_Ok);
+    assert(UInt32, Stream_getBufferSize(&stream) % 1024, 0);
+    assert(UInt8, Stream_isMirrored(&stream), 1);
+
+    __setMutexDriver(&stream);
+
+    PRINTF("Mirrored Pages\n");
+    stream.Data[0] = 0xA5;
+    assert(UInt8, stream.Data[stream.Size], 0xA5);
+
+    testMirrored(PAT1, 3);
+    testMirrored(PAT2, 5);
+    testMirrored(PAT2, 11);
+
+    Stream_deinit(&stream);
+
+    return 0;
+#undef testMirrored
+}
+#endif
+/********************************************************/
+#if STREAM_MEM_IO_BUILT_IN
+uint32_t Test_memReverse(void) {
+    printHeader("Memory Reverse", '#');
+
+    uint8_t src[160];
+    uint8_t dest[160];
+    uint8_t expected[160];
+    StreamBuffer stream;
+    int len;
+    int i;
+
+    Stream_init(&stream, dest, sizeof(dest));
+
+    for (i = 0; i < (int) sizeof(src); i++) {
+        src[i] = (uint8_t) (i * 7 + 1);
+    }
+
+    // cover single value, scalar and vector paths, src with odd offset
+    PRINTF("memrcpy 0..%u\n", (unsigned) sizeof(src) - 1);
+    for (len = 0; len < (int) sizeof(src); len++) {
+        assertIndex = (uint8_t) len;
+        for (i = 0; i < len; i++) {
+            expected[i] = src[1 + len - 1 - i];
+        }
+        memrcpy(dest, &src[1], len);
+        assert(Bytes, dest, expected, len);
+    }
+
+    PRINTF("memreverse 0..%u\n", (unsigned) sizeof(src));
+    for (len = 0; len <= (int) sizeof(src); len++) {
+        assertIndex = (uint8_t) len;
+        for (i = 0; i < len; i++) {
+            expected[i] = src[len - 1 - i];
+        }
+        memcpy(dest, src, len);
+        memreverse(dest, len);
+        assert(Bytes, dest, expected, len);
+    }
+
+    return 0;
+}
+#endif
+/********************************************************/
+#if STREAM_FIND_COMPILED_AT && STREAM_GET_AT && STREAM_READ_UNTIL_AT
+static Stream_LenType Test_findNaive(const uint8_t* data, Stream_LenType len, Stream_LenType offset, const uint8_t* pat, Stream_LenType patLen) {
+    for (; offset + patLen <= len; offset++) {
+        if (memcmp(&data[offset], pat, patLen) == 0) {
+            return offset;
+        }
+    }
+    return STREAM_NOT_FOUND;
+}
+
+uint32_t Test_findCompiled(void) {
+    static const char* PATTERNS[] = {
+        "\r\n", "a", "aab", "aaaa", "abab", "abaab", "baaab", "ab\r\nab", "bbbbbbbba", "\r\n\r\n",
+    };
+    printHeader("Find Compiled", '#');
+
+    uint8_t streamBuff[TEST_SIZE(37)];
+    uint8_t linear[37];
+    uint8_t readBuff[37];
+    StreamBuffer stream;
+    Stream_Pattern pattern;
+    Stream_LenType len;
+    Stream_LenType offset;
+    Stream_LenType index;
+    uint32_t seed = 1;
+    int i;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+
+    __setMutexDriver(&stream);
+
+    assert(UInt8, Stream_compilePattern(&pattern, (const uint8_t*) "", 0), Stream_ZeroLen);
+
+    // small alphabet make many partial matches, move start of data in each cycle to cross end of buffer
+    PRINTF("Find Compiled Patterns, %ux\n", (unsigned) (sizeof(PATTERNS) / sizeof(PATTERNS[0])));
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        Stream_resetIO(&stream);
+        Stream_writePadding(&stream, 0, cycles);
+        Stream_moveReadPos(&stream, cycles);
+        for (i = 0; i < 32; i++) {
+            seed = seed * 1103515245 + 12345;
+            Stream_writeUInt8(&stream, (uint8_t) "ab\r\n"[(seed >> 16) & 3]);
+        }
+        len = Stream_available(&stream);
+        Stream_getBytesAt(&stream, 0, linear, len);
+
+        for (assertIndex = 0; assertIndex < sizeof(PATTERNS) / sizeof(PATTERNS[0]); assertIndex++) {
+            const uint8_t* pat = (const uint8_t*) PATTERNS[assertIndex];
+            Stream_LenType patLen = (Stream_LenType) strlen(PATTERNS[assertIndex]);
+
+            assert(UInt8, Stream_compilePattern(&pattern, pat, patLen), Stream_Ok);
+            for (offset = 0; offset <= len; offset++) {
+                assert(UInt32, (uint32_t) Stream_findCompiledAt(&stream, offset, &pattern),
+                    (uint32_t) Test_findNaive(linear, len, offset, pat, patLen));
+            }
+        }
+    }
+
+    PRINTF("Read Until Compiled\n");
+    Stream_resetIO(&stream);
+    Stream_writePadding(&stream, 0, 30);
+    Stream_moveReadPos(&stream, 30);
+    Stream_writeBytes(&stream, (uint8_t*) "GET /\r\nHost: a\r\n\r\nbody", 22);
+    Stream_compilePattern(&pattern, (const uint8_t*) "\r\n\r\n", 4);
+    index = Stream_findCompiled(&stream, &pattern);
+    assert(UInt32, (uint32_t) index, 14);
+    assert(UInt32, (uint32_t) Stream_readBytesUntilCompiledAt(&stream, 0, &pattern, readBuff, sizeof(readBuff)), 18);
+    assert(Bytes, readBuff, (uint8_t*) "GET /\r\nHost: a\r\n\r\n", 18);
+    assert(UInt32, (uint32_t) Stream_findCompiled(&stream, &pattern), (uint32_t) STREAM_NOT_FOUND);
+    assert(UInt32, (uint32_t) Stream_readBytesUntilCompiledAt(&stream, 0, &pattern, readBuff, sizeof(readBuff)), 0);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 4);
+
+    return 0;
+}
+#endif
+/********************************************************/
+#if STREAM_FIND_ANY_OF_AT && STREAM_GET_AT && STREAM_READ_UNTIL_AT
+uint32_t Test_findAnyOf(void) {
+    static const uint8_t SET_LINE[] = { '\r', '\n', '\0' };
+    static const uint8_t SET_JSON[] = { '{', '}', '[', ']', ':', ',', '"' };
+    // more than 8 different high nibbles
+    static const uint8_t SET_WIDE[] = { 0x0A, 0x1B, 0x2C, 0x3D, 0x4E, 0x5F, 0x60, 0x71, 0x82, 0x93, 0xF4 };
+    static const struct {
+        const uint8_t*  Set;
+        Stream_LenType  Len;
+    } SETS[] = {
+        { SET_LINE, sizeof(SET_LINE) },
+        { SET_JSON, sizeof(SET_JSON) },
+        { SET_WIDE, sizeof(SET_WIDE) },
+        { SET_LINE + 1, 1 },
+    };
+    printHeader("Find Any Of", '#');
+
+    uint8_t streamBuff[TEST_SIZE(101)];
+    uint8_t linear[101];
+    uint8_t readBuff[101];
+    StreamBuffer stream;
+    Stream_LenType len;
+    Stream_LenType offset;
+    Stream_LenType expected;
+    uint32_t seed = 7;
+    int i;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+
+    __setMutexDriver(&stream);
+
+    // few matches in long runs, so vector and scalar paths both used, data cross end of buffer
+    PRINTF("Find Any Of Sets, %ux\n", (unsigned) (sizeof(SETS) / sizeof(SETS[0])));
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        Stream_resetIO(&stream);
+        Stream_writePadding(&stream, 0, cycles * 5);
+        Stream_moveReadPos(&stream, cycles * 5);
+        for (i = 0; i < 96; i++) {
+            seed = seed * 1103515245 + 12345;
+            Stream_writeUInt8(&stream, (seed >> 16) % 23 == 0 ? (uint8_t) (seed >> 8) : 'x');
+        }
+        len = Stream_available(&stream);
+        Stream_getBytesAt(&stream, 0, linear, len);
+
+        for (assertIndex = 0; assertIndex < sizeof(SETS) / sizeof(SETS[0]); assertIndex++) {
+            for (offset = 0; offset <= len; offset++) {
+                for (expected = offset; expected < len && !memchr(SETS[assertIndex].Set, linear[expected], SETS[assertIndex].Len); expected++);
+                assert(UInt32, (uint32_t) Stream_findAnyOfAt(&stream, offset, SETS[assertIndex].Set, SETS[assertIndex].Len),
+                    (uint32_t) (expected < len ? expected : STREAM_NOT_FOUND));
+            }
+        }
+    }
+
+    PRINTF("Read Until Any Of\n");
+    Stream_resetIO(&stream);
+    Stream_writePadding(&stream, 0, 90);
+    Stream_moveReadPos(&stream, 90);
+    Stream_writeBytes(&stream, (uint8_t*) "first line\nsecond\r\n", 19);
+    assert(UInt32, (uint32_t) Stream_readBytesUntilAnyOf(&stream, SET_LINE, sizeof(SET_LINE), readBuff, sizeof(readBuff)), 11);
+    assert(Bytes, readBuff, (uint8_t*) "first line\n", 11);
+    assert(UInt32, (uint32_t) Stream_readBytesUntilAnyOf(&stream, SET_LINE, sizeof(SET_LINE), readBuff, sizeof(readBuff)), 7);
+    assert(Bytes, readBuff, (uint8_t*) "second\r", 7);
+    assert(UInt32, (uint32_t) Stream_findAnyOf(&stream, SET_JSON, sizeof(SET_JSON)), (uint32_t) STREAM_NOT_FOUND);
+    assert(UInt32, (uint32_t) Stream_readBytesUntilAnyOf(&stream, SET_JSON, sizeof(SET_JSON), readBuff, sizeof(readBuff)), 0);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 1);
+
+    return 0;
+}
+#endif
+/********************************************************/
+#if STREAM_FIND_RESUME && STREAM_READ_UNTIL_AT && STREAM_FIND_COMPILED_AT && STREAM_FIND_ANY_OF_AT
+uint32_t Test_findResume(void) {
+    static const uint8_t SET_LINE[] = { '\n', '\0' };
+    static const uint8_t LINE_END[] = { '\r', '\n' };
+    printHeader("Find Resume", '#');
+
+    uint8_t streamBuff[TEST_SIZE(61)];
+    uint8_t line[40];
+    uint8_t readBuff[40];
+    StreamBuffer stream;
+    Stream_SearchState state;
+    Stream_Pattern pattern;
+    Stream_LenType written;
+    Stream_LenType chunk;
+    Stream_LenType result;
+    Stream_LenType endLen;
+    int i;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+
+    __setMutexDriver(&stream);
+
+    Stream_searchReset(&state);
+    Stream_compilePattern(&pattern, LINE_END, sizeof(LINE_END));
+
+    for (i = 0; i < (int) sizeof(line) - 2; i++) {
+        line[i] = (uint8_t) ('a' + i % 26);
+    }
+    line[sizeof(line) - 2] = '\r';
+    line[sizeof(line) - 1] = '\n';
+
+    // line arrive in small chunks, delimiter split between chunks, lines cross end of buffer
+    PRINTF("Read Until Resume, Chunked Lines\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        chunk = 3 + cycles % 5;
+        endLen = cycles % 4 < 2 ? 2 : 1;
+        written = 0;
+        assertIndex = 0;
+        do {
+            chunk = chunk < sizeof(line) - written ? chunk : sizeof(line) - written;
+            Stream_writeBytes(&stream, &line[written], chunk);
+            written += chunk;
+            switch (cycles % 4) {
+                case 0:
+                    result = Stream_readBytesUntilPatternResume(&stream, &state, LINE_END, sizeof(LINE_END), readBuff, sizeof(readBuff));
+                    break;
+                case 1:
+                    result = Stream_readBytesUntilCompiledResume(&stream, &state, &pattern, readBuff, sizeof(readBuff));
+                    break;
+                case 2:
+                    result = Stream_readBytesUntilResume(&stream, &state, '\n', readBuff, sizeof(readBuff));
+                    break;
+                default:
+                    result = Stream_readBytesUntilAnyOfResume(&stream, &state, SET_LINE, sizeof(SET_LINE), readBuff, sizeof(readBuff));
+                    break;
+            }
+            if (written < sizeof(line)) {
+                // only last (endLen - 1) bytes scanned again
+                assert(UInt32, (uint32_t) result, 0);
+                assert(UInt32, (uint32_t) state.Scanned, (uint32_t) (written - (endLen - 1)));
+            }
+            assertIndex++;
+        } while (written < sizeof(line));
+        assert(UInt32, (uint32_t) result, sizeof(line));
+        assert(Bytes, readBuff, line, sizeof(line));
+        assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+    }
+
+    PRINTF("Find Resume After Read\n");
+    Stream_resetIO(&stream);
+    Stream_searchReset(&state);
+    Stream_writeBytes(&stream, (uint8_t*) "abc", 3);
+    assert(UInt32, (uint32_t) Stream_findByteResume(&stream, &state, 'x'), (uint32_t) STREAM_NOT_FOUND);
+    assert(UInt32, (uint32_t) state.Scanned, 3);
+    Stream_moveReadPos(&stream, 2);
+    Stream_writeBytes(&stream, (uint8_t*) "dxf", 3);
+    assert(UInt32, (uint32_t) Stream_findByteResume(&stream, &state, 'x'), 2);
+    assert(UInt32, (uint32_t) Stream_findByteResume(&stream, &state, 'x'), 2);
+    assert(UInt32, (uint32_t) Stream_findPatternResume(&stream, &state, (uint8_t*) "xf", 2), 2);
+    // other delimiter need new state
+    Stream_searchReset(&state);
+    assert(UInt32, (uint32_t) Stream_findAnyOfResume(&stream, &state, (uint8_t*) "fd", 2), 1);
+
+    PRINTF("Find Resume After Full Lap\n");
+    {
+        uint8_t lapBuff[64 + TEST_SPARE];
+        uint8_t lapData[64];
+        StreamBuffer lap;
+
+        Stream_init(&lap, lapBuff, sizeof(lapBuff));
+        __setMutexDriver(&lap);
+        Stream_searchReset(&state);
+        memset(lapData, 'a', sizeof(lapData));
+        Stream_writeBytes(&lap, lapData, 30);
+        assert(UInt32, (uint32_t) Stream_findByteResume(&lap, &state, '\n'), (uint32_t) STREAM_NOT_FOUND);
+        Stream_moveReadPos(&lap, 30);
+        // whole buffer read between searches, RPos is back where last search saw it
+        lapData[40 + TEST_SPARE] = '\n';
+        assert(UInt8, Stream_writeBytes(&lap, lapData, sizeof(lapData)), Stream_Ok);
+        assert(UInt8, Stream_readBytes(&lap, readBuff, 34 + TEST_SPARE), Stream_Ok);
+        assert(UInt32, (uint32_t) Stream_findByte(&lap, '\n'), 6);
+        assert(UInt32, (uint32_t) Stream_findByteResume(&lap, &state, '\n'), 6);
+    }
+
+    return 0;
+}
+#endif
+/********************************************************/
+#if STREAM_IO_VEC
+uint32_t Test_ioVec(void) {
+    printHeader("IoVec", '#');
+
+    uint8_t streamBuff[TEST_SIZE(37)];
+    uint8_t readBuff[37];
+    StreamBuffer stream;
+    Stream_IoVec vec[2];
+    Stream_LenType len;
+    uint8_t count;
+    uint8_t seq;
+    uint8_t shift;
+    uint8_t* p;
+    int i;
+    int j;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+
+    __setMutexDriver(&stream);
+
+    // fill space with write vectors then consume with read vectors, region cross end of buffer
+    PRINTF("Write/Read Vec, 20 bytes\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        seq = cycles;
+        shift = (cycles * 3) % sizeof(streamBuff);
+        Stream_resetIO(&stream);
+        Stream_writePadding(&stream, 0, shift);
+        Stream_moveReadPos(&stream, shift);
+
+        count = Stream_getWriteVec(&stream, 0, 20, vec);
+        assert(UInt8, count, shift + 20 > sizeof(streamBuff) ? 2 : 1);
+        len = 0;
+        for (i = 0; i < count; i++) {
+            p = (uint8_t*) vec[i].iov_base;
+            for (j = 0; j < (int) vec[i].iov_len; j++) {
+                p[j] = seq + (uint8_t) (len + j);
+            }
+            len += (Stream_LenType) vec[i].iov_len;
+        }
+        assert(UInt32, (uint32_t) len, 20);
+        assert(UInt8, Stream_available(&stream), 0);
+        assert(UInt8, Stream_commitWrite(&stream, len), Stream_Ok);
+        assert(UInt8, Stream_available(&stream), 20);
+
+        // skip first 5 bytes, other 15 bytes must be same as getBytesAt
+        count = Stream_getReadVec(&stream, 5, 100, vec);
+        len = 0;
+        for (i = 0; i < count; i++) {
+            memcpy(&readBuff[len], vec[i].iov_base, vec[i].iov_len);
+            len += (Stream_LenType) vec[i].iov_len;
+        }
+        assert(UInt32, (uint32_t) len, 15);
+        for (assertIndex = 0; assertIndex < 15; assertIndex++) {
+            assert(UInt8, readBuff[assertIndex], seq + 5 + assertIndex);
+        }
+        assertIndex = 0;
+        assert(UInt8, Stream_commitRead(&stream, 20), Stream_Ok);
+        assert(UInt8, Stream_getReadVec(&stream, 0, 10, vec), 0);
+    }
+
+    PRINTF("Vec Limits\n");
+    Stream_resetIO(&stream);
+    Stream_writePadding(&stream, 0xAA, 10);
+    assert(UInt8, Stream_getReadVec(&stream, 10, 1, vec), 0);
+    assert(UInt8, Stream_getReadVec(&stream, 4, 3, vec), 1);
+    assert(UInt32, (uint32_t) vec[0].iov_len, 3);
+    assert(UInt8, Stream_getWriteVec(&stream, Stream_space(&stream), 1, vec), 0);
+
+    return 0;
+}
+#endif
+/********************************************************/
+#if STREAM_FD && ISTREAM && OSTREAM
+uint32_t Test_fd(void) {
+    printHeader("Fd", '#');
+
+    // input bigger than output in power of two mode too, full output fit in input
+    uint8_t outBuff[TEST_SIZE(31)];
+    uint8_t inBuff[TEST_SIZE(41)];
+    uint8_t data[30];
+    uint8_t readBuff[30];
+    StreamOut out;
+    StreamIn stream;
+    int fds[2];
+    int i;
+
+    if (pipe(fds) != 0) {
+        PRINTF("pipe failed\n");
+        return 1;
+    }
+
+    assert(UInt8, OStream_initFd(&out, fds[1], outBuff, sizeof(outBuff)), Stream_Ok);
+    assert(UInt8, IStream_initFd(&stream, fds[0], inBuff, sizeof(inBuff)), Stream_Ok);
+    __setMutexDriver(&out.Buffer);
+    __setMutexDriver(&stream.Buffer);
+
+    // nothing to read, stay in receive mode
+    assert(UInt8, IStream_receive(&stream), Stream_Ok);
+    assert(UInt8, IStream_inReceive(&stream), 1);
+
+    // 30 bytes in each cycle, both buffers wrap in different places
+    PRINTF("Pipe Write/Read, 30 bytes\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        for (i = 0; i < (int) sizeof(data); i++) {
+            data[i] = (uint8_t) (cycles * 31 + i);
+        }
+        assert(UInt8, OStream_writeBytes(&out, data, sizeof(data)), Stream_Ok);
+        assert(UInt8, OStream_flush(&out), Stream_Ok);
+        assert(UInt32, (uint32_t) OStream_pendingBytes(&out), 0);
+
+        assert(UInt8, IStream_handleFd(&stream), Stream_Ok);
+        assert(UInt32, (uint32_t) IStream_available(&stream), sizeof(data));
+        IStream_readBytes(&stream, readBuff, sizeof(readBuff));
+        assert(Bytes, readBuff, data, sizeof(data));
+    }
+
+    PRINTF("Pipe Full Buffer\n");
+    OStream_writePadding(&out, 0x55, sizeof(outBuff) - TEST_SPARE);
+    assert(UInt8, OStream_handleFd(&out), Stream_Ok);
+    assert(UInt8, IStream_handleFd(&stream), Stream_Ok);
+    assert(UInt32, (uint32_t) IStream_available(&stream), sizeof(outBuff) - TEST_SPARE);
+    IStream_ignore(&stream, sizeof(outBuff) - TEST_SPARE);
+
+    PRINTF("Pipe End Of File\n");
+    close(fds[1]);
+    assert(UInt8, IStream_handleFd(&stream), Stream_ReceiveFailed);
+    assert(UInt8, IStream_inReceive(&stream), 0);
+    close(fds[0]);
+
+    return 0;
+}
+#endif
+#if STREAM_URING && ISTREAM && OSTREAM
+uint32_t Test_uring(void) {
+    printHeader("Uring", '#');
+
+    // input bigger than output in power of two mode too, full output fit in input
+    uint8_t outBuff[TEST_SIZE(31)];
+    uint8_t inBuff[TEST_SIZE(41)];
+    uint8_t data[30];
+    uint8_t readBuff[30];
+    StreamUring uring;
+    StreamUring_Io outIo;
+    StreamUring_Io inIo;
+    StreamOut out;
+    StreamIn stream;
+    int fds[2];
+    int i;
+
+    if (StreamUring_init(&uring, 8) != Stream_Ok) {
+        PRINTF("io_uring not supported, skip\n");
+        return 0;
+    }
+    if (pipe(fds) != 0) {
+        PRINTF("pipe failed\n");
+        StreamUring_deinit(&uring);
+        return 1;
+    }
+
+    assert(UInt8, OStream_initUring(&out, &outIo, &uring, fds[1], outBuff, sizeof(outBuff)), Stream_Ok);
+    assert(UInt8, IStream_initUring(&stream, &inIo, &uring, fds[0], inBuff, sizeof(inBuff)), Stream_Ok);
+    __setMutexDriver(&out.Buffer);
+    __setMutexDriver(&stream.Buffer);
+
+    // read request stay in flight on blocking pipe
+    assert(UInt8, IStream_receive(&stream), Stream_Ok);
+    assert(UInt32, (uint32_t) StreamUring_poll(&uring, 0), 0);
+    assert(UInt8, IStream_inReceive(&stream), 1);
+
+    // 30 bytes in each cycle, both buffers wrap in different places
+    PRINTF("Pipe Write/Read, 30 bytes\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        for (i = 0; i < (int) sizeof(data); i++) {
+            data[i] = (uint8_t) (cycles * 29 + i);
+        }
+        assert(UInt8, OStream_writeBytes(&out, data, sizeof(data)), Stream_Ok);
+        assert(UInt8, OStream_flush(&out), Stream_Ok);
+        while (OStream_pendingBytes(&out) != 0 || IStream_available(&stream) < (Stream_LenType) sizeof(data)) {
+            assert(UInt8, StreamUring_poll(&uring, 1) > 0, 1);
+        }
+        assert(UInt32, (uint32_t) IStream_available(&stream), sizeof(data));
+        IStream_readBytes(&stream, readBuff, sizeof(readBuff));
+        assert(Bytes, readBuff, data, sizeof(data));
+    }
+
+    PRINTF("Pipe Full Buffer\n");
+    OStream_writePadding(&out, 0x55, sizeof(outBuff));
+    assert(UInt8, OStream_flush(&out), Stream_Ok);
+    while (OStream_pendingBytes(&out) != 0 || IStream_available(&stream) < (Stream_LenType) sizeof(outBuff)) {
+        assert(UInt8, StreamUring_poll(&uring, 1) > 0, 1);
+    }
+    assert(UInt32, (uint32_t) IStream_available(&stream), sizeof(outBuff));
+    IStream_ignore(&stream, sizeof(outBuff));
+
+    PRINTF("Pipe End Of File\n");
+    close(fds[1]);
+    while (!StreamUring_isClosed(&inIo)) {
+        assert(UInt8, StreamUring_poll(&uring, 1) > 0, 1);
+    }
+    assert(UInt32, (uint32_t) StreamUring_getError(&inIo), 0);
+    assert(UInt8, IStream_inReceive(&stream), 0);
+    close(fds[0]);
+
+    PRINTF("Socketpair Write/Read, 30 bytes\n");
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        PRINTF("socketpair failed\n");
+        StreamUring_deinit(&uring);
+        return 1;
+    }
+    OStream_initUring(&out, &outIo, &uring, fds[0], outBuff, sizeof(outBuff));
+    IStream_initUring(&stream, &inIo, &uring, fds[1], inBuff, sizeof(inBuff));
+    __setMutexDriver(&out.Buffer);
+    __setMutexDriver(&stream.Buffer);
+    assert(UInt8, IStream_receive(&stream), Stream_Ok);
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        for (i = 0; i < (int) sizeof(data); i++) {
+            data[i] = (uint8_t) (cycles * 17 + i);
+        }
+        assert(UInt8, OStream_writeBytes(&out, data, sizeof(data)), Stream_Ok);
+        assert(UInt8, OStream_flush(&out), Stream_Ok);
+        while (OStream_pendingBytes(&out) != 0 || IStream_available(&stream) < (Stream_LenType) sizeof(data)) {
+            assert(UInt8, StreamUring_poll(&uring, 1) > 0, 1);
+        }
+        IStream_readBytes(&stream, readBuff, sizeof(readBuff));
+        assert(Bytes, readBuff, data, sizeof(data));
+    }
+
+    PRINTF("Socketpair Shutdown\n");
+    shutdown(fds[0], SHUT_WR);
+    while (!StreamUring_isClosed(&inIo)) {
+        assert(UInt8, StreamUring_poll(&uring, 1) > 0, 1);
+    }
+    assert(UInt32, (uint32_t) StreamUring_getError(&inIo), 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    StreamUring_deinit(&uring);
+    return 0;
+}
+#endif
+#if STREAM_LOOP
+static uint32_t loopReceived;
+static uint32_t loopClosed;
+
+static void Test_loopOnReceive(StreamIn* stream, Stream_LenType len) {
+    loopReceived += len;
+    IStream_ignore(stream, len);
+}
+static void Test_loopOnClose(StreamLoop_Conn* conn) {
+    loopClosed++;
+}
+static void Test_loopOnCloseFree(StreamLoop_Conn* conn) {
+    loopClosed++;
+    free(conn);
+}
+
+uint32_t Test_loop(void) {
+    printHeader("Loop", '#');
+
+    uint8_t outBuff[256];
+    uint8_t inBuff[64];
+    uint8_t data[200];
+    StreamLoop loop;
+    StreamLoop_Conn client;
+    StreamLoop_Conn server;
+    StreamOut out;
+    StreamIn stream;
+    Stream_LenType len;
+    uint32_t sent = 0;
+    int fds[2];
+    int i;
+
+    assert(UInt8, StreamLoop_init(&loop), Stream_Ok);
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+        PRINTF("socketpair failed\n");
+        StreamLoop_deinit(&loop);
+        return 1;
+    }
+
+    loopReceived = 0;
+    loopClosed = 0;
+    OStream_initFd(&out, fds[0], outBuff, sizeof(outBuff));
+    IStream_initFd(&stream, fds[1], inBuff, sizeof(inBuff));
+    __setMutexDriver(&out.Buffer);
+    __setMutexDriver(&stream.Buffer);
+    IStream_onReceive(&stream, Test_loopOnReceive);
+    assert(UInt8, StreamLoop_add(&loop, &client, NULL, &out), Stream_Ok);
+    assert(UInt8, StreamLoop_add(&loop, &server, &stream, NULL), Stream_Ok);
+    StreamLoop_onClose(&server, Test_loopOnClose);
+    assert(UInt32, StreamLoop_count(&loop), 2);
+
+    PRINTF("Write/Read, 200 bytes\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        for (i = 0; i < (int) sizeof(data); i++) {
+            data[i] = (uint8_t) (cycles + i);
+        }
+        assert(UInt8, OStream_writeBytes(&out, data, sizeof(data)), Stream_Ok);
+        assert(UInt8, StreamLoop_flush(&client), Stream_Ok);
+        assert(UInt8, StreamLoop_waitWrite(&client), 0);
+        sent += sizeof(data);
+        // input buffer smaller than message, onReceive consume each part
+        while (loopReceived < sent) {
+            assert(UInt8, StreamLoop_run(&loop, 1000) > 0, 1);
+        }
+        assert(UInt32, loopReceived, sent);
+    }
+
+    PRINTF("Socket Full, wait for write\n");
+    // fill socket buffer without read
+    do {
+        len = OStream_space(&out);
+        OStream_writePadding(&out, 0xAA, len);
+        sent += len;
+        assert(UInt8, StreamLoop_flush(&client), Stream_Ok);
+    } while (!StreamLoop_waitWrite(&client));
+    // EPOLLOUT disarmed when output flushed
+    while (StreamLoop_waitWrite(&client)) {
+        assert(UInt8, StreamLoop_run(&loop, 1000) > 0, 1);
+    }
+    while (loopReceived < sent) {
+        assert(UInt8, StreamLoop_run(&loop, 1000) > 0, 1);
+    }
+    assert(UInt32, loopReceived, sent);
+    assert(UInt32, (uint32_t) OStream_pendingBytes(&out), 0);
+
+    PRINTF("Close\n");
+    assert(UInt8, StreamLoop_remove(&client), Stream_Ok);
+    close(fds[0]);
+    while (loopClosed == 0) {
+        assert(UInt8, StreamLoop_run(&loop, 1000) > 0, 1);
+    }
+    assert(UInt8, StreamLoop_isClosed(&server), 1);
+    assert(UInt32, StreamLoop_count(&loop), 0);
+    close(fds[1]);
+
+    PRINTF("Free in onClose\n");
+    StreamLoop_Conn* conn = malloc(sizeof(StreamLoop_Conn));
+    assert(UInt8, conn != NULL, 1);
+    assert(UInt8, socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    OStream_initFd(&out, fds[1], outBuff, sizeof(outBuff));
+    IStream_initFd(&stream, fds[1], inBuff, sizeof(inBuff));
+    __setMutexDriver(&out.Buffer);
+    __setMutexDriver(&stream.Buffer);
+    IStream_onReceive(&stream, Test_loopOnReceive);
+    // connection with both streams, loop must not flush it after onClose
+    assert(UInt8, StreamLoop_add(&loop, conn, &stream, &out), Stream_Ok);
+    StreamLoop_onClose(conn, Test_loopOnCloseFree);
+    close(fds[0]);
+    while (loopClosed == 1) {
+        assert(UInt8, StreamLoop_run(&loop, 1000) > 0, 1);
+    }
+    assert(UInt32, StreamLoop_count(&loop), 0);
+    close(fds[1]);
+
+    StreamLoop_deinit(&loop);
+    return 0;
+}
+#endif
+#if STREAM_FD && STREAM_FD_SPLICE && OSTREAM
+uint32_t Test_splice(void) {
+    printHeader("Splice", '#');
+
+    uint8_t outBuff[TEST_SIZE(37)];
+    uint8_t data[30];
+    uint8_t readBuff[30];
+    OStream_Splice splice;
+    StreamOut stream;
+    int fds[2];
+    int i;
+
+    if (pipe(fds) != 0) {
+        PRINTF("pipe failed\n");
+        return 1;
+    }
+
+    assert(UInt8, OStream_initSplice(&stream, &splice, fds[1], outBuff, sizeof(outBuff)), Stream_Ok);
+    __setMutexDriver(&stream.Buffer);
+
+    // bytes released only after reader consume them, buffer wrap in different places
+    PRINTF("Pipe Splice/Read, 30 bytes\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        for (i = 0; i < (int) sizeof(data); i++) {
+            data[i] = (uint8_t) (cycles * 13 + i);
+        }
+        assert(UInt8, OStream_writeBytes(&stream, data, sizeof(data)), Stream_Ok);
+        assert(UInt8, OStream_flush(&stream), Stream_Ok);
+        assert(UInt32, (uint32_t) splice.InPipe, sizeof(data));
+        assert(UInt32, (uint32_t) OStream_pendingBytes(&stream), sizeof(data));
+
+        assert(UInt32, (uint32_t) read(fds[0], readBuff, 10), 10);
+        assert(UInt8, OStream_handleSplice(&stream), Stream_Ok);
+        assert(UInt32, (uint32_t) OStream_pendingBytes(&stream), sizeof(data) - 10);
+
+        assert(UInt32, (uint32_t) read(fds[0], readBuff + 10, sizeof(readBuff) - 10), sizeof(readBuff) - 10);
+        assert(UInt8, OStream_handleSplice(&stream), Stream_Ok);
+        assert(UInt32, (uint32_t) OStream_pendingBytes(&stream), 0);
+        assert(UInt32, (uint32_t) splice.InPipe, 0);
+        assert(Bytes, readBuff, data, sizeof(data));
+    }
+
+    PRINTF("Pipe Write While In Pipe\n");
+    assert(UInt8, OStream_writeBytes(&stream, data, 20), Stream_Ok);
+    assert(UInt8, OStream_flush(&stream), Stream_Ok);
+    assert(UInt8, OStream_writeBytes(&stream, data + 20, 10), Stream_Ok);
+    assert(UInt32, (uint32_t) splice.InPipe, 20);
+    assert(UInt8, OStream_handleSplice(&stream), Stream_Ok);
+    assert(UInt32, (uint32_t) splice.InPipe, 30);
+    assert(UInt32, (uint32_t) read(fds[0], readBuff, sizeof(readBuff)), sizeof(readBuff));
+    assert(UInt8, OStream_handleSplice(&stream), Stream_Ok);
+    assert(UInt32, (uint32_t) OStream_pendingBytes(&stream), 0);
+    assert(Bytes, readBuff, data, sizeof(data));
+
+    PRINTF("Pipe Closed\n");
+    signal(SIGPIPE, SIG_IGN);
+    close(fds[0]);
+    assert(UInt8, OStream_writeBytes(&stream, data, 10), Stream_Ok);
+    assert(UInt8, OStream_flush(&stream), Stream_TransmitFailed);
+    signal(SIGPIPE, SIG_DFL);
+    close(fds[1]);
+
+    return 0;
+}
+#endif
+#if STREAM_TRANSFER
+uint32_t Test_transfer(void) {
+// for compatibility with print dump
+#define stream      out
+#define inCap       (sizeof(inBuff) - TEST_SPARE)
+#define outCap      (sizeof(outBuff) - TEST_SPARE)
+
+    printHeader("Transfer", '#');
+
+    uint8_t inBuff[TEST_SIZE(41)];
+    uint8_t outBuff[TEST_SIZE(37)];
+    uint8_t data[30];
+    uint8_t readBuff[30];
+    StreamBuffer in;
+    StreamBuffer out;
+    Stream_LenType len;
+    int i;
+
+    Stream_init(&in, inBuff, sizeof(inBuff));
+    Stream_init(&out, outBuff, sizeof(outBuff));
+    __setMutexDriver(&in);
+    __setMutexDriver(&out);
+
+    // different lengths, wrap points of both streams move in each cycle
+    PRINTF("Transfer In -> Out\n");
+    for (cycles = 0; cycles < CYCLES_NUM * 3; cycles++) {
+        len = (Stream_LenType) (cycles % sizeof(data)) + 1;
+        for (i = 0; i < len; i++) {
+            data[i] = (uint8_t) (cycles * 7 + i);
+        }
+        assert(UInt8, Stream_writeBytes(&in, data, len), Stream_Ok);
+        assert(UInt8, Stream_transfer(&out, &in, len), Stream_Ok);
+        assert(UInt32, (uint32_t) Stream_available(&in), 0);
+        assert(UInt32, (uint32_t) Stream_available(&out), len);
+        assert(UInt8, Stream_readBytes(&out, readBuff, len), Stream_Ok);
+        assert(Bytes, readBuff, data, len);
+    }
+
+    PRINTF("Transfer Full\n");
+    Stream_writePadding(&in, 0x11, inCap);
+    assert(UInt8, Stream_transfer(&out, &in, outCap + 1), Stream_NoSpace);
+    assert(UInt8, Stream_transfer(&out, &in, outCap), Stream_Ok);
+    assert(UInt8, Stream_isFull(&out), 1);
+    assert(UInt32, (uint32_t) Stream_available(&in), inCap - outCap);
+    assert(UInt8, Stream_transfer(&in, &out, outCap), Stream_Ok);
+    assert(UInt8, Stream_isFull(&in), 1);
+    assert(UInt8, Stream_isEmpty(&out), 1);
+    assert(UInt8, Stream_transfer(&in, &out, 1), Stream_NoSpace);
+    assert(UInt8, Stream_transfer(&out, &in, outCap + 1), Stream_NoSpace);
+    Stream_moveReadPos(&in, inCap);
+    assert(UInt8, Stream_transfer(&out, &in, 1), Stream_NoAvailable);
+
+    PRINTF("Transfer Same Stream\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        for (i = 0; i < (int) sizeof(data); i++) {
+            data[i] = (uint8_t) (cycles + i);
+        }
+        assert(UInt8, Stream_writeBytes(&in, data, 10), Stream_Ok);
+        assert(UInt8, Stream_transfer(&in, &in, 10), Stream_Ok);
+        assert(UInt32, (uint32_t) Stream_available(&in), 10);
+        assert(UInt8, Stream_readBytes(&in, readBuff, 10), Stream_Ok);
+        assert(Bytes, readBuff, data, 10);
+    }
+
+    return 0;
+#undef outCap
+#undef inCap
+#undef stream
+}
+#endif
+#if STREAM_TRANSACTION && STREAM_WRITE_VALUE && STREAM_READ_VALUE
+#if STREAM_MUTEX_POSIX
+static volatile uint8_t txOtherDone;
+static Stream_Result txOtherEnd;
+static Stream_Result txOtherResult;
+
+static void* Test_transactionOther(void* arg) {
+    StreamBuffer* stream = (StreamBuffer*) arg;
+    // not owner of transaction, can't end it and wait for lock to write
+    txOtherEnd = Stream_endWrite(stream);
+    txOtherResult = Stream_writeUInt8(stream, 0xBB);
+    txOtherDone = 1;
+    return NULL;
+}
+#endif
+
+uint32_t Test_transaction(void) {
+    printHeader("Transaction", '#');
+
+    uint8_t streamBuff[TEST_SIZE(37)];
+    StreamBuffer stream;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("Write/Read Message, 15 bytes\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        assert(UInt8, Stream_beginWrite(&stream, 15), Stream_Ok);
+        assert(UInt8, Stream_inWriteTransaction(&stream), 1);
+        assert(UInt8, Stream_writeUInt8(&stream, (uint8_t) cycles), Stream_Ok);
+        assert(UInt8, Stream_writeUInt16(&stream, (uint16_t) (cycles * 300)), Stream_Ok);
+        assert(UInt8, Stream_writeUInt32(&stream, (uint32_t) cycles * 70000), Stream_Ok);
+        // nested transaction
+        assert(UInt8, Stream_beginWrite(&stream, 8), Stream_Ok);
+        assert(UInt8, Stream_writeFloat(&stream, cycles * 0.5f), Stream_Ok);
+        assert(UInt8, Stream_writeInt32(&stream, -cycles), Stream_Ok);
+        assert(UInt8, Stream_endWrite(&stream), Stream_Ok);
+        assert(UInt8, Stream_endWrite(&stream), Stream_Ok);
+        assert(UInt8, Stream_inWriteTransaction(&stream), 0);
+        assert(UInt32, (uint32_t) Stream_available(&stream), 15);
+
+        assert(UInt8, Stream_beginRead(&stream, 15), Stream_Ok);
+        assert(UInt8, Stream_inReadTransaction(&stream), 1);
+        assert(UInt8, Stream_readUInt8(&stream), (uint8_t) cycles);
+        assert(UInt16, Stream_readUInt16(&stream), (uint16_t) (cycles * 300));
+        assert(UInt32, Stream_readUInt32(&stream), (uint32_t) cycles * 70000);
+        assert(Float, Stream_readFloat(&stream), cycles * 0.5f);
+        assert(Int32, Stream_readInt32(&stream), -cycles);
+        assert(UInt8, Stream_endRead(&stream), Stream_Ok);
+        assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+    }
+
+    PRINTF("Space and Available Check\n");
+    assert(UInt8, Stream_endWrite(&stream), Stream_NoTransaction);
+    assert(UInt8, Stream_endRead(&stream), Stream_NoTransaction);
+    assert(UInt8, Stream_beginWrite(&stream, sizeof(streamBuff) + 1), Stream_NoSpace);
+    assert(UInt8, Stream_inWriteTransaction(&stream), 0);
+    assert(UInt8, Stream_beginRead(&stream, 1), Stream_NoAvailable);
+    assert(UInt8, Stream_inReadTransaction(&stream), 0);
+    assert(UInt8, Stream_beginWrite(&stream, 4), Stream_Ok);
+    assert(UInt8, Stream_writePadding(&stream, 0x55, sizeof(streamBuff) - TEST_SPARE - 4), Stream_Ok);
+    assert(UInt8, Stream_writeUInt32(&stream, 0x12345678), Stream_Ok);
+    assert(UInt8, Stream_writeUInt8(&stream, 1), Stream_NoSpace);
+    assert(UInt8, Stream_endWrite(&stream), Stream_Ok);
+    assert(UInt8, Stream_isFull(&stream), 1);
+    Stream_clear(&stream);
+
+#if STREAM_MUTEX_POSIX
+    PRINTF("Other Thread Wait For Transaction\n");
+    pthread_t thread;
+    uint8_t readBuff[5];
+    txOtherDone = 0;
+    assert(UInt8, Stream_beginWrite(&stream, 4), Stream_Ok);
+    assert(UInt8, Stream_writeUInt16(&stream, 0xAAAA), Stream_Ok);
+    assert(UInt8, pthread_create(&thread, NULL, Test_transactionOther, &stream), 0);
+    nanosleep(&(struct timespec) { 0, 20000000 }, NULL);
+    // other thread blocked by lock, nothing written in middle of transaction
+    assert(UInt8, txOtherDone, 0);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 2);
+    assert(UInt8, Stream_writeUInt16(&stream, 0xAAAA), Stream_Ok);
+    assert(UInt8, Stream_endWrite(&stream), Stream_Ok);
+    assert(UInt8, pthread_join(thread, NULL), 0);
+    assert(UInt8, txOtherEnd, Stream_NoTransaction);
+    assert(UInt8, txOtherResult, Stream_Ok);
+    assert(UInt8, Stream_readBytes(&stream, readBuff, sizeof(readBuff)), Stream_Ok);
+    assert(Bytes, readBuff, (uint8_t*) "\xAA\xAA\xAA\xAA\xBB", sizeof(readBuff));
+#endif
+
+    return 0;
+}
+#endif
+#if STREAM_MUTEX_POSIX && (STREAM_MUTEX == STREAM_MUTEX_DRIVER || STREAM_MUTEX == STREAM_MUTEX_BUILT_IN)
+uint32_t Test_mutex(void) {
+    printHeader("Mutex", '#');
+
+#if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+    static const Stream_MutexDriver* DRIVERS[] = {
+        &STREAM_MUTEX_PTHREAD_DRIVER,
+        &STREAM_MUTEX_SPIN_DRIVER,
+        &STREAM_MUTEX_ATOMIC_DRIVER,
+    };
+#else
+    static const void* DRIVERS[] = { NULL };
+#endif
+    uint8_t streamBuff[16];
+    uint8_t data[4] = { 1, 2, 3, 4 };
+    uint8_t out[4];
+    StreamBuffer stream;
+    unsigned i;
+
+    for (i = 0; i < sizeof(DRIVERS) / sizeof(DRIVERS[0]); i++) {
+        PRINTF("Lock %u, nested lock and write/read\n", i);
+        Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    #if STREAM_MUTEX == STREAM_MUTEX_DRIVER
+        Stream_setMutex(&stream, DRIVERS[i]);
+        assert(UInt32, (uint32_t) Stream_mutexInit(&stream), 0);
+    #endif
+        for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+            // stream functions lock again while user hold lock
+            assert(UInt32, (uint32_t) Stream_mutexLock(&stream), 0);
+            assert(UInt32, (uint32_t) Stream_mutexLock(&stream), 0);
+            assert(UInt8, Stream_writeBytes(&stream, data, sizeof(data)), Stream_Ok);
+            assert(UInt32, (uint32_t) Stream_mutexUnlock(&stream), 0);
+            assert(UInt32, (uint32_t) Stream_available(&stream), sizeof(data));
+            assert(UInt32, (uint32_t) Stream_mutexUnlock(&stream), 0);
+            assert(UInt8, Stream_readBytes(&stream, out, sizeof(out)), Stream_Ok);
+            assert(Bytes, out, data, sizeof(data));
+        }
+        Stream_deinit(&stream);
+    }
+
+    return 0;
+}
+#endif
+#if STREAM_WRITE_RESERVE && STREAM_READ
+uint32_t Test_reserve(void) {
+    printHeader("Reserve", '#');
+
+    uint8_t streamBuff[32];
+    char tmp[16];
+    char out[16];
+    StreamBuffer stream;
+    uint8_t* ptr;
+    Stream_Result res;
+    int len;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("Reserve and Commit\n");
+    assert(UInt8, Stream_reserve(&stream, sizeof(streamBuff) + 1, &ptr), Stream_NoSpace);
+    assert(UInt8, ptr == NULL, 1);
+    assert(UInt8, Stream_reserve(&stream, 10, &ptr), Stream_Ok);
+    assert(UInt8, ptr == streamBuff, 1);
+    assert(UInt32, (uint32_t) Stream_reservedLen(&stream), 10);
+    memcpy(ptr, "0123456789", 10);
+    assert(UInt8, Stream_commit(&stream, 11), Stream_NoSpace);
+    assert(UInt8, Stream_commit(&stream, 10), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 10);
+    // nothing reserved
+    assert(UInt8, Stream_commit(&stream, 1), Stream_NoSpace);
+    assert(UInt8, Stream_commit(&stream, 0), Stream_Ok);
+    assert(UInt8, Stream_readBytes(&stream, (uint8_t*) out, 10), Stream_Ok);
+    assert(Bytes, (uint8_t*) out, (uint8_t*) "0123456789", 10);
+
+#if !STREAM_BIP
+    PRINTF("Wrap around end of buffer\n");
+    assert(UInt8, Stream_writePadding(&stream, 0x55, 16), Stream_Ok);
+    assert(UInt8, Stream_moveReadPos(&stream, 16), Stream_Ok);
+    assert(UInt8, Stream_reserve(&stream, 10, &ptr), Stream_NoContiguous);
+    assert(UInt8, Stream_reserve(&stream, 6, &ptr), Stream_Ok);
+    assert(UInt8, ptr == &streamBuff[26], 1);
+    assert(UInt8, Stream_commit(&stream, 6), Stream_Ok);
+    assert(UInt8, Stream_reserve(&stream, 10, &ptr), Stream_Ok);
+    assert(UInt8, ptr == streamBuff, 1);
+    assert(UInt8, Stream_commit(&stream, 0), Stream_Ok);
+    assert(UInt8, Stream_moveReadPos(&stream, 6), Stream_Ok);
+#endif // !STREAM_BIP
+
+    PRINTF("snprintf in place\n");
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        res = Stream_reserve(&stream, sizeof(tmp), &ptr);
+        if (res == Stream_Ok) {
+            len = snprintf((char*) ptr, sizeof(tmp), "cycle %u", cycles);
+            assert(UInt8, Stream_commit(&stream, (Stream_LenType) len), Stream_Ok);
+        }
+        else {
+            // region wrap, fallback to staging buffer
+            assert(UInt8, res, Stream_NoContiguous);
+            len = snprintf(tmp, sizeof(tmp), "cycle %u", cycles);
+            assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) tmp, (Stream_LenType) len), Stream_Ok);
+        }
+        snprintf(tmp, sizeof(tmp), "cycle %u", cycles);
+        assert(UInt32, (uint32_t) Stream_available(&stream), (uint32_t) len);
+        assert(UInt8, Stream_readBytes(&stream, (uint8_t*) out, (Stream_LenType) len), Stream_Ok);
+        assert(Bytes, (uint8_t*) out, (uint8_t*) tmp, (uint32_t) len);
+    }
+
+    return 0;
+}
+#endif
+#if STREAM_BIP && STREAM_READ && STREAM_FIND
+uint32_t Test_bip(void) {
+    printHeader("Bip-Buffer", '#');
+
+    uint8_t streamBuff[32];
+    uint8_t out[20];
+    StreamBuffer stream;
+    uint8_t* ptr;
+    uint8_t queued;
+    uint8_t next;
+    uint8_t id;
+    uint8_t len;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("Wrap at watermark\n");
+    assert(UInt8, Stream_writePadding(&stream, 'A', 24), Stream_Ok);
+    assert(UInt8, Stream_moveReadPos(&stream, 16), Stream_Ok);
+    // tail has 8 bytes, start of buffer has 16 bytes
+    assert(UInt8, Stream_reserve(&stream, 17, &ptr), Stream_NoContiguous);
+    assert(UInt8, Stream_reserve(&stream, 12, &ptr), Stream_Ok);
+    assert(UInt8, ptr == streamBuff, 1);
+    assert(UInt32, (uint32_t) Stream_watermark(&stream), 24);
+    memset(ptr, 'B', 12);
+    assert(UInt8, Stream_commit(&stream, 12), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 20);
+    assert(UInt32, (uint32_t) Stream_space(&stream), 4);
+    assert(UInt32, (uint32_t) Stream_getBufferSize(&stream), sizeof(streamBuff));
+    // first region end at watermark
+    assert(UInt8, Stream_getReadPtr(&stream) == &streamBuff[16], 1);
+    assert(UInt32, (uint32_t) Stream_directAvailable(&stream), 8);
+    assert(Int32, (int32_t) Stream_findByte(&stream, 'B'), 8);
+    assert(UInt8, Stream_reserve(&stream, 5, &ptr), Stream_NoSpace);
+    assert(UInt8, Stream_reserve(&stream, 4, &ptr), Stream_Ok);
+    assert(UInt8, ptr == &streamBuff[12], 1);
+    assert(UInt8, Stream_commit(&stream, 0), Stream_Ok);
+    // read across watermark restore whole buffer
+    assert(UInt8, Stream_readBytes(&stream, out, 10), Stream_Ok);
+    assert(Bytes, out, (uint8_t*) "AAAAAAAABB", 10);
+    assert(UInt32, (uint32_t) Stream_watermark(&stream), sizeof(streamBuff));
+    assert(UInt32, (uint32_t) Stream_space(&stream), 22);
+    assert(UInt8, Stream_getReadPtr(&stream) == &streamBuff[2], 1);
+    assert(UInt32, (uint32_t) Stream_directAvailable(&stream), 10);
+    assert(UInt8, Stream_readBytes(&stream, out, 10), Stream_Ok);
+    assert(Bytes, out, (uint8_t*) "BBBBBBBBBB", 10);
+
+    PRINTF("Restart empty stream\n");
+    assert(UInt8, Stream_reserve(&stream, 24, &ptr), Stream_Ok);
+    assert(UInt8, ptr == streamBuff, 1);
+    assert(UInt8, Stream_commit(&stream, 24), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_directAvailable(&stream), 24);
+    Stream_clear(&stream);
+
+    PRINTF("Whole records\n");
+    queued = 0;
+    next = 0;
+    for (id = 0; id < 200 || queued != 0;) {
+        len = 4 + id % 12;
+        if (id < 200 && queued < 2 && Stream_reserve(&stream, len, &ptr) == Stream_Ok) {
+            memset(ptr, id, len);
+            ptr[0] = len;
+            assert(UInt8, Stream_commit(&stream, len), Stream_Ok);
+            queued++;
+            id++;
+        }
+        else {
+            // empty stream always restart, so only pending records can block reserve
+            assert(UInt8, queued != 0, 1);
+            ptr = Stream_getReadPtr(&stream);
+            len = ptr[0];
+            assert(UInt8, Stream_directAvailable(&stream) >= len, 1);
+            assert(UInt8, ptr[len - 1], next);
+            assert(UInt8, Stream_moveReadPos(&stream, len), Stream_Ok);
+            queued--;
+            next++;
+        }
+    }
+    assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+
+    return 0;
+}
+#endif
+#if STREAM_FRAME && STREAM_BYTE_ORDER
+uint32_t Test_frame(void) {
+    printHeader("Frame", '#');
+
+    uint8_t streamBuff[32];
+    uint8_t out[16];
+    StreamBuffer stream;
+    Stream_FrameIter iter;
+    Stream_IoVec vec[2];
+    uint8_t id;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("Write and peek\n");
+    assert(UInt8, Stream_setFrameHeader(&stream, 2), Stream_Ok);
+    Stream_setByteOrder(&stream, ByteOrder_BigEndian);
+    assert(UInt8, Stream_peekFrame(&stream, vec), Stream_NoAvailable);
+    assert(UInt8, Stream_writeFrame(&stream, (uint8_t*) "Hello", 5), Stream_Ok);
+    assert(UInt8, Stream_writeFrame(&stream, NULL, 0), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 9);
+    assert(UInt8, Stream_getUInt8At(&stream, 0), 0x00);
+    assert(UInt8, Stream_getUInt8At(&stream, 1), 0x05);
+    assert(UInt8, Stream_peekFrame(&stream, vec), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_frameLen(vec), 5);
+    assert(UInt8, vec[0].iov_base == &streamBuff[2], 1);
+    assert(Bytes, (uint8_t*) vec[0].iov_base, (uint8_t*) "Hello", 5);
+    assert(UInt8, Stream_popFrame(&stream), Stream_Ok);
+    assert(UInt8, Stream_peekFrame(&stream, vec), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_frameLen(vec), 0);
+    assert(UInt8, Stream_popFrame(&stream), Stream_Ok);
+    assert(UInt8, Stream_popFrame(&stream), Stream_NoAvailable);
+    assert(UInt8, Stream_writeFrame(&stream, out, 31), Stream_NoSpace);
+
+    PRINTF("Header width and byte order\n");
+    Stream_setByteOrder(&stream, ByteOrder_LittleEndian);
+    assert(UInt8, Stream_setFrameHeader(&stream, 3), Stream_BadArgument);
+    assert(UInt8, Stream_setFrameHeader(&stream, 1), Stream_Ok);
+    assert(UInt8, Stream_writeFrame(&stream, out, 256), Stream_FrameTooLong);
+    assert(UInt8, Stream_setFrameHeader(&stream, 4), Stream_Ok);
+    assert(UInt8, Stream_writeFrame(&stream, (uint8_t*) "abc", 3), Stream_Ok);
+    assert(UInt32, Stream_getUInt32At(&stream, 0), 3);
+    assert(UInt8, Stream_getUInt8At(&stream, 0), 0x03);
+    assert(UInt8, Stream_popFrame(&stream), Stream_Ok);
+    // length that never fit in buffer
+    assert(UInt8, Stream_writeUInt32(&stream, 0x1000), Stream_Ok);
+    assert(UInt8, Stream_writeFrame(&stream, (uint8_t*) "ok", 2), Stream_Ok);
+    assert(UInt8, Stream_peekFrame(&stream, vec), Stream_FrameTooLong);
+    assert(UInt8, Stream_beginFrames(&stream, &iter), Stream_Ok);
+    assert(UInt8, Stream_nextFrame(&stream, &iter, vec), Stream_FrameTooLong);
+    assert(UInt8, Stream_endFrames(&stream, &iter), Stream_Ok);
+    // pop drop bad header alone, next frame is readable
+    assert(UInt8, Stream_popFrame(&stream), Stream_FrameTooLong);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 6);
+    assert(UInt8, Stream_peekFrame(&stream, vec), Stream_Ok);
+    assert(Bytes, (uint8_t*) vec[0].iov_base, (uint8_t*) "ok", 2);
+    assert(UInt8, Stream_popFrame(&stream), Stream_Ok);
+    Stream_clear(&stream);
+    assert(UInt8, Stream_setFrameHeader(&stream, 2), Stream_Ok);
+
+    PRINTF("Begin and end frame\n");
+    // move positions near end of buffer, so frame wrap
+    assert(UInt8, Stream_writePadding(&stream, 0, 26), Stream_Ok);
+    assert(UInt8, Stream_moveReadPos(&stream, 26), Stream_Ok);
+    assert(UInt8, Stream_writeFrame(&stream, (uint8_t*) "A", 1), Stream_Ok);
+    assert(UInt8, Stream_beginFrame(&stream), Stream_Ok);
+    assert(UInt8, Stream_beginFrame(&stream), Stream_InFrame);
+    assert(UInt8, Stream_writeFrame(&stream, out, 1), Stream_InFrame);
+    assert(UInt8, Stream_writeUInt16(&stream, 0x1234), Stream_Ok);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "xyz", 3), Stream_Ok);
+    // open frame hidden from frame readers
+    assert(UInt8, Stream_popFrame(&stream), Stream_Ok);
+    assert(UInt8, Stream_peekFrame(&stream, vec), Stream_NoAvailable);
+    assert(UInt8, Stream_endFrame(&stream), Stream_Ok);
+    assert(UInt8, Stream_endFrame(&stream), Stream_NoFrame);
+    assert(UInt8, Stream_peekFrame(&stream, vec), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_frameLen(vec), 5);
+    assert(UInt32, (uint32_t) vec[0].iov_len, 1);
+    assert(UInt8, vec[1].iov_base == streamBuff, 1);
+    assert(UInt8, Stream_readUInt16(&stream), 5);
+    assert(UInt16, Stream_readUInt16(&stream), 0x1234);
+    assert(UInt8, Stream_readBytes(&stream, out, 3), Stream_Ok);
+    assert(Bytes, out, (uint8_t*) "xyz", 3);
+
+    PRINTF("Abort frame\n");
+    assert(UInt8, Stream_writeFrame(&stream, (uint8_t*) "B", 1), Stream_Ok);
+    assert(UInt8, Stream_abortFrame(&stream), Stream_NoFrame);
+    assert(UInt8, Stream_beginFrame(&stream), Stream_Ok);
+    assert(UInt8, Stream_writePadding(&stream, 0x55, 20), Stream_Ok);
+    assert(UInt8, Stream_abortFrame(&stream), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 3);
+    assert(UInt8, Stream_popFrame(&stream), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+
+    PRINTF("Batch iterator\n");
+    id = 0;
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        // fill with frames of different length, then walk all of them under one lock
+        while (Stream_writeFrame(&stream, out, (Stream_LenType) (1 + (cycles + id) % 7)) == Stream_Ok) {
+            id++;
+        }
+        assert(UInt8, Stream_beginFrames(&stream, &iter), Stream_Ok);
+        while (Stream_nextFrame(&stream, &iter, vec) == Stream_Ok) {
+            assert(UInt8, Stream_frameLen(vec) >= 1 && Stream_frameLen(vec) <= 7, 1);
+        }
+        assert(UInt32, (uint32_t) iter.Offset, (uint32_t) Stream_available(&stream));
+        assert(UInt8, Stream_endFrames(&stream, &iter), Stream_Ok);
+        assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+    }
+
+    return 0;
+}
+#endif
+#if STREAM_WRITE_VAR_INT && STREAM_READ_VAR_INT && STREAM_GET_AT_VAR_INT && STREAM_FIND_AT_VAR_INT && STREAM_FIND
+uint32_t Test_varInt(void) {
+    printHeader("VarInt", '#');
+
+    uint8_t streamBuff[32];
+    StreamBuffer stream;
+    uint32_t u32;
+    int32_t i32;
+#if STREAM_UINT64
+    uint64_t u64;
+    int64_t i64;
+#endif
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("Encode\n");
+    assert(UInt8, Stream_writeVarUInt32(&stream, 0), Stream_Ok);
+    assert(UInt8, Stream_writeVarUInt32(&stream, 127), Stream_Ok);
+    assert(UInt8, Stream_writeVarUInt32(&stream, 300), Stream_Ok);
+    assert(UInt8, Stream_writeVarInt32(&stream, -1), Stream_Ok);
+    assert(UInt8, Stream_writeVarInt32(&stream, -65), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 7);
+    assert(Bytes, streamBuff, (uint8_t*) "\x00\x7F\xAC\x02\x01\x81\x01", 7);
+    assert(UInt8, Stream_varUIntLen(0xFFFFFFFF), 5);
+    assert(UInt8, Stream_varInt32Len(-64), 1);
+    assert(Int32, (int32_t) Stream_findVarUInt32(&stream, 300), 2);
+    assert(Int32, (int32_t) Stream_findVarInt32(&stream, -65), 5);
+
+    PRINTF("Decode\n");
+    assert(UInt8, Stream_getVarUInt32At(&stream, 2, &u32), Stream_Ok);
+    assert(UInt32, u32, 300);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_Ok);
+    assert(UInt32, u32, 0);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_Ok);
+    assert(UInt32, u32, 127);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_Ok);
+    assert(UInt32, u32, 300);
+    assert(UInt8, Stream_readVarInt32(&stream, &i32), Stream_Ok);
+    assert(Int32, i32, -1);
+    assert(UInt8, Stream_readVarInt32(&stream, &i32), Stream_Ok);
+    assert(Int32, i32, -65);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_NoAvailable);
+
+    PRINTF("Incomplete and too long\n");
+    assert(UInt8, Stream_writeUInt16(&stream, 0x8080), Stream_Ok);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_NoAvailable);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 2);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\x80\x80\x10", 3), Stream_Ok);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_VarIntTooLong);
+    Stream_clear(&stream);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\xFF\xFF\xFF\xFF\x0F", 5), Stream_Ok);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_Ok);
+    assert(UInt32, u32, 0xFFFFFFFF);
+    assert(UInt8, Stream_writeVarInt32(&stream, INT32_MIN), Stream_Ok);
+    assert(UInt8, Stream_readVarInt32(&stream, &i32), Stream_Ok);
+    assert(Int32, i32, INT32_MIN);
+#if STREAM_UINT64
+    assert(UInt8, Stream_writeVarUInt64(&stream, UINT64_MAX), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 10);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_VarIntTooLong);
+    assert(UInt8, Stream_readVarUInt64(&stream, &u64), Stream_Ok);
+    assert(UInt64, u64, UINT64_MAX);
+    assert(UInt8, Stream_writeVarInt64(&stream, INT64_MIN), Stream_Ok);
+    assert(UInt8, Stream_getVarInt64(&stream, &i64), Stream_Ok);
+    assert(Int64, i64, INT64_MIN);
+    assert(UInt8, Stream_readVarInt64(&stream, &i64), Stream_Ok);
+#endif
+
+    PRINTF("Wrap around end of buffer\n");
+    Stream_clear(&stream);
+    assert(UInt8, Stream_writePadding(&stream, 0, 29), Stream_Ok);
+    assert(UInt8, Stream_moveReadPos(&stream, 29), Stream_Ok);
+    assert(UInt8, Stream_writeVarUInt32(&stream, 0xFFFFFFF), Stream_Ok);
+    assert(UInt8, Stream_writeVarInt32(&stream, -300), Stream_Ok);
+    assert(UInt8, Stream_getVarUInt32(&stream, &u32), Stream_Ok);
+    assert(UInt32, u32, 0xFFFFFFF);
+    assert(Int32, (int32_t) Stream_findVarInt32(&stream, -300), 4);
+    assert(UInt8, Stream_getVarInt32At(&stream, 4, &i32), Stream_Ok);
+    assert(Int32, i32, -300);
+    for (cycles = 0; cycles < CYCLES_NUM; cycles++) {
+        assert(UInt8, Stream_writeVarUInt32(&stream, (1UL << (cycles + 7)) + cycles), Stream_Ok);
+        assert(UInt8, Stream_writeVarInt32(&stream, -(int32_t) (cycles * 1000)), Stream_Ok);
+        assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_Ok);
+        assert(UInt8, Stream_readVarInt32(&stream, &i32), Stream_Ok);
+        assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_Ok);
+        assert(UInt32, u32, (1UL << (cycles + 7)) + cycles);
+        assert(UInt8, Stream_readVarInt32(&stream, &i32), Stream_Ok);
+        assert(Int32, i32, -(int32_t) (cycles * 1000));
+        assert(UInt8, Stream_writeVarUInt32(&stream, 0xFFFFFFF), Stream_Ok);
+        assert(UInt8, Stream_writeVarInt32(&stream, -300), Stream_Ok);
+    }
+
+#if STREAM_WRITE_LIMIT && STREAM_READ_LIMIT
+    PRINTF("Limited stream\n");
+    Stream_clear(&stream);
+    // write and read side use up limit the same way
+    Stream_setWriteLimit(&stream, 4);
+    assert(UInt8, Stream_writeVarUInt32(&stream, 300), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_getWriteLimit(&stream), 2);
+    assert(UInt8, Stream_writeVarInt32(&stream, -65), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_getWriteLimit(&stream), 0);
+    Stream_setReadLimit(&stream, 3);
+    assert(UInt8, Stream_readVarUInt32(&stream, &u32), Stream_Ok);
+    assert(UInt32, u32, 300);
+    assert(UInt32, (uint32_t) Stream_getReadLimit(&stream), 1);
+    assert(UInt8, Stream_readVarInt32(&stream, &i32), Stream_NoAvailable);
+    assert(UInt32, (uint32_t) Stream_availableReal(&stream), 2);
+#endif // STREAM_WRITE_LIMIT && STREAM_READ_LIMIT
+
+    return 0;
+}
+#endif
+#if STREAM_WRITE_ARRAY_PACKED && STREAM_READ_ARRAY_PACKED
+uint32_t Test_packed(void) {
+    printHeader("Packed Array", '#');
+
+    static const uint32_t VALUES[] = {
+        0x00, 0xFF, 0x100, 0xFFFF, 0x10000, 0xFFFFFF, 0x1000000, 0xFFFFFFFF,
+        0x12, 0x3456, 0x789ABC, 0xDEF01234, 7, 0x8000, 0x800000, 0x80000000,
+        0x01, 0x0203, 0x040506, 0x0708090A, 0xAB,
+    };
+    const Stream_LenType count = sizeof(VALUES) / sizeof(VALUES[0]);
+    uint8_t streamBuff[64];
+    StreamBuffer stream;
+    uint32_t out[sizeof(VALUES) / sizeof(VALUES[0])];
+    uint32_t wide[12];
+    Stream_LenType offset;
+    Stream_LenType len;
+    Stream_LenType i;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("Format\n");
+    out[0] = 1; out[1] = 0x100; out[2] = 0x10000; out[3] = 0x1000000; out[4] = 2;
+    assert(UInt8, Stream_writeUInt32ArrayPacked(&stream, out, 5), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 13);
+    assert(Bytes, streamBuff, (uint8_t*) "\xE4\x00\x01\x00\x01\x00\x00\x01\x00\x00\x00\x01\x02", 13);
+    assert(UInt8, Stream_readUInt32ArrayPacked(&stream, out, 5), Stream_Ok);
+    assert(UInt32, out[3], 0x1000000);
+    assert(UInt32, out[4], 2);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+
+    PRINTF("No space and no available\n");
+    assert(UInt8, Stream_writePadding(&stream, 0, 20), Stream_Ok);
+    assert(UInt8, Stream_writeUInt32ArrayPacked(&stream, VALUES, count), Stream_NoSpace);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 20);
+    Stream_clear(&stream);
+    assert(UInt8, Stream_writeUInt32ArrayPacked(&stream, VALUES, count), Stream_Ok);
+    assert(UInt8, Stream_readUInt32ArrayPacked(&stream, out, count + 4), Stream_NoAvailable);
+    Stream_clear(&stream);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\xFF\x01\x02\x03", 4), Stream_Ok);
+    assert(UInt8, Stream_readUInt32ArrayPacked(&stream, out, 1), Stream_NoAvailable);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 4);
+
+    PRINTF("Wrap around end of buffer\n");
+    for (offset = 0; offset < (Stream_LenType) sizeof(streamBuff); offset++) {
+        for (len = 1; len <= count; len += 4) {
+            Stream_clear(&stream);
+            if (offset) {
+                assert(UInt8, Stream_writePadding(&stream, 0, offset), Stream_Ok);
+                assert(UInt8, Stream_moveReadPos(&stream, offset), Stream_Ok);
+            }
+            assert(UInt8, Stream_writeUInt32ArrayPacked(&stream, &VALUES[count - len], len), Stream_Ok);
+            assert(UInt8, Stream_readUInt32ArrayPacked(&stream, out, len), Stream_Ok);
+            assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+            for (i = 0; i < len; i++) {
+                assert(UInt32, out[i], VALUES[count - len + i]);
+            }
+        }
+    }
+
+    PRINTF("Group end at end of buffer\n");
+    // 4 byte values, every group is 16 bytes, some offsets end a group exactly at end of buffer
+    for (i = 0; i < 12; i++) {
+        wide[i] = 0x01020304UL * (uint32_t) (i + 1);
+    }
+    for (offset = 0; offset < (Stream_LenType) sizeof(streamBuff); offset++) {
+        Stream_clear(&stream);
+        if (offset) {
+            assert(UInt8, Stream_writePadding(&stream, 0, offset), Stream_Ok);
+            assert(UInt8, Stream_moveReadPos(&stream, offset), Stream_Ok);
+        }
+        assert(UInt8, Stream_writeUInt32ArrayPacked(&stream, wide, 12), Stream_Ok);
+        assert(UInt8, Stream_readUInt32ArrayPacked(&stream, out, 12), Stream_Ok);
+        for (i = 0; i < 12; i++) {
+            assert(UInt32, out[i], wide[i]);
+        }
+    }
+
+#if STREAM_WRITE_LIMIT && STREAM_READ_LIMIT
+    PRINTF("Limited stream\n");
+    Stream_clear(&stream);
+    // 5 values take 13 bytes, limit must be used up like other write and read functions
+    Stream_setWriteLimit(&stream, 15);
+    out[0] = 1; out[1] = 0x100; out[2] = 0x10000; out[3] = 0x1000000; out[4] = 2;
+    assert(UInt8, Stream_writeUInt32ArrayPacked(&stream, out, 5), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_getWriteLimit(&stream), 2);
+    assert(UInt8, Stream_writeUInt32ArrayPacked(&stream, out, 5), Stream_NoSpace);
+    assert(UInt8, Stream_writeUInt16(&stream, 0xABCD), Stream_Ok);
+    assert(UInt8, Stream_writeUInt8(&stream, 0xEF), Stream_NoSpace);
+    Stream_setReadLimit(&stream, 14);
+    assert(UInt8, Stream_readUInt32ArrayPacked(&stream, out, 5), Stream_Ok);
+    assert(UInt32, out[3], 0x1000000);
+    assert(UInt32, (uint32_t) Stream_getReadLimit(&stream), 1);
+    assert(UInt8, Stream_readUInt32ArrayPacked(&stream, out, 1), Stream_NoAvailable);
+    assert(UInt8, Stream_readUInt8(&stream), 0xCD);
+    assert(UInt32, (uint32_t) Stream_getReadLimit(&stream), 0);
+#endif // STREAM_WRITE_LIMIT && STREAM_READ_LIMIT
+
+    return 0;
+}
+#endif
+#if STREAM_CRC
+uint32_t Test_crc(void) {
+    printHeader("Crc", '#');
+
+    static const char CHECK[] = "123456789";
+    static uint8_t data[1000];
+    uint8_t streamBuff[64];
+    StreamBuffer stream;
+    StreamCrc16 model;
+    uint32_t ref;
+    uint32_t crc;
+    uint16_t crc16;
+    int i;
+    int j;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("Check values\n");
+    assert(UInt32, StreamCrc_crc32(0, CHECK, 9), 0xCBF43926);
+    assert(UInt32, StreamCrc_crc32c(0, CHECK, 9), 0xE3069283);
+    StreamCrc_initCrc16(&model, STREAM_CRC16_MODBUS);
+    assert(UInt16, StreamCrc_crc16(&model, StreamCrc_crc16Empty(&model), CHECK, 9), 0x4B37);
+    StreamCrc_initCrc16(&model, STREAM_CRC16_CCITT_FALSE);
+    assert(UInt16, StreamCrc_crc16(&model, StreamCrc_crc16Empty(&model), CHECK, 9), 0x29B1);
+    StreamCrc_initCrc16(&model, STREAM_CRC16_XMODEM);
+    assert(UInt16, StreamCrc_crc16(&model, StreamCrc_crc16Empty(&model), CHECK, 9), 0x31C3);
+    StreamCrc_initCrc16(&model, STREAM_CRC16_KERMIT);
+    assert(UInt16, StreamCrc_crc16(&model, StreamCrc_crc16Empty(&model), CHECK, 9), 0x2189);
+
+    PRINTF("Long data, running and combine\n");
+    for (i = 0; i < (int) sizeof(data); i++) {
+        data[i] = (uint8_t) (i * 131 + (i >> 3));
+    }
+    // bitwise reference
+    ref = 0xFFFFFFFF;
+    for (i = 0; i < (int) sizeof(data); i++) {
+        ref ^= data[i];
+        for (j = 0; j < 8; j++) {
+            ref = (ref & 1) ? (ref >> 1) ^ 0xEDB88320 : ref >> 1;
+        }
+    }
+    ref = ~ref;
+    assert(UInt32, StreamCrc_crc32(0, data, sizeof(data)), ref);
+    for (i = 0; i <= (int) sizeof(data); i += 111) {
+        assert(UInt32, StreamCrc_crc32(StreamCrc_crc32(0, data, i), &data[i], sizeof(data) - i), ref);
+        assert(UInt32, StreamCrc_crc32Combine(StreamCrc_crc32(0, data, i),
+            StreamCrc_crc32(0, &data[i], sizeof(data) - i), sizeof(data) - i), ref);
+        assert(UInt32, StreamCrc_crc32cCombine(StreamCrc_crc32c(0, data, i),
+            StreamCrc_crc32c(0, &data[i], sizeof(data) - i), sizeof(data) - i), StreamCrc_crc32c(0, data, sizeof(data)));
+    }
+
+    PRINTF("Over stream, wrap around end of buffer\n");
+    assert(UInt8, Stream_writePadding(&stream, 0, 60), Stream_Ok);
+    assert(UInt8, Stream_moveReadPos(&stream, 60), Stream_Ok);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) CHECK, 9), Stream_Ok);
+    crc = 0;
+    assert(UInt8, Stream_crc32(&stream, 9, &crc), Stream_Ok);
+    assert(UInt32, crc, 0xCBF43926);
+    crc = 0;
+    assert(UInt8, Stream_crc32c(&stream, 9, &crc), Stream_Ok);
+    assert(UInt32, crc, 0xE3069283);
+    crc16 = StreamCrc_crc16Empty(&model);
+    assert(UInt8, Stream_crc16At(&stream, &model, 0, 3, &crc16), Stream_Ok);
+    assert(UInt8, Stream_crc16At(&stream, &model, 3, 6, &crc16), Stream_Ok);
+    assert(UInt16, crc16, 0x2189);
+    crc = 0;
+    assert(UInt8, Stream_crc32At(&stream, 0, 4, &crc), Stream_Ok);
+    assert(UInt8, Stream_crc32At(&stream, 4, 5, &crc), Stream_Ok);
+    assert(UInt32, crc, 0xCBF43926);
+    assert(UInt8, Stream_crc32At(&stream, 4, 6, &crc), Stream_NoAvailable);
+    assert(UInt8, Stream_crc32At(&stream, 10, 0, &crc), Stream_NoAvailable);
+    assert(UInt32, crc, 0xCBF43926);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 9);
+
+    return 0;
+}
+#endif
+#if STREAM_PIPELINE
+/* each byte to 2 hex chars, second char pending when output has 1 byte */
+static Stream_Result Test_hexFilter(Stream_Filter* filter, Stream_FilterIo* io) {
+    static const char HEX[] = "0123456789ABCDEF";
+    int* pending = (int*) Stream_filterGetArgs(filter);
+    uint8_t val;
+
+    while (io->Produced < io->OutLen) {
+        if (*pending >= 0) {
+            io->Out[io->Produced++] = (uint8_t) *pending;
+            *pending = -1;
+        }
+        else if (io->Consumed < io->InLen) {
+            val = io->In[io->Consumed++];
+            io->Out[io->Produced++] = HEX[val >> 4];
+            *pending = HEX[val & 0x0F];
+        }
+        else {
+            break;
+        }
+    }
+    return Stream_Ok;
+}
+/* copy bytes, append new line on flush */
+static Stream_Result Test_lineFilter(Stream_Filter* filter, Stream_FilterIo* io) {
+    uint8_t* ended = (uint8_t*) Stream_filterGetArgs(filter);
+    Stream_LenType len = io->InLen < io->OutLen ? io->InLen : io->OutLen;
+
+    memcpy(io->Out, io->In, len);
+    io->Consumed = len;
+    io->Produced = len;
+    if (io->Flush && !*ended) {
+        io->Out[io->Produced++] = '\n';
+        *ended = 1;
+    }
+    return Stream_Ok;
+}
+
+uint32_t Test_pipeline(void) {
+    printHeader("Pipeline", '#');
+
+    uint8_t streamBuff[TEST_SIZE(16 + TEST_SPARE)];
+    uint8_t midBuff[TEST_SIZE(8 + TEST_SPARE)];
+    uint8_t outBuff[TEST_SIZE(8 + TEST_SPARE)];
+    StreamBuffer stream;
+    StreamBuffer mid;
+    StreamBuffer out;
+    Stream_Filter filters[2];
+    Stream_Pipeline pipe;
+    uint8_t src[40];
+    char expected[2 * sizeof(src) + 2];
+    char result[2 * sizeof(src) + 2];
+    Stream_LenType written = 0;
+    Stream_LenType received = 0;
+    Stream_LenType len;
+    Stream_Result res;
+    int pending = -1;
+    uint8_t ended = 0;
+    int i;
+
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    Stream_init(&mid, midBuff, sizeof(midBuff));
+    Stream_init(&out, outBuff, sizeof(outBuff));
+    __setMutexDriver(&stream);
+    __setMutexDriver(&mid);
+    __setMutexDriver(&out);
+    Stream_filterInit(&filters[0], Test_hexFilter, &mid, &pending);
+    Stream_filterInit(&filters[1], Test_lineFilter, &out, &ended);
+    Stream_pipelineInit(&pipe, &stream, filters, 2);
+    for (i = 0; i < (int) sizeof(src); i++) {
+        src[i] = (uint8_t) (i * 37 + 11);
+        sprintf(&expected[i * 2], "%02X", src[i]);
+    }
+    expected[2 * sizeof(src)] = '\n';
+
+    PRINTF("Backpressure\n");
+    assert(UInt8, Stream_writeBytes(&stream, src, 16), Stream_Ok);
+    written = 16;
+    assert(UInt8, Stream_pipelineRun(&pipe), Stream_NoSpace);
+    assert(UInt32, (uint32_t) Stream_available(&out), 8);
+    assert(UInt32, (uint32_t) Stream_available(&mid), 8);
+    // 8 + 8 hex chars from 8 bytes, rest stay in input
+    assert(UInt32, (uint32_t) Stream_available(&stream), 8);
+
+    PRINTF("Incremental\n");
+    while (written < (Stream_LenType) sizeof(src)) {
+        len = Stream_space(&stream);
+        if (len > 5) {
+            len = 5;
+        }
+        if (len > (Stream_LenType) sizeof(src) - written) {
+            len = (Stream_LenType) sizeof(src) - written;
+        }
+        if (len > 0) {
+            assert(UInt8, Stream_writeBytes(&stream, &src[written], len), Stream_Ok);
+            written += len;
+        }
+        res = Stream_pipelineRun(&pipe);
+        assert(UInt8, res == Stream_Ok || res == Stream_NoSpace, 1);
+        // consume 3 bytes of output each time, ring of final output wrap
+        len = Stream_available(&out);
+        if (len > 3) {
+            len = 3;
+        }
+        assert(UInt8, Stream_readBytes(&out, (uint8_t*) &result[received], len), Stream_Ok);
+        received += len;
+    }
+
+    PRINTF("Flush\n");
+    do {
+        res = Stream_pipelineFlush(&pipe);
+        len = Stream_available(&out);
+        if (len > 0) {
+            assert(UInt8, Stream_readBytes(&out, (uint8_t*) &result[received], len), Stream_Ok);
+            received += len;
+        }
+    } while (res == Stream_NoSpace);
+    assert(UInt8, res, Stream_Ok);
+    assert(UInt32, (uint32_t) received, 2 * sizeof(src) + 1);
+    assert(Bytes, (uint8_t*) result, (uint8_t*) expected, 2 * sizeof(src) + 1);
+    assert(UInt8, Stream_pipelineFlush(&pipe), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&out), 0);
+
+    return 0;
+}
+#endif
+#if STREAM_COBS && STREAM_SLIP
+uint32_t Test_codec(void) {
+    printHeader("Codec", '#');
+
+    uint8_t streamBuff[64];
+    StreamBuffer stream;
+    uint8_t src[300];
+    uint8_t dst[300];
+    Stream_LenType offset;
+    Stream_LenType len;
+    Stream_LenType n;
+    int i;
+
+    memset(src, 0x55, sizeof(src));
+    Stream_init(&stream, streamBuff, sizeof(streamBuff));
+    __setMutexDriver(&stream);
+
+    PRINTF("COBS encode\n");
+    assert(UInt8, Stream_writeCobs(&stream, (uint8_t*) "\x11\x22\x00\x33", 4), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 6);
+    assert(Bytes, streamBuff, (uint8_t*) "\x03\x11\x22\x02\x33\x00", 6);
+    assert(UInt8, Stream_writeCobs(&stream, (uint8_t*) "\x00", 1), Stream_Ok);
+    assert(Bytes, &streamBuff[6], (uint8_t*) "\x01\x01\x00", 3);
+    assert(UInt8, Stream_writeCobs(&stream, src, 0), Stream_Ok);
+    assert(Bytes, &streamBuff[9], (uint8_t*) "\x01\x00", 2);
+    assert(UInt8, Stream_writeCobs(&stream, src, 60), Stream_NoSpace);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 11);
+
+    PRINTF("COBS decode\n");
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(UInt32, (uint32_t) n, 4);
+    assert(Bytes, dst, (uint8_t*) "\x11\x22\x00\x33", 4);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(UInt32, (uint32_t) n, 1);
+    assert(UInt8, dst[0], 0x00);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(UInt32, (uint32_t) n, 0);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_NoAvailable);
+    // leading delimiters skipped, partial frame wait
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\x00\x00\x03\x11", 4), Stream_Ok);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_NoAvailable);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\x22\x00", 2), Stream_Ok);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, 1, &n), Stream_FrameTooLong);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\x05\x11\x00", 3), Stream_Ok);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_BadFrame);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+
+    PRINTF("COBS long block\n");
+    {
+        uint8_t longBuff[TEST_SIZE(600)];
+        StreamBuffer longStream;
+        Stream_init(&longStream, longBuff, sizeof(longBuff));
+        __setMutexDriver(&longStream);
+        for (i = 0; i < 255; i++) {
+            src[i] = (uint8_t) (i + 1);
+        }
+        assert(UInt8, Stream_writeCobs(&longStream, src, 254), Stream_Ok);
+        assert(UInt32, (uint32_t) Stream_available(&longStream), 256);
+        assert(UInt8, longBuff[0], 0xFF);
+        assert(UInt8, longBuff[255], 0x00);
+        assert(UInt8, Stream_writeCobs(&longStream, src, 255), Stream_Ok);
+        assert(UInt32, (uint32_t) Stream_available(&longStream), 256 + 258);
+        assert(Bytes, &longBuff[256 + 255], (uint8_t*) "\x02\xFF\x00", 3);
+        assert(UInt8, Stream_readCobsFrame(&longStream, dst, sizeof(dst), &n), Stream_Ok);
+        assert(UInt32, (uint32_t) n, 254);
+        assert(Bytes, dst, src, 254);
+        assert(UInt8, Stream_readCobsFrame(&longStream, dst, sizeof(dst), &n), Stream_Ok);
+        assert(UInt32, (uint32_t) n, 255);
+        assert(Bytes, dst, src, 255);
+    }
+
+    PRINTF("SLIP\n");
+    Stream_clear(&stream);
+    assert(UInt8, Stream_writeSlip(&stream, (uint8_t*) "\xC0\xDB\x01", 3), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 6);
+    assert(Bytes, streamBuff, (uint8_t*) "\xDB\xDC\xDB\xDD\x01\xC0", 6);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(UInt32, (uint32_t) n, 3);
+    assert(Bytes, dst, (uint8_t*) "\xC0\xDB\x01", 3);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\xC0\x01\xDB\x01\xC0", 5), Stream_Ok);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_BadFrame);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\x01\xDB", 2), Stream_Ok);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_NoAvailable);
+    assert(UInt8, Stream_writeBytes(&stream, (uint8_t*) "\xC0", 1), Stream_Ok);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_BadFrame);
+    assert(UInt8, Stream_writeSlip(&stream, src, 70), Stream_NoSpace);
+
+    PRINTF("Full buffer without delimiter\n");
+    Stream_clear(&stream);
+    assert(UInt8, Stream_writePadding(&stream, 0x01, Stream_space(&stream)), Stream_Ok);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_FrameTooLong);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+    assert(UInt8, Stream_writeCobs(&stream, (uint8_t*) "\x11\x00", 2), Stream_Ok);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(UInt32, (uint32_t) n, 2);
+    assert(UInt8, Stream_writePadding(&stream, 0x01, Stream_space(&stream)), Stream_Ok);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_FrameTooLong);
+    assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+    assert(UInt8, Stream_writeSlip(&stream, (uint8_t*) "\x11\xC0", 2), Stream_Ok);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(UInt32, (uint32_t) n, 2);
+
+    PRINTF("Wrap around end of buffer\n");
+    for (i = 0; i < 30; i++) {
+        src[i] = (uint8_t) (i % 5 == 0 ? 0x00 : i % 7 == 0 ? STREAM_SLIP_END : i % 11 == 0 ? STREAM_SLIP_ESC : i * 13);
+    }
+    for (offset = 1; offset < (Stream_LenType) sizeof(streamBuff); offset++) {
+        for (len = 1; len <= 30; len += 7) {
+            Stream_clear(&stream);
+            assert(UInt8, Stream_writePadding(&stream, 0xEE, offset), Stream_Ok);
+            assert(UInt8, Stream_moveReadPos(&stream, offset), Stream_Ok);
+            assert(UInt8, Stream_writeCobs(&stream, src, len), Stream_Ok);
+            assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+            assert(UInt32, (uint32_t) n, (uint32_t) len);
+            assert(Bytes, dst, src, len);
+            assert(UInt8, Stream_writeSlip(&stream, src, len), Stream_Ok);
+            assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+            assert(UInt32, (uint32_t) n, (uint32_t) len);
+            assert(Bytes, dst, src, len);
+            assert(UInt32, (uint32_t) Stream_available(&stream), 0);
+        }
+    }
+
+#if STREAM_WRITE_LIMIT && STREAM_READ_LIMIT
+    PRINTF("Limited stream\n");
+    Stream_clear(&stream);
+    // encoded frames are 6 bytes, written and read bytes use up limit
+    Stream_setWriteLimit(&stream, 14);
+    assert(UInt8, Stream_writeCobs(&stream, (uint8_t*) "\x11\x22\x00\x33", 4), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_getWriteLimit(&stream), 8);
+    assert(UInt8, Stream_writeSlip(&stream, (uint8_t*) "\xC0\xDB\x01", 3), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_getWriteLimit(&stream), 2);
+    assert(UInt8, Stream_writeCobs(&stream, (uint8_t*) "\x11", 1), Stream_NoSpace);
+    Stream_setReadLimit(&stream, 10);
+    assert(UInt8, Stream_readCobsFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(UInt32, (uint32_t) Stream_getReadLimit(&stream), 4);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_NoAvailable);
+    Stream_setReadLimit(&stream, 6);
+    assert(UInt8, Stream_readSlipFrame(&stream, dst, sizeof(dst), &n), Stream_Ok);
+    assert(Bytes, dst, (uint8_t*) "\xC0\xDB\x01", 3);
+    assert(UInt32, (uint32_t) Stream_getReadLimit(&stream), 0);
+#endif // STREAM_WRITE_LIMIT && STREAM_READ_LIMIT
+
+    return 0;
+}
+#endif
+/********************************************************/
+#define ASSERT_NUM(TYPE, DTYPE)     uint32_t Assert_ ##TYPE (DTYPE num1, DTYPE num2, uint16_t line, uint8_t cycle, uint8_t assertIndex) {\
+                                        if (num1 != num2) {\
+                                            PRINTF("Expected: %ld, Found: %ld\n", (long int) num2, (long int) num1);\
+                                                return line << 16 | assertIndex << 8 | cycle;\
+                                        }\
+                                        return 0;\
+                                    }
+
+ASSERT_NUM(Char, char)
+ASSERT_NUM(Int8, int8_t)
+ASSERT_NUM(Int16, int16_t)
+ASSERT_NUM(Int32, int32_t)
+ASSERT_NUM(UInt8, uint8_t)
+ASSERT_NUM(UInt16, uint16_t)
+ASSERT_NUM(UInt32, uint32_t)
+ASSERT_NUM(Float, float)
+#if STREAM_UINT64
+    ASSERT_NUM(Int64, int64_t)
+    ASSERT_NUM(UInt64, uint64_t)
+#endif // STREAM_UINT64
+#if STREAM_DOUBLE
+    ASSERT_NUM(Double, double)
+#endif // STREAM_DOUBLE
+
+uint32_t Assert_Bytes(uint8_t* a, uint8_t* b, uint32_t len, uint16_t line, uint8_t cycle, uint8_t assertIndex) {
+    if (memcmp(a, b, len) != 0) {
+        return line << 16 | assertIndex << 8 | cycle;
+    }
+    return 0;
+}
+
+void Assert_dump(StreamBuffer* stream) {
+    uint8_t* ptr = stream->Data;
+    Stream_LenType len = stream->Size;
+    PRINTF("----------------------- Stream Dump -----------------------\n");
+#if STREAM_SPSC
+    // no overflow flag in lock-free mode, write position behind read position is overflow
+    PRINTF("RPos: %u, WPos: %u, Size: %u, Available: %u, Space: %u, Overflow: %u\n", (unsigned) stream->RPos, (unsigned) stream->WPos, (unsigned) stream->Size, (unsigned) Stream_available(stream), (unsigned) Stream_space(stream), (unsigned) (stream->WPos < stream->RPos));
+#else
+    PRINTF("RPos: %u, WPos: %u, Size: %u, Available: %u, Space: %u, Overflow: %u\n", (unsigned) stream->RPos, (unsigned) stream->WPos, (unsigned) stream->Size, (unsigned) Stream_available(stream), (unsigned) Stream_space(stream), stream->Overflow);
+#endif
     PRINTF("[");
     while (len-- > 0) {
         PRINTF("0x%02X, ", *ptr++);
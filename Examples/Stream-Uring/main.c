@@ -0,0 +1,202 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "StreamFd.h"
+#include "StreamUring.h"
+
+/**
+ * Many pipes throughput test, each round write one chunk into every OStream and read it back
+ * from every IStream in same thread, compare StreamFd driver (poll + readv/writev for each stream)
+ * with StreamUring driver (all requests of round submitted and reaped with few io_uring_enter)
+ */
+
+#if !STREAM_FD || !STREAM_URING
+    #error "Stream-Uring example need STREAM_FD and STREAM_URING"
+#endif
+
+#define PIPES_NUM                   256
+#define STREAM_SIZE                 4096
+#define CHUNK_SIZE                  512
+#define ROUNDS                      2000
+
+static uint8_t inBuff[PIPES_NUM][STREAM_SIZE];
+static uint8_t outBuff[PIPES_NUM][STREAM_SIZE];
+static StreamIn ins[PIPES_NUM];
+static StreamOut outs[PIPES_NUM];
+static StreamUring_Io inIos[PIPES_NUM];
+static StreamUring_Io outIos[PIPES_NUM];
+static struct pollfd pfds[PIPES_NUM];
+static int fds[PIPES_NUM][2];
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int openPipes(void) {
+    int i;
+    for (i = 0; i < PIPES_NUM; i++) {
+        if (pipe(fds[i]) != 0) {
+            perror("pipe");
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void closePipes(void) {
+    int i;
+    for (i = 0; i < PIPES_NUM; i++) {
+        close(fds[i][0]);
+        close(fds[i][1]);
+    }
+}
+/**
+ * @brief write one chunk of sequence into each stream
+ */
+static void writeRound(uint8_t seq) {
+    uint8_t chunk[CHUNK_SIZE];
+    int i;
+
+    for (i = 0; i < CHUNK_SIZE; i++) {
+        chunk[i] = (uint8_t) (seq + i);
+    }
+    for (i = 0; i < PIPES_NUM; i++) {
+        OStream_writeBytes(&outs[i], chunk, CHUNK_SIZE);
+    }
+}
+/**
+ * @brief read chunk back from each stream that has full chunk
+ *
+ * @return int number of streams read
+ */
+static int readRound(uint8_t seq, int* errors) {
+    uint8_t chunk[CHUNK_SIZE];
+    int count = 0;
+    int i, j;
+
+    for (i = 0; i < PIPES_NUM; i++) {
+        if (IStream_available(&ins[i]) >= CHUNK_SIZE) {
+            IStream_readBytes(&ins[i], chunk, CHUNK_SIZE);
+            for (j = 0; j < CHUNK_SIZE; j++) {
+                if (chunk[j] != (uint8_t) (seq + j)) {
+                    (*errors)++;
+                    break;
+                }
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+static void printResult(const char* name, double elapsed, int errors) {
+    double total = (double) PIPES_NUM * CHUNK_SIZE * ROUNDS / (1024.0 * 1024.0);
+    printf("%-12s %4d pipes %7.1f MB in %7.3f s, %8.1f MB/s %s\n",
+        name, PIPES_NUM, total, elapsed, total / elapsed, errors ? "FAILED" : "OK");
+}
+
+static int runFd(void) {
+    double elapsed;
+    int errors = 0;
+    int round;
+    int done;
+    int i;
+
+    if (openPipes()) {
+        return 1;
+    }
+    for (i = 0; i < PIPES_NUM; i++) {
+        IStream_initFd(&ins[i], fds[i][0], inBuff[i], STREAM_SIZE);
+        OStream_initFd(&outs[i], fds[i][1], outBuff[i], STREAM_SIZE);
+        pfds[i].fd = fds[i][0];
+        pfds[i].events = POLLIN;
+    }
+
+    elapsed = now();
+    for (round = 0; round < ROUNDS && !errors; round++) {
+        writeRound((uint8_t) round);
+        for (i = 0; i < PIPES_NUM; i++) {
+            if (OStream_handleFd(&outs[i]) != Stream_Ok) {
+                errors++;
+            }
+        }
+        done = 0;
+        while (done < PIPES_NUM && !errors) {
+            if (poll(pfds, PIPES_NUM, -1) < 0) {
+                errors++;
+                break;
+            }
+            for (i = 0; i < PIPES_NUM; i++) {
+                if (pfds[i].revents & POLLIN) {
+                    IStream_handleFd(&ins[i]);
+                }
+            }
+            done += readRound((uint8_t) round, &errors);
+        }
+    }
+    elapsed = now() - elapsed;
+
+    printResult("StreamFd", elapsed, errors);
+    closePipes();
+    return errors;
+}
+
+static int runUring(void) {
+    StreamUring uring;
+    double elapsed;
+    int errors = 0;
+    int round;
+    int done;
+    int i;
+
+    if (StreamUring_init(&uring, PIPES_NUM * 2) != Stream_Ok) {
+        printf("%-12s io_uring not supported, skip\n", "StreamUring");
+        return 0;
+    }
+    if (openPipes()) {
+        StreamUring_deinit(&uring);
+        return 1;
+    }
+    for (i = 0; i < PIPES_NUM; i++) {
+        IStream_initUring(&ins[i], &inIos[i], &uring, fds[i][0], inBuff[i], STREAM_SIZE);
+        OStream_initUring(&outs[i], &outIos[i], &uring, fds[i][1], outBuff[i], STREAM_SIZE);
+        IStream_receive(&ins[i]);
+    }
+
+    elapsed = now();
+    for (round = 0; round < ROUNDS && !errors; round++) {
+        writeRound((uint8_t) round);
+        for (i = 0; i < PIPES_NUM; i++) {
+            OStream_flush(&outs[i]);
+        }
+        done = 0;
+        while (done < PIPES_NUM && !errors) {
+            if (StreamUring_poll(&uring, 1) < 0) {
+                errors++;
+                break;
+            }
+            done += readRound((uint8_t) round, &errors);
+        }
+    }
+    elapsed = now() - elapsed;
+
+    printResult("StreamUring", elapsed, errors);
+    StreamUring_deinit(&uring);
+    closePipes();
+    return errors;
+}
+
+int main()
+{
+    int errors = 0;
+
+    errors += runFd();
+    errors += runUring();
+
+    return errors != 0;
+}
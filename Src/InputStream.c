@@ -47,6 +47,9 @@ void IStream_init(StreamIn* stream, IStream_ReceiveFn receiveFn, uint8_t* buff,
 #if ISTREAM_CHECK_RECEIVE
     stream->checkReceive = (IStream_CheckReceiveFn) 0;
 #endif
+#if ISTREAM_RECEIVE_CALLBACK
+    stream->onReceive = (IStream_OnReceiveFn) 0;
+#endif
 #if ISTREAM_FULL_CALLBACK
     stream->onFull = (IStream_OnFullFn) 0;
 #endif
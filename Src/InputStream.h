@@ -122,6 +122,11 @@ Stream_LenType      IStream_available(StreamIn* stream);
     void            IStream_onFull(StreamIn* stream, IStream_OnFullFn fn);
 #endif
 
+#if STREAM_TRANSACTION
+    #define         IStream_beginRead(STREAM, LEN)                          Stream_beginRead(&(STREAM)->Buffer, (LEN))
+    #define         IStream_endRead(STREAM)                                 Stream_endRead(&(STREAM)->Buffer)
+#endif // STREAM_TRANSACTION
+
 #if STREAM_READ_LOCK_CUSTOM
     #define         IStream_lock(STREAM, LOCK, LEN)                         Stream_lockReadCustom(&(STREAM)->Buffer, &(LOCK)->Buffer, LEN, sizeof(StreamIn))
     #define         IStream_unlock(STREAM, LOCK)                            Stream_unlockRead(&(STREAM)->Buffer, &(LOCK)->Buffer);
@@ -112,6 +112,17 @@ Stream_LenType      OStream_space(StreamOut* stream);
     void            OStream_setFlushCallback(StreamOut* stream, OStream_FlushCallbackFn fn);
 #endif
 
+#if STREAM_WRITE_RESERVE
+    #define         OStream_reserve(STREAM, LEN, PTR)                       Stream_reserve(&(STREAM)->Buffer, (LEN), (PTR))
+    #define         OStream_commit(STREAM, LEN)                             Stream_commit(&(STREAM)->Buffer, (LEN))
+    #define         OStream_reservedLen(STREAM)                             Stream_reservedLen(&(STREAM)->Buffer)
+#endif // STREAM_WRITE_RESERVE
+
+#if STREAM_TRANSACTION
+    #define         OStream_beginWrite(STREAM, LEN)                         Stream_beginWrite(&(STREAM)->Buffer, (LEN))
+    #define         OStream_endWrite(STREAM)                                Stream_endWrite(&(STREAM)->Buffer)
+#endif // STREAM_TRANSACTION
+
 #if STREAM_WRITE_LOCK_CUSTOM
     #define         OStream_lock(STREAM, LOCK, LEN)                         Stream_lockWriteCustom(&(STREAM)->Buffer, &(LOCK)->Buffer, (LEN), sizeof(StreamOut))
     #define         OStream_unlock(STREAM, LOCK)                            Stream_unlockWrite(&(STREAM)->Buffer, &(LOCK)->Buffer);
@@ -1,27 +1,44 @@
 #include "StreamBuffer.h"
 #include <string.h>
 
+#if STREAM_MEM_SIMD && (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define __STREAM_SIMD_X86                       1
+    #include <immintrin.h>
+#else
+    #define __STREAM_SIMD_X86                       0
+#endif
+
+#if STREAM_MIRRORED
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
 /* Memory IO Macros */
 #if   STREAM_MEM_IO == STREAM_MEM_IO_DEFAULT
     #define __memCopy(S, DEST, SRC, LEN)            STREAM_MEM_COPY((DEST), (SRC), (LEN))
     #define __memCopyReverse(S, DEST, SRC, LEN)     STREAM_MEM_COPY_REVERSE((DEST), (SRC), (LEN))
     #define __memSet(S, SRC, VAL, LEN)              STREAM_MEM_SET((SRC), (VAL), (LEN))
     #define __memReverse(S, SRC, LEN)               STREAM_MEM_REVERSE((SRC), (LEN))
+    #define __memSwapCopy(S, DEST, SRC, ITEM, LEN)  STREAM_MEM_SWAP_COPY((DEST), (SRC), (ITEM), (LEN))
 #elif STREAM_MEM_IO == STREAM_MEM_IO_CUSTOM
     #define __memCopy(S, DEST, SRC, LEN)            (S)->Mem.copy((DEST), (SRC), (LEN))
     #define __memCopyReverse(S, DEST, SRC, LEN)     (S)->Mem.copyReverse((DEST), (SRC), (LEN))
     #define __memSet(S, SRC, VAL, LEN)              (S)->Mem.set((SRC), (VAL), (LEN))
     #define __memReverse(S, SRC, LEN)               (S)->Mem.reverse((SRC), (LEN))
+    #define __memSwapCopy(S, DEST, SRC, ITEM, LEN)  Stream_memSwapCopy((S), (DEST), (SRC), (ITEM), (LEN))
 #elif STREAM_MEM_IO == STREAM_MEM_IO_DRIVER
     #define __memCopy(S, DEST, SRC, LEN)            (S)->Mem->copy((DEST), (SRC), (LEN))
     #define __memCopyReverse(S, DEST, SRC, LEN)     (S)->Mem->copyReverse((DEST), (SRC), (LEN))
     #define __memSet(S, SRC, VAL, LEN)              (S)->Mem->set((SRC), (VAL), (LEN))
     #define __memReverse(S, SRC, LEN)               (S)->Mem->reverse((SRC), (LEN))
+    #define __memSwapCopy(S, DEST, SRC, ITEM, LEN)  Stream_memSwapCopy((S), (DEST), (SRC), (ITEM), (LEN))
 #elif STREAM_MEM_IO == STREAM_MEM_IO_GLOBAL_DRIVER
     #define __memCopy(S, DEST, SRC, LEN)            __streamMemDriver->copy((DEST), (SRC), (LEN))
     #define __memCopyReverse(S, DEST, SRC, LEN)     __streamMemDriver->copyReverse((DEST), (SRC), (LEN))
     #define __memSet(S, SRC, VAL, LEN)              __streamMemDriver->set((SRC), (VAL), (LEN))
     #define __memReverse(S, SRC, LEN)               __streamMemDriver->reverse((SRC), (LEN))
+    #define __memSwapCopy(S, DEST, SRC, ITEM, LEN)  Stream_memSwapCopy((S), (DEST), (SRC), (ITEM), (LEN))
 #else
     #error "STREAM_MEM_IO is invalid!"
 #endif // STREAM_MEM_IO
@@ -47,10 +64,33 @@
     #define __IMPL_MUTEX_LOCK(S)                    __streamMutexDriver && __streamMutexDriver->lock ? __streamMutexDriver->lock((S), &(S)->Mutex) : STREAM_MUTEX_NO_Function
     #define __IMPL_MUTEX_UNLOCK(S)                  __streamMutexDriver && __streamMutexDriver->unlock ? __streamMutexDriver->unlock((S), &(S)->Mutex) : STREAM_MUTEX_NO_Function
     #define __IMPL_MUTEX_DEINIT(S)                  __streamMutexDriver && __streamMutexDriver->deinit ? __streamMutexDriver->deinit((S), &(S)->Mutex) : STREAM_MUTEX_NO_Function
+#elif STREAM_MUTEX == STREAM_MUTEX_BUILT_IN
+    #if !STREAM_MUTEX_POSIX || defined(STREAM_MUTEX_TYPE)
+        #error "STREAM_MUTEX_BUILT_IN need STREAM_MUTEX_POSIX and default STREAM_MUTEX_TYPE"
+    #endif
+    #define __IMPL_MUTEX_INIT(S)                    StreamLock_init(&(S)->Mutex)
+    #define __IMPL_MUTEX_LOCK(S)                    StreamLock_lock(&(S)->Mutex)
+    #define __IMPL_MUTEX_UNLOCK(S)                  StreamLock_unlock(&(S)->Mutex)
+    #define __IMPL_MUTEX_DEINIT(S)                  StreamLock_deinit(&(S)->Mutex)
 #else
     #error "STREAM_MUTEX is invalid!"
 #endif // STREAM_MUTEX
 
+#if (STREAM_WRITE_STREAM || STREAM_READ_STREAM) && !STREAM_TRANSFER
+    #error "STREAM_WRITE_STREAM and STREAM_READ_STREAM need STREAM_TRANSFER"
+#endif
+
+#if STREAM_FRAME && (STREAM_SPSC || !STREAM_IO_VEC)
+    #error "STREAM_FRAME need STREAM_IO_VEC and not supported with STREAM_SPSC"
+#endif
+#if STREAM_FRAME && STREAM_FRAME_HEADER_LEN != 1 && STREAM_FRAME_HEADER_LEN != 2 && STREAM_FRAME_HEADER_LEN != 4
+    #error "STREAM_FRAME_HEADER_LEN must be 1, 2 or 4"
+#endif
+
+#if STREAM_BIP && (!STREAM_WRITE_RESERVE || STREAM_SPSC || STREAM_SIZE_POW2)
+    #error "STREAM_BIP need STREAM_WRITE_RESERVE and not supported with STREAM_SPSC or STREAM_SIZE_POW2"
+#endif
+
 /* private typedef */
 typedef Stream_Result (*Stream_WriteBytesFn)(StreamBuffer* stream, uint8_t* val, Stream_LenType len);
 typedef Stream_Result (*Stream_ReadBytesFn)(StreamBuffer* stream, uint8_t* val, Stream_LenType len);
@@ -64,8 +104,10 @@ static const Stream_WriteBytesFn writeBytes[2] = {
 };
 
     #define __writeBytes(STREAM, VAL, LEN)          writeBytes[STREAM->OrderFn]((STREAM), (VAL), (LEN))    
+    #define __writeReverse(STREAM)                  (STREAM)->OrderFn
 #else
     #define __writeBytes(STREAM, VAL, LEN)          Stream_writeBytes((STREAM), (VAL), (LEN))
+    #define __writeReverse(STREAM)                  0
 #endif // STREAM_BYTE_ORDER
 
 #if STREAM_READ_REVERSE
@@ -75,8 +117,10 @@ static const Stream_ReadBytesFn readBytes[2] = {
 };
 
     #define __readBytes(STREAM, VAL, LEN)           readBytes[STREAM->OrderFn]((STREAM), (VAL), (LEN))
+    #define __readReverse(STREAM)                   (STREAM)->OrderFn
 #else
     #define __readBytes(STREAM, VAL, LEN)           Stream_readBytes((STREAM), (VAL), (LEN))
+    #define __readReverse(STREAM)                   0
 #endif
 
 #if STREAM_GET_AT_BYTES_REVERSE
@@ -86,8 +130,10 @@ static const Stream_GetBytesFn getBytesAt[2] = {
 };
 
     #define __getBytesAt(STREAM, INDEX, VAL, LEN)   getBytesAt[STREAM->OrderFn]((STREAM), (INDEX), (VAL), (LEN))
+    #define __getReverse(STREAM)                    (STREAM)->OrderFn
 #else
     #define __getBytesAt(STREAM, INDEX, VAL, LEN)   Stream_getBytesAt((STREAM), (INDEX), (VAL), (LEN))
+    #define __getReverse(STREAM)                    0
 #endif // STREAM_GET_AT
 
 #if STREAM_SET_AT_BYTES_REVERSE
@@ -97,8 +143,10 @@ static const Stream_SetBytesFn setBytesAt[2] = {
 };
 
     #define __setBytesAt(STREAM, INDEX, VAL, LEN)   setBytesAt[STREAM->OrderFn]((STREAM), (INDEX), (VAL), (LEN))
+    #define __setReverse(STREAM)                    (STREAM)->OrderFn
 #else
     #define __setBytesAt(STREAM, INDEX, VAL, LEN)   Stream_setBytesAt((STREAM), (INDEX), (VAL), (LEN))
+    #define __setReverse(STREAM)                    0
 #endif // STREAM_SET_AT
 
 #if STREAM_FIND_AT_VALUE
@@ -129,18 +177,30 @@ static const Stream_MutexDriver* __streamMutexDriver = (Stream_MutexDriver*) 0;
 #endif
 
 #if STREAM_MUTEX
+#if STREAM_MUTEX == STREAM_MUTEX_BUILT_IN
+    // built-in lock inlined in stream functions
+    #define __mutexInitFn(S)                        __IMPL_MUTEX_INIT(S)
+    #define __mutexLockFn(S)                        __IMPL_MUTEX_LOCK(S)
+    #define __mutexUnlockFn(S)                      __IMPL_MUTEX_UNLOCK(S)
+    #define __mutexDeInitFn(S)                      __IMPL_MUTEX_DEINIT(S)
+#else
+    #define __mutexInitFn(S)                        Stream_mutexInit(S)
+    #define __mutexLockFn(S)                        Stream_mutexLock(S)
+    #define __mutexUnlockFn(S)                      Stream_mutexUnlock(S)
+    #define __mutexDeInitFn(S)                      Stream_mutexDeInit(S)
+#endif
 #if STREAM_MUTEX_CHECK_RESULT
     #define __mutexVarInit()                        Stream_MutexResult mutexError
-    #define __mutexInit(S)                          if ((mutexError = Stream_mutexInit((S)))) { return Stream_MutexError | mutexError; }
-    #define __mutexLock(S)                          if ((mutexError = Stream_mutexLock((S)))) { return Stream_MutexError | mutexError; }
-    #define __mutexUnlock(S)                        if ((mutexError = Stream_mutexUnlock((S)))) { return Stream_MutexError | mutexError; }
-    #define __mutexDeInit(S)                        if ((mutexError = Stream_mutexDeInit((S)))) { return Stream_MutexError | mutexError; }
+    #define __mutexInit(S)                          if ((mutexError = __mutexInitFn((S)))) { return Stream_MutexError | mutexError; }
+    #define __mutexLock(S)                          if ((mutexError = __mutexLockFn((S)))) { return Stream_MutexError | mutexError; }
+    #define __mutexUnlock(S)                        if ((mutexError = __mutexUnlockFn((S)))) { return Stream_MutexError | mutexError; }
+    #define __mutexDeInit(S)                        if ((mutexError = __mutexDeInitFn((S)))) { return Stream_MutexError | mutexError; }
 #else
     #define __mutexVarInit()
-    #define __mutexInit(S)                          Stream_mutexInit((S))
-    #define __mutexLock(S)                          Stream_mutexLock((S))
-    #define __mutexUnlock(S)                        Stream_mutexUnlock((S))
-    #define __mutexDeInit(S)                        Stream_mutexDeInit((S))
+    #define __mutexInit(S)                          __mutexInitFn((S))
+    #define __mutexLock(S)                          __mutexLockFn((S))
+    #define __mutexUnlock(S)                        __mutexUnlockFn((S))
+    #define __mutexDeInit(S)                        __mutexDeInitFn((S))
 #endif
 #else
     #define __mutexVarInit()
@@ -170,28 +230,144 @@ static const Stream_MutexDriver* __streamMutexDriver = (Stream_MutexDriver*) 0;
     #define __readLimit(S, LEN)
 #endif
 
+#if STREAM_FIND_RESUME
+    #define __readTotal(S, LEN)                     (S)->ReadTotal += (LEN)
+#else
+    #define __readTotal(S, LEN)
+#endif
+
 #define __checkSpace(S, LEN)                        if (Stream_space((S)) < (LEN)) { return Stream_NoSpace; }
 #define __checkAvailable(S, LEN)                    if (Stream_available((S)) < (LEN)) { return Stream_NoAvailable; }
 
+/* Position Macros */
+#if STREAM_SPSC
+    #define __getWPos(S)                            atomic_load_explicit(&(S)->WPos, memory_order_acquire)
+    #define __getRPos(S)                            atomic_load_explicit(&(S)->RPos, memory_order_acquire)
+    #define __setWPos(S, VAL)                       atomic_store_explicit(&(S)->WPos, (VAL), memory_order_release)
+    #define __setRPos(S, VAL)                       atomic_store_explicit(&(S)->RPos, (VAL), memory_order_release)
+    #define __isOverflow(S, WPOS, RPOS)             ((WPOS) < (RPOS))
+    #define __setOverflow(S, VAL)
+    #define __spaceGap                              1
+#else
+    #define __getWPos(S)                            (S)->WPos
+    #define __getRPos(S)                            (S)->RPos
+    #define __setWPos(S, VAL)                       (S)->WPos = (VAL)
+    #define __setRPos(S, VAL)                       (S)->RPos = (VAL)
+    #define __isOverflow(S, WPOS, RPOS)             (S)->Overflow
+#if STREAM_BIP
+    // reader left the shortened lap, so whole buffer is usable again
+    #define __setOverflow(S, VAL)                   (void) (((S)->Overflow = (VAL)) || ((S)->Size = (S)->Capacity))
+#else
+    #define __setOverflow(S, VAL)                   (S)->Overflow = (VAL)
+#endif // STREAM_BIP
+    #define __spaceGap                              0
+#endif // STREAM_SPSC
+
+/* Index Wrap */
+#if STREAM_SIZE_POW2
+    #define __wrapIndex(S, IDX)                     ((IDX) & ((S)->Size - 1))
+#else
+    #define __wrapIndex(S, IDX)                     ((IDX) % (S)->Size)
+#endif // STREAM_SIZE_POW2
+
+/* Mirrored Macros */
+#if STREAM_MIRRORED
+    #define __isMirrored(S)                         (S)->Mirrored
+    // in mirrored stream whole len is in row, so first segment take all of it
+    #define __segmentLen(S, SEG, LEN)               ((S)->Mirrored ? (LEN) : (SEG))
+#else
+    #define __isMirrored(S)                         0
+    #define __segmentLen(S, SEG, LEN)               (SEG)
+#endif // STREAM_MIRRORED
+
+/* Unlocked Space Macros */
+// space and available computed without lock, caller must hold lock
+#define __spaceRealUnlocked(S)                      ((S)->Size * !__isOverflow((S), __getWPos(S), __getRPos(S)) + __getRPos(S) - __getWPos(S) - __spaceGap)
+#define __availableRealUnlocked(S)                  ((S)->Size * __isOverflow((S), __getWPos(S), __getRPos(S)) + __getWPos(S) - __getRPos(S))
+#if STREAM_WRITE_LIMIT
+    #define __spaceUnlocked(S)                      ((S)->WriteLimit != STREAM_NO_LIMIT ? (S)->WriteLimit : __spaceRealUnlocked(S))
+#else
+    #define __spaceUnlocked(S)                      __spaceRealUnlocked(S)
+#endif
+#if STREAM_READ_LIMIT
+    #define __availableUnlocked(S)                  ((S)->ReadLimit != STREAM_NO_LIMIT ? (S)->ReadLimit : __availableRealUnlocked(S))
+#else
+    #define __availableUnlocked(S)                  __availableRealUnlocked(S)
+#endif
+
+/* Frame Macros */
+#if STREAM_FRAME
+    // bytes from FROM position to TO position in ring
+    #define __frameDistance(S, FROM, TO)            ((TO) >= (FROM) ? (TO) - (FROM) : (S)->Size - (FROM) + (TO))
+    // open frame is hidden from readers, caller must hold lock
+    #define __frameAvailableUnlocked(S)             ((S)->InFrame ? __frameDistance((S), __getRPos(S), (S)->FrameStart) : __availableUnlocked(S))
+    #define __frameMaxLen(W)                        ((W) >= 4 ? 0xFFFFFFFFUL : (1UL << ((W) * 8)) - 1)
+#endif // STREAM_FRAME
+
+/* Transaction Macros */
+#if STREAM_TRANSACTION
+#if STREAM_MUTEX_POSIX
+    // only thread that began transaction see its own id, other threads wait for lock
+    #define __isTxOwner(S, OWNER)                   (atomic_load_explicit(&(S)->OWNER, memory_order_relaxed) == __streamLockSelf())
+    #define __isTxOther(S, OWNER)                   (!__isTxOwner(S, OWNER))
+    #define __setTxOwner(S, OWNER, VAL)             atomic_store_explicit(&(S)->OWNER, (VAL), memory_order_relaxed)
+#else
+    // no thread id, calls in transaction take recursive lock again
+    #define __isTxOwner(S, OWNER)                   0
+    #define __isTxOther(S, OWNER)                   0
+    #define __setTxOwner(S, OWNER, VAL)
+#endif // STREAM_MUTEX_POSIX
+    // owner already hold lock, so space and available computed without lock
+    #define __checkSpaceTx(S, LEN)                  if ((__isTxOwner((S), WriteOwner) ? __spaceUnlocked(S) : Stream_space((S))) < (LEN)) { return Stream_NoSpace; }
+    #define __checkAvailableTx(S, LEN)              if ((__isTxOwner((S), ReadOwner) ? __availableUnlocked(S) : Stream_available((S))) < (LEN)) { return Stream_NoAvailable; }
+    #define __mutexLockWriteTx(S)                   if (!__isTxOwner((S), WriteOwner)) { __mutexLock((S)); }
+    #define __mutexUnlockWriteTx(S)                 if (!__isTxOwner((S), WriteOwner)) { __mutexUnlock((S)); }
+    #define __mutexLockReadTx(S)                    if (!__isTxOwner((S), ReadOwner)) { __mutexLock((S)); }
+    #define __mutexUnlockReadTx(S)                  if (!__isTxOwner((S), ReadOwner)) { __mutexUnlock((S)); }
+#else
+    #define __checkSpaceTx(S, LEN)                  __checkSpace(S, LEN)
+    #define __checkAvailableTx(S, LEN)              __checkAvailable(S, LEN)
+    #define __mutexLockWriteTx(S)                   __mutexLock((S))
+    #define __mutexUnlockWriteTx(S)                 __mutexUnlock((S))
+    #define __mutexLockReadTx(S)                    __mutexLock((S))
+    #define __mutexUnlockReadTx(S)                  __mutexUnlock((S))
+#endif // STREAM_TRANSACTION
+
 /**
  * @brief initialize stream
  *
  * @param stream address of stream struct
  * @param buffer address of byte buffer
- * @param size size of buffer
+ * @param size size of buffer, in STREAM_SIZE_POW2 mode other sizes rejected
+ * and stream initialized with zero size, so every write return Stream_NoSpace,
+ * use Stream_initPow2 to get result
  */
 void Stream_init(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size) {
+#if STREAM_SIZE_POW2
+    if (!STREAM_IS_POW2(size)) {
+        size = 0;
+    }
+#endif // STREAM_SIZE_POW2
     stream->Data = buffer;
     stream->Size = size;
-    stream->Overflow = 0;
+#if STREAM_BIP
+    stream->Capacity = size;
+#endif // STREAM_BIP
+    __setOverflow(stream, 0);
+#if STREAM_MIRRORED
+    stream->Mirrored = 0;
+#endif // STREAM_MIRRORED
     stream->InReceive = 0;
     stream->InTransmit = 0;
 #if STREAM_BYTE_ORDER
     stream->Order = Stream_getSystemByteOrder();
     stream->OrderFn = 0;
 #endif // STREAM_BYTE_ORDER
-    stream->RPos = 0;
-    stream->WPos = 0;
+    __setRPos(stream, 0);
+    __setWPos(stream, 0);
+#if STREAM_FIND_RESUME
+    stream->ReadTotal = 0;
+#endif // STREAM_FIND_RESUME
 #if STREAM_WRITE_LIMIT
     stream->WriteLimit = STREAM_NO_LIMIT;
 #endif // STREAM_WRITE_LIMIT
@@ -210,6 +386,19 @@ void Stream_init(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size) {
 #if STREAM_PENDING_BYTES
     stream->PendingBytes = 0;
 #endif // STREAM_PENDING_BYTES
+#if STREAM_TRANSACTION
+    stream->WriteTx = 0;
+    stream->ReadTx = 0;
+    __setTxOwner(stream, WriteOwner, 0);
+    __setTxOwner(stream, ReadOwner, 0);
+#endif // STREAM_TRANSACTION
+#if STREAM_WRITE_RESERVE
+    stream->Reserved = 0;
+#endif // STREAM_WRITE_RESERVE
+#if STREAM_FRAME
+    stream->FrameHeader = STREAM_FRAME_HEADER_LEN;
+    stream->InFrame = 0;
+#endif // STREAM_FRAME
 #if   STREAM_MEM_IO == STREAM_MEM_IO_CUSTOM
     Stream_setMemIO(
         stream,
@@ -231,8 +420,26 @@ void Stream_init(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size) {
     );
 #elif STREAM_MUTEX == STREAM_MUTEX_DRIVER
     Stream_setMutex(stream, (Stream_MutexDriver*) 0);
+#elif STREAM_MUTEX == STREAM_MUTEX_BUILT_IN
+    // built-in lock always active, no driver to set
+    __IMPL_MUTEX_INIT(stream);
 #endif
 }
+#if STREAM_SIZE_POW2
+/**
+ * @brief initialize stream and report size that is not power of two,
+ * rejected stream initialized with zero size like Stream_init
+ *
+ * @param stream address of stream struct
+ * @param buffer address of byte buffer
+ * @param size size of buffer, must be power of two
+ * @return Stream_Result Stream_BadArgument if size is not power of two
+ */
+Stream_Result Stream_initPow2(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size) {
+    Stream_init(stream, buffer, size);
+    return STREAM_IS_POW2(size) ? Stream_Ok : Stream_BadArgument;
+}
+#endif // STREAM_SIZE_POW2
 /**
  * @brief initialize stream with a buffer that already have data in it
  *
@@ -242,7 +449,13 @@ void Stream_init(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size) {
  */
 void Stream_fromBuff(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size, Stream_LenType len) {
     Stream_init(stream, buffer, size);
-    stream->WPos = len;
+#if STREAM_SIZE_POW2
+    // size rejected, stream stay empty
+    if (stream->Size == 0) {
+        return;
+    }
+#endif // STREAM_SIZE_POW2
+    __setWPos(stream, len);
 }
 /**
  * @brief reset stream struct into default values
@@ -252,8 +465,75 @@ void Stream_fromBuff(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size,
 void Stream_deinit(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexDeInit(stream);
+#if STREAM_MIRRORED
+    if (stream->Mirrored) {
+        munmap(stream->Data, (size_t) stream->Size * 2);
+    }
+#endif // STREAM_MIRRORED
     __memSet(stream, stream, 0, sizeof(StreamBuffer));
 }
+#if STREAM_MIRRORED
+/**
+ * @brief initialize stream over mirrored buffer, same memory pages mapped twice back to back
+ * so Data[i] and Data[i + Size] are same byte and every readable or writable region is in row
+ * size round up to page size, buffer release in Stream_deinit
+ *
+ * @param stream address of stream struct
+ * @param size minimum size of buffer
+ * @return Stream_Result
+ */
+Stream_Result Stream_initMirrored(StreamBuffer* stream, Stream_LenType size) {
+    size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t mapSize = ((size_t) size + pageSize - 1) / pageSize * pageSize;
+    uint8_t* base;
+    int fd;
+
+#if STREAM_SIZE_POW2
+    while (mapSize & (mapSize - 1)) {
+        mapSize += mapSize & (~mapSize + 1);
+    }
+#endif // STREAM_SIZE_POW2
+    // check size fit in Stream_LenType
+    if (size <= 0 || (Stream_LenType) mapSize <= 0 || (size_t) (Stream_LenType) mapSize != mapSize) {
+        return Stream_MemoryError;
+    }
+
+    fd = (int) syscall(SYS_memfd_create, "stream", 0);
+    if (fd < 0) {
+        return Stream_MemoryError;
+    }
+    if (ftruncate(fd, (off_t) mapSize) != 0) {
+        close(fd);
+        return Stream_MemoryError;
+    }
+    // reserve address space for both copies, then map file over it twice
+    base = mmap(NULL, mapSize * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return Stream_MemoryError;
+    }
+    if (mmap(base, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        mmap(base + mapSize, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        munmap(base, mapSize * 2);
+        close(fd);
+        return Stream_MemoryError;
+    }
+    close(fd);
+
+    Stream_init(stream, base, (Stream_LenType) mapSize);
+    stream->Mirrored = 1;
+    return Stream_Ok;
+}
+/**
+ * @brief return stream is mirrored or not
+ *
+ * @param stream
+ * @return uint8_t
+ */
+uint8_t Stream_isMirrored(StreamBuffer* stream) {
+    return stream->Mirrored;
+}
+#endif // STREAM_MIRRORED
 #if STREAM_MEM_IO == STREAM_MEM_IO_CUSTOM
 /**
  * @brief Set custom memory io functions
@@ -377,7 +657,9 @@ Stream_MutexResult Stream_mutexDeInit(StreamBuffer* stream) {
 Stream_LenType Stream_availableReal(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType len = stream->Size * stream->Overflow + stream->WPos - stream->RPos;
+    Stream_LenType wpos = __getWPos(stream);
+    Stream_LenType rpos = __getRPos(stream);
+    Stream_LenType len = stream->Size * __isOverflow(stream, wpos, rpos) + wpos - rpos;
     __mutexUnlock(stream);
     return len;
 }
@@ -390,7 +672,9 @@ Stream_LenType Stream_availableReal(StreamBuffer* stream) {
 Stream_LenType Stream_spaceReal(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType len = stream->Size * !stream->Overflow + stream->RPos - stream->WPos;
+    Stream_LenType wpos = __getWPos(stream);
+    Stream_LenType rpos = __getRPos(stream);
+    Stream_LenType len = stream->Size * !__isOverflow(stream, wpos, rpos) + rpos - wpos - __spaceGap;
     __mutexUnlock(stream);
     return len;
 }
@@ -403,7 +687,9 @@ Stream_LenType Stream_spaceReal(StreamBuffer* stream) {
 uint8_t Stream_isEmpty(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexLock(stream);
-    uint8_t res = stream->RPos == stream->WPos && !stream->Overflow;
+    Stream_LenType wpos = __getWPos(stream);
+    Stream_LenType rpos = __getRPos(stream);
+    uint8_t res = rpos == wpos && !__isOverflow(stream, wpos, rpos);
     __mutexUnlock(stream);
     return res;
 }
@@ -415,11 +701,15 @@ uint8_t Stream_isEmpty(StreamBuffer* stream) {
  * @return uint8_t 0 -> Not Full, 1-> it's Full
  */
 uint8_t Stream_isFull(StreamBuffer* stream) {
+#if STREAM_SPSC
+    return Stream_spaceReal(stream) == 0;
+#else
     __mutexVarInit();
     __mutexLock(stream);
     uint8_t res = stream->RPos == stream->WPos && stream->Overflow;
     __mutexUnlock(stream);
     return res;
+#endif // STREAM_SPSC
 }
 /**
  * @brief reset stream
@@ -429,9 +719,15 @@ uint8_t Stream_isFull(StreamBuffer* stream) {
 void Stream_reset(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexLock(stream);
-    stream->RPos = 0;
-    stream->WPos = 0;
-    stream->Overflow = 0;
+    __setRPos(stream, 0);
+    __setWPos(stream, 0);
+    __setOverflow(stream, 0);
+#if STREAM_WRITE_RESERVE
+    stream->Reserved = 0;
+#endif // STREAM_WRITE_RESERVE
+#if STREAM_FRAME
+    stream->InFrame = 0;
+#endif // STREAM_FRAME
     __mutexUnlock(stream);
 }
 /**
@@ -442,9 +738,15 @@ void Stream_reset(StreamBuffer* stream) {
 void Stream_resetIO(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexLock(stream);
-    stream->RPos = 0;
-    stream->WPos = 0;
-    stream->Overflow = 0;
+    __setRPos(stream, 0);
+    __setWPos(stream, 0);
+    __setOverflow(stream, 0);
+#if STREAM_WRITE_RESERVE
+    stream->Reserved = 0;
+#endif // STREAM_WRITE_RESERVE
+#if STREAM_FRAME
+    stream->InFrame = 0;
+#endif // STREAM_FRAME
     stream->InReceive = 0;
     stream->InTransmit = 0;
     __mutexUnlock(stream);
@@ -498,7 +800,7 @@ uint8_t Stream_inTransmit(StreamBuffer* stream) {
  * @return Stream_LenType it's between 0 ~ Size
  */
 Stream_LenType Stream_getWritePos(StreamBuffer* stream) {
-    return stream->WPos;
+    return __getWPos(stream);
 }
 /**
  * @brief return Read Pos
@@ -507,7 +809,7 @@ Stream_LenType Stream_getWritePos(StreamBuffer* stream) {
  * @return Stream_LenType it's between 0 ~ Size
  */
 Stream_LenType Stream_getReadPos(StreamBuffer* stream) {
-    return stream->RPos;
+    return __getRPos(stream);
 }
 /**
  * @brief return number of bytes that it's in row in the ram
@@ -519,8 +821,11 @@ Stream_LenType Stream_getReadPos(StreamBuffer* stream) {
 Stream_LenType Stream_directAvailable(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType len = stream->Overflow ? stream->Size - stream->RPos :
-                                stream->WPos - stream->RPos;
+    Stream_LenType wpos = __getWPos(stream);
+    Stream_LenType rpos = __getRPos(stream);
+    Stream_LenType len = __isMirrored(stream) ? Stream_availableReal(stream) :
+                            __isOverflow(stream, wpos, rpos) ? stream->Size - rpos :
+                                wpos - rpos;
     __mutexUnlock(stream);
     return len;
 }
@@ -534,8 +839,11 @@ Stream_LenType Stream_directAvailable(StreamBuffer* stream) {
 Stream_LenType Stream_directSpace(StreamBuffer* stream) {
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType len = stream->Overflow ? stream->RPos - stream->WPos :
-                                stream->Size - stream->WPos;
+    Stream_LenType wpos = __getWPos(stream);
+    Stream_LenType rpos = __getRPos(stream);
+    Stream_LenType len = __isMirrored(stream) ? Stream_spaceReal(stream) :
+                            __isOverflow(stream, wpos, rpos) ? rpos - wpos - __spaceGap :
+                                stream->Size - wpos - (__spaceGap && rpos == 0);
     __mutexUnlock(stream);
     return len;
 }
@@ -552,13 +860,8 @@ Stream_LenType Stream_directAvailableAt(StreamBuffer* stream, Stream_LenType ind
     __mutexLock(stream);
     Stream_LenType len = Stream_availableReal(stream);
     Stream_LenType dirLen = Stream_directAvailable(stream);
-    if (len == dirLen) {
-        len = len - index;
-    }
-    else {
-        len = dirLen > index ? dirLen - index :
-                                stream->WPos - (index - dirLen);
-    }
+    // second segment starts from zero, so remain bytes are in row
+    len = dirLen > index ? dirLen - index : len - index;
     __mutexUnlock(stream);
     return len;
 }
@@ -575,13 +878,8 @@ Stream_LenType Stream_directSpaceAt(StreamBuffer* stream, Stream_LenType index)
     __mutexLock(stream);
     Stream_LenType len = Stream_spaceReal(stream);
     Stream_LenType dirLen = Stream_directSpace(stream);
-    if (len == dirLen) {
-        len = len - index;
-    }
-    else {
-        len = dirLen > index ? dirLen - index :
-                                stream->RPos - (index - dirLen);
-    }
+    // second segment starts from zero, so remain bytes are in row
+    len = dirLen > index ? dirLen - index : len - index;
     __mutexUnlock(stream);
     return len;
 }
@@ -592,7 +890,7 @@ Stream_LenType Stream_directSpaceAt(StreamBuffer* stream, Stream_LenType index)
  * @return uint8_t*
  */
 uint8_t* Stream_getWritePtr(StreamBuffer* stream) {
-    return &stream->Data[stream->WPos];
+    return &stream->Data[__getWPos(stream)];
 }
 /**
  * @brief get ptr to start of RPos in ram
@@ -601,15 +899,15 @@ uint8_t* Stream_getWritePtr(StreamBuffer* stream) {
  * @return uint8_t*
  */
 uint8_t* Stream_getReadPtr(StreamBuffer* stream) {
-    return &stream->Data[stream->RPos];
+    return &stream->Data[__getRPos(stream)];
 }
 uint8_t* Stream_getWritePtrAt(StreamBuffer* stream, Stream_LenType index) {
     __mutexVarInit();
     __mutexLock(stream);
-    index += stream->WPos;
+    index += __getWPos(stream);
 
     if (index >= stream->Size) {
-        index %= stream->Size;
+        index = __wrapIndex(stream, index);
     }
 
     __mutexUnlock(stream);
@@ -618,10 +916,10 @@ uint8_t* Stream_getWritePtrAt(StreamBuffer* stream, Stream_LenType index) {
 uint8_t* Stream_getReadPtrAt(StreamBuffer* stream, Stream_LenType index) {
     __mutexVarInit();
     __mutexLock(stream);
-    index += stream->RPos;
+    index += __getRPos(stream);
 
     if (index >= stream->Size) {
-        index %= stream->Size;
+        index = __wrapIndex(stream, index);
     }
 
     __mutexUnlock(stream);
@@ -651,7 +949,11 @@ uint8_t* Stream_getBuffer(StreamBuffer* stream) {
  * @return Stream_LenType
  */
 Stream_LenType Stream_getBufferSize(StreamBuffer* stream) {
+#if STREAM_BIP
+    return stream->Capacity;
+#else
     return stream->Size;
+#endif // STREAM_BIP
 }
 /**
  * @brief can use for ignore bytes, and move WPos index
@@ -664,12 +966,13 @@ Stream_Result Stream_moveWritePos(StreamBuffer* stream, Stream_LenType steps) {
     __checkSpace(stream, steps);
     __mutexVarInit();
     __mutexLock(stream);
+    Stream_LenType wpos = __getWPos(stream) + steps;
 
-    stream->WPos += steps;
-    if (stream->WPos >= stream->Size) {
-        stream->WPos %= stream->Size;
-        stream->Overflow = 1;
+    if (wpos >= stream->Size) {
+        wpos = __wrapIndex(stream, wpos);
+        __setOverflow(stream, 1);
     }
+    __setWPos(stream, wpos);
 
     __mutexUnlock(stream);
     return Stream_Ok;
@@ -685,12 +988,14 @@ Stream_Result Stream_moveReadPos(StreamBuffer* stream, Stream_LenType steps) {
     __checkAvailable(stream, steps);
     __mutexVarInit();
     __mutexLock(stream);
+    Stream_LenType rpos = __getRPos(stream) + steps;
 
-    stream->RPos += steps;
-    if (stream->RPos >= stream->Size) {
-        stream->RPos %= stream->Size;
-        stream->Overflow = 0;
+    if (rpos >= stream->Size) {
+        rpos = __wrapIndex(stream, rpos);
+        __setOverflow(stream, 0);
     }
+    __setRPos(stream, rpos);
+    __readTotal(stream, steps);
 
     __mutexUnlock(stream);
     return Stream_Ok;
@@ -705,14 +1010,15 @@ Stream_Result Stream_moveReadPos(StreamBuffer* stream, Stream_LenType steps) {
 void Stream_flipWrite(StreamBuffer* stream, Stream_LenType len) {
     __mutexVarInit();
     __mutexLock(stream);
-    stream->RPos = stream->WPos + len;
-    if (stream->RPos >= stream->Size) {
-        stream->RPos %= stream->Size;
-        stream->Overflow = 0;
+    Stream_LenType rpos = __getWPos(stream) + len + __spaceGap;
+    if (rpos >= stream->Size) {
+        rpos = __wrapIndex(stream, rpos);
+        __setOverflow(stream, 0);
     }
     else {
-        stream->Overflow = 1;
+        __setOverflow(stream, 1);
     }
+    __setRPos(stream, rpos);
     __mutexUnlock(stream);
 }
 #endif
@@ -726,14 +1032,15 @@ void Stream_flipWrite(StreamBuffer* stream, Stream_LenType len) {
 void Stream_flipRead(StreamBuffer* stream, Stream_LenType len) {
     __mutexVarInit();
     __mutexLock(stream);
-    stream->WPos = stream->RPos + len;
-    if (stream->WPos >= stream->Size) {
-        stream->WPos %= stream->Size;
-        stream->Overflow = 1;
+    Stream_LenType wpos = __getRPos(stream) + len;
+    if (wpos >= stream->Size) {
+        wpos = __wrapIndex(stream, wpos);
+        __setOverflow(stream, 1);
     }
     else {
-        stream->Overflow = 0;
+        __setOverflow(stream, 0);
     }
+    __setWPos(stream, wpos);
     __mutexUnlock(stream);
 }
 #endif
@@ -806,7 +1113,7 @@ void Stream_setWriteLimit(StreamBuffer* stream, Stream_LenType len) {
  * @return uint8_t true means limited
  */
 uint8_t    Stream_isWriteLimited(StreamBuffer* stream) {
-    return stream->WriteLimit >= 0;
+    return stream->WriteLimit != STREAM_NO_LIMIT;
 }
 /**
  * @brief return space available for write bytes respect to write limit
@@ -815,7 +1122,7 @@ uint8_t    Stream_isWriteLimited(StreamBuffer* stream) {
  * @return Stream_LenType
  */
 Stream_LenType Stream_spaceLimit(StreamBuffer* stream) {
-    return stream->WriteLimit >= 0 ? stream->WriteLimit : Stream_spaceReal(stream);
+    return stream->WriteLimit != STREAM_NO_LIMIT ? stream->WriteLimit : Stream_spaceReal(stream);
 }
 Stream_LenType Stream_getWriteLimit(StreamBuffer* stream) {
     return stream->WriteLimit;
@@ -845,7 +1152,7 @@ void Stream_setReadLimit(StreamBuffer* stream, Stream_LenType len) {
  * @return uint8_t true means it's limited
  */
 uint8_t Stream_isReadLimited(StreamBuffer* stream) {
-    return stream->ReadLimit >= 0;
+    return stream->ReadLimit != STREAM_NO_LIMIT;
 }
 /**
  * @brief retruna available bytes for read respect to read limit
@@ -854,7 +1161,7 @@ uint8_t Stream_isReadLimited(StreamBuffer* stream) {
  * @return Stream_LenType
  */
 Stream_LenType Stream_availableLimit(StreamBuffer* stream) {
-    return stream->ReadLimit >= 0 ? stream->ReadLimit : Stream_availableReal(stream);
+    return stream->ReadLimit != STREAM_NO_LIMIT ? stream->ReadLimit : Stream_availableReal(stream);
 }
 /**
  * @brief return read limit
@@ -876,8 +1183,8 @@ Stream_LenType Stream_getReadLimit(StreamBuffer* stream) {
 void Stream_getCursor(StreamBuffer* stream, Stream_Cursor* cursor) {
     __mutexVarInit();
     __mutexLock(stream);
-    cursor->WPos = stream->WPos;
-    cursor->RPos = stream->RPos;
+    cursor->WPos = __getWPos(stream);
+    cursor->RPos = __getRPos(stream);
     __mutexUnlock(stream);
 }
 /**
@@ -890,8 +1197,9 @@ void Stream_getCursor(StreamBuffer* stream, Stream_Cursor* cursor) {
 Stream_LenType Stream_getReadLen(StreamBuffer* stream, Stream_Cursor* cursor) {
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType len = cursor->RPos >= stream->RPos ? cursor->RPos - stream->RPos :
-                                            (stream->Size - cursor->RPos) + stream->RPos;
+    Stream_LenType rpos = __getRPos(stream);
+    Stream_LenType len = cursor->RPos >= rpos ? cursor->RPos - rpos :
+                                            (stream->Size - cursor->RPos) + rpos;
     __mutexUnlock(stream);
     return len;
 }
@@ -905,12 +1213,93 @@ Stream_LenType Stream_getReadLen(StreamBuffer* stream, Stream_Cursor* cursor) {
 Stream_LenType Stream_getWriteLen(StreamBuffer* stream, Stream_Cursor* cursor) {
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType len = cursor->WPos >= stream->WPos ? cursor->WPos - stream->WPos :
-                                            (stream->Size - cursor->WPos) + stream->WPos;
+    Stream_LenType wpos = __getWPos(stream);
+    Stream_LenType len = cursor->WPos >= wpos ? cursor->WPos - wpos :
+                                            (stream->Size - cursor->WPos) + wpos;
     __mutexUnlock(stream);
     return len;
 }
 #endif // STREAM_CURSOR
+#if STREAM_IO_VEC
+/**
+ * @brief fill vectors with one or two segments of buffer that cover a region,
+ * len limited to given total bytes
+ *
+ * @param vec
+ * @param ptr start of region
+ * @param dirLen bytes in row from ptr
+ * @param data start of buffer, second segment
+ * @param len length of region
+ * @return uint8_t number of segments
+ */
+static uint8_t Stream_fillVec(Stream_IoVec vec[2], uint8_t* ptr, Stream_LenType dirLen, uint8_t* data, Stream_LenType len) {
+    if (len <= 0) {
+        return 0;
+    }
+
+    vec[0].iov_base = ptr;
+    if (dirLen >= len) {
+        vec[0].iov_len = (size_t) len;
+        return 1;
+    }
+    vec[0].iov_len = (size_t) dirLen;
+    vec[1].iov_base = data;
+    vec[1].iov_len = (size_t) (len - dirLen);
+    return 2;
+}
+/**
+ * @brief return segments of available bytes from offset, use for writev or parse without copy,
+ * call Stream_commitRead after bytes consumed
+ *
+ * @param stream
+ * @param offset offset from RPos
+ * @param len maximum number of bytes, limited to available bytes
+ * @param vec
+ * @return uint8_t number of segments, 0 if there is no available bytes
+ */
+uint8_t Stream_getReadVec(StreamBuffer* stream, Stream_LenType offset, Stream_LenType len, Stream_IoVec vec[2]) {
+    Stream_LenType tmpLen;
+    uint8_t count = 0;
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    tmpLen = Stream_available(stream);
+    if (tmpLen > offset) {
+        tmpLen -= offset;
+        count = Stream_fillVec(vec, Stream_getReadPtrAt(stream, offset), Stream_directAvailableAt(stream, offset),
+                                stream->Data, len < tmpLen ? len : tmpLen);
+    }
+
+    __mutexUnlock(stream);
+    return count;
+}
+/**
+ * @brief return segments of space from offset, use for readv or fill without copy,
+ * call Stream_commitWrite after bytes filled
+ *
+ * @param stream
+ * @param offset offset from WPos
+ * @param len maximum number of bytes, limited to space
+ * @param vec
+ * @return uint8_t number of segments, 0 if there is no space
+ */
+uint8_t Stream_getWriteVec(StreamBuffer* stream, Stream_LenType offset, Stream_LenType len, Stream_IoVec vec[2]) {
+    Stream_LenType tmpLen;
+    uint8_t count = 0;
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    tmpLen = Stream_space(stream);
+    if (tmpLen > offset) {
+        tmpLen -= offset;
+        count = Stream_fillVec(vec, Stream_getWritePtrAt(stream, offset), Stream_directSpaceAt(stream, offset),
+                                stream->Data, len < tmpLen ? len : tmpLen);
+    }
+
+    __mutexUnlock(stream);
+    return count;
+}
+#endif // STREAM_IO_VEC
 /* ------------------------------------ General Write APIs ---------------------------------- */
 /**
  * @brief write byte array into stream
@@ -922,22 +1311,22 @@ Stream_LenType Stream_getWriteLen(StreamBuffer* stream, Stream_Cursor* cursor) {
  */
 Stream_Result Stream_writeBytes(StreamBuffer* stream, uint8_t* val, Stream_LenType len) {
     __checkZeroLen(stream, len);
-    __checkSpace(stream, len);
+    __checkSpaceTx(stream, len);
     __writeLimit(stream, len);
     __mutexVarInit();
-    __mutexLock(stream);
-    Stream_LenType wpos = stream->WPos;
+    __mutexLockWriteTx(stream);
+    Stream_LenType wpos = __getWPos(stream);
 
     if (wpos + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - wpos;
+        tmpLen = __segmentLen(stream, stream->Size - wpos, len);
         len -= tmpLen;
         __memCopy(stream, &stream->Data[wpos], val, tmpLen);
         val += tmpLen;
         // move WPos
-        wpos = 0;
-        stream->Overflow = 1;
+        wpos += tmpLen - stream->Size;
+        __setOverflow(stream, 1);
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -948,9 +1337,9 @@ Stream_Result Stream_writeBytes(StreamBuffer* stream, uint8_t* val, Stream_LenTy
 #if STREAM_CHECK_ZERO_LEN
     }
 #endif
-    stream->WPos = wpos;
+    __setWPos(stream, wpos);
 
-    __mutexUnlock(stream);
+    __mutexUnlockWriteTx(stream);
     return Stream_Ok;
 }
 #if STREAM_WRITE_REVERSE
@@ -964,21 +1353,21 @@ Stream_Result Stream_writeBytes(StreamBuffer* stream, uint8_t* val, Stream_LenTy
  */
 Stream_Result Stream_writeBytesReverse(StreamBuffer* stream, uint8_t* val, Stream_LenType len) {
     __checkZeroLen(stream, len);
-    __checkSpace(stream, len);
+    __checkSpaceTx(stream, len);
     __writeLimit(stream, len);
     __mutexVarInit();
-    __mutexLock(stream);
-    Stream_LenType wpos = stream->WPos;
+    __mutexLockWriteTx(stream);
+    Stream_LenType wpos = __getWPos(stream);
 
     if (wpos + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - wpos;
+        tmpLen = __segmentLen(stream, stream->Size - wpos, len);
         len -= tmpLen;
         __memCopyReverse(stream, &stream->Data[wpos], val + len, tmpLen);
         // move WPos
-        wpos = 0;
-        stream->Overflow = 1;
+        wpos += tmpLen - stream->Size;
+        __setOverflow(stream, 1);
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -989,9 +1378,9 @@ Stream_Result Stream_writeBytesReverse(StreamBuffer* stream, uint8_t* val, Strea
 #if STREAM_CHECK_ZERO_LEN
     }
 #endif
-    stream->WPos = wpos;
+    __setWPos(stream, wpos);
 
-    __mutexUnlock(stream);
+    __mutexUnlockWriteTx(stream);
     return Stream_Ok;
 }
 /**
@@ -1010,43 +1399,13 @@ Stream_Result Stream_write(StreamBuffer* stream, uint8_t* val, Stream_LenType le
 /**
  * @brief directly read from a stream and write to another
  *
- * @param stream
+ * @param out
  * @param in
  * @param len
  * @return Stream_Result
  */
 Stream_Result Stream_writeStream(StreamBuffer* out, StreamBuffer* in, Stream_LenType len) {
-    // check available space for write
-    __checkZeroLen(out, len);
-    __checkSpace(out, len);
-    __checkAvailable(in, len);
-    __writeLimit(out, len);
-    __mutexVarInit();
-    __mutexLock(out);
-    Stream_LenType wpos = out->WPos;
-
-    if (wpos + len >= out->Size) {
-        Stream_LenType tmpLen;
-        tmpLen = out->Size - wpos;
-        len -= tmpLen;
-        Stream_readBytes(in, &out->Data[wpos], tmpLen);
-        // move WPos
-        wpos = 0;
-        out->Overflow = 1;
-    }
-#if STREAM_CHECK_ZERO_LEN
-    if (len > 0) {
-#endif
-        Stream_readBytes(in, &out->Data[wpos], len);
-        // move WPos
-        wpos += len;
-#if STREAM_CHECK_ZERO_LEN
-    }
-#endif
-    out->WPos = wpos;
-
-    __mutexUnlock(out);
-    return Stream_Ok;
+    return Stream_transfer(out, in, len);
 }
 #endif // STREAM_WRITE_STREAM 
 #if STREAM_WRITE_PADDING
@@ -1064,18 +1423,17 @@ Stream_Result Stream_writePadding(StreamBuffer* stream, uint8_t val, Stream_LenT
     __writeLimit(stream, len);
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType wpos = stream->WPos;
+    Stream_LenType wpos = __getWPos(stream);
 
     if (wpos + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - wpos;
+        tmpLen = __segmentLen(stream, stream->Size - wpos, len);
         len -= tmpLen;
         __memSet(stream, &stream->Data[wpos], val, tmpLen);
-        val += tmpLen;
         // move WPos
-        wpos = 0;
-        stream->Overflow = 1;
+        wpos += tmpLen - stream->Size;
+        __setOverflow(stream, 1);
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -1086,7 +1444,7 @@ Stream_Result Stream_writePadding(StreamBuffer* stream, uint8_t val, Stream_LenT
 #if STREAM_CHECK_ZERO_LEN
     }
 #endif
-    stream->WPos = wpos;
+    __setWPos(stream, wpos);
 
     __mutexUnlock(stream);
     return Stream_Ok;
@@ -1103,22 +1461,23 @@ Stream_Result Stream_writePadding(StreamBuffer* stream, uint8_t val, Stream_LenT
  */
 Stream_Result Stream_readBytes(StreamBuffer* stream, uint8_t* val, Stream_LenType len) {
     __checkZeroLen(stream, len);
-    __checkAvailable(stream, len);
+    __checkAvailableTx(stream, len);
     __readLimit(stream, len);
+    __readTotal(stream, len);
     __mutexVarInit();
-    __mutexLock(stream);
-    Stream_LenType rpos = stream->RPos;
+    __mutexLockReadTx(stream);
+    Stream_LenType rpos = __getRPos(stream);
 
     if (rpos + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - rpos;
+        tmpLen = __segmentLen(stream, stream->Size - rpos, len);
         len -= tmpLen;
         __memCopy(stream, val, &stream->Data[rpos], tmpLen);
         val += tmpLen;
         // move RPos
-        rpos = 0;
-        stream->Overflow = 0;
+        rpos += tmpLen - stream->Size;
+        __setOverflow(stream, 0);
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -1129,29 +1488,30 @@ Stream_Result Stream_readBytes(StreamBuffer* stream, uint8_t* val, Stream_LenTyp
 #if STREAM_CHECK_ZERO_LEN
     }
 #endif
-    stream->RPos = rpos;
+    __setRPos(stream, rpos);
 
-    __mutexUnlock(stream);
+    __mutexUnlockReadTx(stream);
     return Stream_Ok;
 }
 #if STREAM_READ_REVERSE
 Stream_Result Stream_readBytesReverse(StreamBuffer* stream, uint8_t* val, Stream_LenType len) {
     __checkZeroLen(stream, len);
-    __checkAvailable(stream, len);
+    __checkAvailableTx(stream, len);
     __readLimit(stream, len);
+    __readTotal(stream, len);
     __mutexVarInit();
-    __mutexLock(stream);
-    Stream_LenType rpos = stream->RPos;
+    __mutexLockReadTx(stream);
+    Stream_LenType rpos = __getRPos(stream);
 
     if (rpos + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - rpos;
+        tmpLen = __segmentLen(stream, stream->Size - rpos, len);
         len -= tmpLen;
         __memCopyReverse(stream, val + len, &stream->Data[rpos], tmpLen);
         // move RPos
-        rpos = 0;
-        stream->Overflow = 0;
+        rpos += tmpLen - stream->Size;
+        __setOverflow(stream, 0);
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -1162,9 +1522,9 @@ Stream_Result Stream_readBytesReverse(StreamBuffer* stream, uint8_t* val, Stream
 #if STREAM_CHECK_ZERO_LEN
     }
 #endif
-    stream->RPos = rpos;
+    __setRPos(stream, rpos);
 
-    __mutexUnlock(stream);
+    __mutexUnlockReadTx(stream);
     return Stream_Ok;
 }
 /**
@@ -1178,40 +1538,98 @@ Stream_Result Stream_read(StreamBuffer* stream, uint8_t* val, Stream_LenType len
 }
 #endif // STREAM_READ_REVERSE
 #if STREAM_READ_STREAM
+/**
+ * @brief directly read from a stream and write to another
+ *
+ * @param in
+ * @param out
+ * @param len
+ * @return Stream_Result
+ */
 Stream_Result Stream_readStream(StreamBuffer* in, StreamBuffer* out, Stream_LenType len) {
-    __checkZeroLen(in, len);
-    __checkAvailable(in, len);
-    __checkSpace(out, len);
-    __readLimit(in, len);
+    return Stream_transfer(out, in, len);
+}
+#endif // STREAM_READ_STREAM
+#if STREAM_TRANSFER
+/**
+ * @brief move len bytes from in to out in single pass, both streams locked in address order,
+ * so transfers in opposite directions can not deadlock, bytes copied in at most three
+ * contiguous pieces and positions of both streams moved after copy
+ *
+ * @param out destination stream
+ * @param in source stream, can be same as out
+ * @param len
+ * @return Stream_Result Stream_NoSpace or Stream_NoAvailable if len is more than space of out or available of in
+ */
+Stream_Result Stream_transfer(StreamBuffer* out, StreamBuffer* in, Stream_LenType len) {
+    StreamBuffer* first = out < in ? out : in;
+    StreamBuffer* second = out < in ? in : out;
+    Stream_Result res = Stream_Ok;
+    __checkZeroLen(out, len);
     __mutexVarInit();
-    __mutexLock(in);
-    Stream_LenType rpos = in->RPos;
-
-    if (rpos + len >= in->Size) {
-        Stream_LenType tmpLen;
+    __mutexLock(first);
+    if (second != first) {
+        __mutexLock(second);
+    }
 
-        tmpLen = in->Size - rpos;
-        len -= tmpLen;
-        Stream_writeBytes(out, &in->Data[rpos], tmpLen);
-        // move RPos
-        rpos = 0;
-        in->Overflow = 0;
+    // both locks held, so space and available computed without taking them again
+    if (__spaceUnlocked(out) < len) {
+        res = Stream_NoSpace;
     }
-#if STREAM_CHECK_ZERO_LEN
-    if (len > 0) {
-#endif
-        Stream_writeBytes(out, &in->Data[rpos], len);
-        // move RPos
-        rpos += len;
-#if STREAM_CHECK_ZERO_LEN
+    else if (__availableUnlocked(in) < len) {
+        res = Stream_NoAvailable;
     }
-#endif
-    in->RPos = rpos;
+    else {
+        Stream_LenType wpos = __getWPos(out);
+        Stream_LenType rpos = __getRPos(in);
+        Stream_LenType remain = len;
+        Stream_LenType piece;
+        uint8_t wrapW = 0;
+        uint8_t wrapR = 0;
 
-    __mutexUnlock(in);
-    return Stream_Ok;
+        while (remain > 0) {
+            // largest piece that is contiguous in both streams
+            piece = remain;
+            if (!__isMirrored(out) && piece > out->Size - wpos) {
+                piece = out->Size - wpos;
+            }
+            if (!__isMirrored(in) && piece > in->Size - rpos) {
+                piece = in->Size - rpos;
+            }
+            __memCopy(out, &out->Data[wpos], &in->Data[rpos], piece);
+            remain -= piece;
+            wpos += piece;
+            rpos += piece;
+            if (wpos >= out->Size) {
+                wpos -= out->Size;
+                wrapW = 1;
+            }
+            if (rpos >= in->Size) {
+                rpos -= in->Size;
+                wrapR = 1;
+            }
+        }
+
+        __writeLimit(out, len);
+        __readLimit(in, len);
+        __readTotal(in, len);
+        if (wrapW) {
+            __setOverflow(out, 1);
+        }
+        __setWPos(out, wpos);
+        if (wrapR) {
+            __setOverflow(in, 0);
+        }
+        __setRPos(in, rpos);
+    }
+
+    if (second != first) {
+        __mutexUnlock(second);
+    }
+    __mutexUnlock(first);
+    return res;
 }
-#endif
+#endif // STREAM_TRANSFER
 #if STREAM_READ_VALUE
 /**
  * @brief read value from buffer based on byte order
@@ -1233,16 +1651,16 @@ Stream_Result Stream_getBytesAt(StreamBuffer* stream, Stream_LenType index, uint
     __mutexVarInit();
     __mutexLock(stream);
 
-    index = (stream->RPos + index) % stream->Size;
+    index = __wrapIndex(stream, __getRPos(stream) + index);
 
     if (index + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - index;
+        tmpLen = __segmentLen(stream, stream->Size - index, len);
         len -= tmpLen;
         __memCopy(stream, val, &stream->Data[index], tmpLen);
         val += tmpLen;
-        index = 0;
+        index += tmpLen - stream->Size;
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -1263,15 +1681,15 @@ Stream_Result Stream_getBytesReverseAt(StreamBuffer* stream, Stream_LenType inde
     __mutexVarInit();
     __mutexLock(stream);
 
-    index = (stream->RPos + index) % stream->Size;
+    index = __wrapIndex(stream, __getRPos(stream) + index);
 
     if (index + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - index;
+        tmpLen = __segmentLen(stream, stream->Size - index, len);
         len -= tmpLen;
         __memCopyReverse(stream, val + len, &stream->Data[index], tmpLen);
-        index = 0;
+        index += tmpLen - stream->Size;
     }
 
 #if STREAM_CHECK_ZERO_LEN
@@ -1296,36 +1714,152 @@ Stream_Value  Stream_getValueAt(StreamBuffer* stream, Stream_LenType index, Stre
     return val;
 }
 #endif // STREAM_GET_AT_VALUE
+/* ------------------------------------ Array Helpers ---------------------------------- */
+#if STREAM_WRITE_ARRAY || STREAM_READ_ARRAY || STREAM_GET_AT_ARRAY || STREAM_SET_AT_ARRAY
+#if STREAM_MEM_IO != STREAM_MEM_IO_DEFAULT
+/**
+ * @brief copy array of items and swap bytes of each item with custom copyReverse function
+ *
+ * @param stream
+ * @param dest
+ * @param src
+ * @param itemLen size of each item
+ * @param len number of items
+ */
+static void Stream_memSwapCopy(StreamBuffer* stream, uint8_t* dest, const uint8_t* src, Stream_LenType itemLen, Stream_LenType len) {
+    while (len-- > 0) {
+        __memCopyReverse(stream, dest, src, itemLen);
+        dest += itemLen;
+        src += itemLen;
+    }
+}
+#endif // STREAM_MEM_IO != STREAM_MEM_IO_DEFAULT
+/**
+ * @brief copy items in row between stream buffer and user buffer
+ *
+ * @param stream
+ * @param buf address in stream buffer
+ * @param val user buffer
+ * @param itemLen size of each item
+ * @param len number of items
+ * @param write 1 means copy val into buf, 0 means copy buf into val
+ * @param reverse swap bytes of each item
+ */
+static void Stream_copyItems(StreamBuffer* stream, uint8_t* buf, uint8_t* val, Stream_LenType itemLen, Stream_LenType len, uint8_t write, uint8_t reverse) {
+    uint8_t* dest = write ? buf : val;
+    uint8_t* src = write ? val : buf;
+
+    if (reverse && itemLen > 1) {
+        __memSwapCopy(stream, dest, src, itemLen, len);
+    }
+    else {
+        __memCopy(stream, dest, src, itemLen * len);
+    }
+}
+/**
+ * @brief copy array between stream buffer and user buffer in at most two segments,
+ * start from index of Data and wrap at end of buffer, caller must lock stream and check len
+ *
+ * @param stream
+ * @param index start index in stream Data
+ * @param val user buffer
+ * @param itemLen size of each item
+ * @param len number of items
+ * @param write 1 means copy val into stream, 0 means copy stream into val
+ * @param reverse swap bytes of each item
+ */
+static void Stream_copyArray(StreamBuffer* stream, Stream_LenType index, uint8_t* val, Stream_LenType itemLen, Stream_LenType len, uint8_t write, uint8_t reverse) {
+    Stream_LenType total = itemLen * len;
+
+    if (index + total >= stream->Size) {
+        Stream_LenType tmpLen;
+        Stream_LenType items;
+        Stream_LenType remain;
+
+        tmpLen = __segmentLen(stream, stream->Size - index, total);
+        items = tmpLen / itemLen;
+        remain = tmpLen - items * itemLen;
+        Stream_copyItems(stream, &stream->Data[index], val, itemLen, items, write, reverse);
+        val += items * itemLen;
+        len -= items;
+        index += items * itemLen;
+        if (remain > 0) {
+            // item straddle end of buffer, copy it in two parts
+            uint8_t* buf = &stream->Data[index];
+            if (reverse) {
+                if (write) {
+                    __memCopyReverse(stream, buf, val + itemLen - remain, remain);
+                    __memCopyReverse(stream, stream->Data, val, itemLen - remain);
+                }
+                else {
+                    __memCopyReverse(stream, val + itemLen - remain, buf, remain);
+                    __memCopyReverse(stream, val, stream->Data, itemLen - remain);
+                }
+            }
+            else {
+                if (write) {
+                    __memCopy(stream, buf, val, remain);
+                    __memCopy(stream, stream->Data, val + remain, itemLen - remain);
+                }
+                else {
+                    __memCopy(stream, val, buf, remain);
+                    __memCopy(stream, val + remain, stream->Data, itemLen - remain);
+                }
+            }
+            val += itemLen;
+            len--;
+            index = itemLen - remain;
+        }
+        else {
+            index -= stream->Size;
+        }
+    }
+#if STREAM_CHECK_ZERO_LEN
+    if (len > 0) {
+#endif
+        Stream_copyItems(stream, &stream->Data[index], val, itemLen, len, write, reverse);
+#if STREAM_CHECK_ZERO_LEN
+    }
+#endif
+}
+#endif
 /* ------------------------------------ GetAt Value Array APIs ---------------------------------- */
 #if STREAM_GET_AT_ARRAY
 Stream_Result Stream_getArrayAt(StreamBuffer* stream, Stream_LenType index, void* val, Stream_LenType itemLen, Stream_LenType len) {
-    Stream_Result result;
     __checkZeroLenArray(stream, len, itemLen);
     __checkAvailable(stream, len * itemLen + index);
+    __mutexVarInit();
+    __mutexLock(stream);
 
-    while (len-- > 0) {
-        if ((result = Stream_getAt(stream, index, (uint8_t*) val, itemLen)) != Stream_Ok) {
-            return result;
-        }
-        val = (uint8_t*) val + itemLen;
-        index += itemLen;
-    }
+    index = __wrapIndex(stream, __getRPos(stream) + index);
+    Stream_copyArray(stream, index, (uint8_t*) val, itemLen, len, 0, __getReverse(stream));
+
+    __mutexUnlock(stream);
     return Stream_Ok;
 }
 #endif // STREAM_GET_AT_ARRAY
 /* ------------------------------------ Write Value Array APIs ---------------------------------- */
 #if STREAM_WRITE_ARRAY
 Stream_Result Stream_writeArray(StreamBuffer* stream, void* val, Stream_LenType itemLen, Stream_LenType len) {
-    Stream_Result result;
     __checkZeroLenArray(stream, len, itemLen);
     __checkSpace(stream, len * itemLen);
+    __writeLimit(stream, len * itemLen);
+    __mutexVarInit();
+    __mutexLock(stream);
+    Stream_LenType wpos = __getWPos(stream);
 
-    while (len-- > 0) {
-        if ((result = Stream_write(stream, (uint8_t*) val, itemLen)) != Stream_Ok) {
-            return result;
-        }
-        val = (uint8_t*) val + itemLen;
+    Stream_copyArray(stream, wpos, (uint8_t*) val, itemLen, len, 1, __writeReverse(stream));
+    // move WPos
+    if (wpos + len * itemLen >= stream->Size) {
+        wpos = wpos + len * itemLen - stream->Size;
+        __setOverflow(stream, 1);
+    }
+    else {
+        wpos += len * itemLen;
     }
+    __setWPos(stream, wpos);
+
+    __mutexUnlock(stream);
     return Stream_Ok;
 }
 #endif
@@ -1337,16 +1871,16 @@ Stream_Result Stream_setBytesAt(StreamBuffer* stream, Stream_LenType index, uint
     __mutexVarInit();
     __mutexLock(stream);
 
-    index = (stream->RPos + index) % stream->Size;
+    index = __wrapIndex(stream, __getRPos(stream) + index);
 
     if (index + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - index;
+        tmpLen = __segmentLen(stream, stream->Size - index, len);
         len -= tmpLen;
         __memCopy(stream, &stream->Data[index], val, tmpLen);
         val += tmpLen;
-        index = (index + tmpLen) % stream->Size;
+        index = __wrapIndex(stream, index + tmpLen);
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -1366,15 +1900,15 @@ Stream_Result   Stream_setBytesReverseAt(StreamBuffer* stream, Stream_LenType in
     __mutexVarInit();
     __mutexLock(stream);
 
-    index = (stream->RPos + index) % stream->Size;
+    index = __wrapIndex(stream, __getRPos(stream) + index);
 
     if (index + len >= stream->Size) {
         Stream_LenType tmpLen;
 
-        tmpLen = stream->Size - index;
+        tmpLen = __segmentLen(stream, stream->Size - index, len);
         len -= tmpLen;
         __memCopyReverse(stream, &stream->Data[index], val + len, tmpLen);
-        index = 0;
+        index += tmpLen - stream->Size;
     }
 #if STREAM_CHECK_ZERO_LEN
     if (len > 0) {
@@ -1395,45 +1929,695 @@ Stream_Result Stream_setAt(StreamBuffer* stream, Stream_LenType index, uint8_t*
 /* ------------------------------------ SetAt Value Array APIs ---------------------------------- */
 #if STREAM_SET_AT_ARRAY
 Stream_Result Stream_setArrayAt(StreamBuffer* stream, Stream_LenType index, void* val, Stream_LenType itemLen, Stream_LenType len) {
-    Stream_Result result;
     __checkZeroLenArray(stream, len, itemLen);
-    __checkSpace(stream, len * itemLen + index);
+    __checkAvailable(stream, len * itemLen + index);
+    __mutexVarInit();
+    __mutexLock(stream);
 
-    while (len-- > 0) {
-        if ((result = Stream_setAt(stream, index, (uint8_t*) val, itemLen)) != Stream_Ok) {
-            return result;
-        }
-        val = (uint8_t*) val + itemLen;
-        index += itemLen;
-    }
+    index = __wrapIndex(stream, __getRPos(stream) + index);
+    Stream_copyArray(stream, index, (uint8_t*) val, itemLen, len, 1, __setReverse(stream));
+
+    __mutexUnlock(stream);
     return Stream_Ok;
 }
 #endif // STREAM_SET_AT_ARRAY
 /* ------------------------------------ Read Value Array APIs ----------------------------------- */
+#if STREAM_READ_ARRAY
 Stream_Result Stream_readArray(StreamBuffer* stream, void* val, Stream_LenType itemLen, Stream_LenType len) {
-    Stream_Result result;
     __checkZeroLenArray(stream, len, itemLen);
     __checkAvailable(stream, len * itemLen);
+    __readLimit(stream, len * itemLen);
+    __readTotal(stream, len * itemLen);
+    __mutexVarInit();
+    __mutexLock(stream);
+    Stream_LenType rpos = __getRPos(stream);
 
-    while (len-- > 0) {
-        if ((result = Stream_read(stream, (uint8_t*) val, itemLen)) != Stream_Ok) {
-            return result;
-        }
-        val = (uint8_t*) val + itemLen;
+    Stream_copyArray(stream, rpos, (uint8_t*) val, itemLen, len, 0, __readReverse(stream));
+    // move RPos
+    if (rpos + len * itemLen >= stream->Size) {
+        rpos = rpos + len * itemLen - stream->Size;
+        __setOverflow(stream, 0);
+    }
+    else {
+        rpos += len * itemLen;
     }
+    __setRPos(stream, rpos);
+
+    __mutexUnlock(stream);
     return Stream_Ok;
 }
-#if STREAM_WRITE_LOCK
+#endif // STREAM_READ_ARRAY
+/* ------------------------------------ Packed Array APIs ----------------------------------- */
+#if STREAM_WRITE_ARRAY_PACKED || STREAM_READ_ARRAY_PACKED
+// each value take 1 to 4 bytes, len - 1 stored in 2 bits of control byte, 4 values per control byte
+#define __packedLen(VAL)                            ((VAL) < 0x100UL ? 1 : (VAL) < 0x10000UL ? 2 : (VAL) < 0x1000000UL ? 3 : 4)
+#define __packedGroupLen(CTRL)                      (((CTRL) & 3) + (((CTRL) >> 2) & 3) + (((CTRL) >> 4) & 3) + ((CTRL) >> 6) + 4)
+// values stored in little endian
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    #define __storeUInt32LE(P, VAL)                 memcpy((P), &(VAL), sizeof(uint32_t))
+    #define __loadUInt32LE(P, VAL)                  memcpy(&(VAL), (P), sizeof(uint32_t))
+#else
+    #define __storeUInt32LE(P, VAL)                 (P)[0] = (uint8_t) (VAL); (P)[1] = (uint8_t) ((VAL) >> 8); \
+                                                    (P)[2] = (uint8_t) ((VAL) >> 16); (P)[3] = (uint8_t) ((VAL) >> 24)
+    #define __loadUInt32LE(P, VAL)                  (VAL) = (uint32_t) (P)[0] | (uint32_t) (P)[1] << 8 | \
+                                                    (uint32_t) (P)[2] << 16 | (uint32_t) (P)[3] << 24
+#endif
+// bytes in row from position, mirrored buffer is mapped twice
+#define __packedRow(S, POS)                         (__isMirrored(S) ? 2 * (S)->Size - (POS) : (S)->Size - (POS))
+#endif // STREAM_WRITE_ARRAY_PACKED || STREAM_READ_ARRAY_PACKED
+#if STREAM_WRITE_ARRAY_PACKED
 /**
- * @brief lock the stream for writing
+ * @brief write array of uint32 in stream-vbyte layout, (len + 3) / 4 control bytes
+ * followed by 1 to 4 little endian bytes per value, read with Stream_readUInt32ArrayPacked
  *
  * @param stream
+ * @param val
+ * @param len number of values
  * @return Stream_Result
  */
-Stream_Result Stream_lockWrite(StreamBuffer* stream, StreamBuffer* lock, Stream_LenType len) {
+Stream_Result Stream_writeUInt32ArrayPacked(StreamBuffer* stream, const uint32_t* val, Stream_LenType len) {
+    Stream_LenType ctrlLen = (len + 3) >> 2;
+    Stream_LenType dataLen = 0;
+    Stream_LenType total;
+    Stream_LenType space;
+    Stream_LenType pos;
+    Stream_LenType row;
+    Stream_LenType i;
+    uint32_t tmp;
+    uint8_t ctrl;
+    uint8_t n;
+    uint8_t j;
+
+    __checkZeroLen(stream, len);
     __mutexVarInit();
     __mutexLock(stream);
-    Stream_LenType space = Stream_space(stream);
+    space = __spaceUnlocked(stream);
+    if (space < ctrlLen + len) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    // control bytes go to free space, nothing published until WPos move
+    pos = __getWPos(stream);
+    for (i = 0; i < len; i += 4) {
+        ctrl = 0;
+        for (j = 0; j < 4 && i + j < len; j++) {
+            n = __packedLen(val[i + j]);
+            ctrl |= (n - 1) << (j * 2);
+            dataLen += n;
+        }
+        stream->Data[pos] = ctrl;
+        if (++pos >= stream->Size) {
+            pos = 0;
+        }
+    }
+    total = ctrlLen + dataLen;
+    if (space < total) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    // first pass store whole 4 bytes while they stay in row and in data region, second pass after wrap
+    row = __packedRow(stream, pos);
+    for (i = 0; i < len; i++) {
+        tmp = val[i];
+        n = __packedLen(tmp);
+        if (row >= 4 && dataLen >= 4) {
+            __storeUInt32LE(&stream->Data[pos], tmp);
+            pos += n;
+            row -= n;
+        }
+        else {
+            for (j = 0; j < n; j++) {
+                stream->Data[pos] = (uint8_t) (tmp >> (j * 8));
+                if (++pos >= stream->Size && !__isMirrored(stream)) {
+                    pos = 0;
+                }
+            }
+            row = __packedRow(stream, pos);
+        }
+        dataLen -= n;
+        if (row <= 0) {
+            pos = 0;
+            row = __packedRow(stream, pos);
+        }
+    }
+    Stream_moveWritePos(stream, total);
+    __writeLimit(stream, total);
+
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+#endif // STREAM_WRITE_ARRAY_PACKED
+#if STREAM_READ_ARRAY_PACKED
+#if __STREAM_SIMD_X86
+// pshufb masks that spread 4 packed values of control byte into 4 uint32, 0xFF clear byte
+#define __PL(C, J)                                  ((((C) >> ((J) * 2)) & 3) + 1)
+#define __PO(C, J)                                  ((J) > 0 ? __PL(C, 0) : 0) + ((J) > 1 ? __PL(C, 1) : 0) + ((J) > 2 ? __PL(C, 2) : 0)
+#define __PB(C, J, B)                               ((B) < __PL(C, J) ? __PO(C, J) + (B) : 0xFF)
+#define __PV(C, J)                                  __PB(C, J, 0), __PB(C, J, 1), __PB(C, J, 2), __PB(C, J, 3)
+#define __PM(C)                                     { __PV(C, 0), __PV(C, 1), __PV(C, 2), __PV(C, 3) }
+#define __PM4(C)                                    __PM(C), __PM((C) + 1), __PM((C) + 2), __PM((C) + 3)
+#define __PM16(C)                                   __PM4(C), __PM4((C) + 4), __PM4((C) + 8), __PM4((C) + 12)
+#define __PM64(C)                                   __PM16(C), __PM16((C) + 16), __PM16((C) + 32), __PM16((C) + 48)
+static const uint8_t PACKED_SHUFFLE[256][16] = {
+    __PM64(0), __PM64(64), __PM64(128), __PM64(192),
+};
+/**
+ * @brief decode groups of 4 values while 16 bytes can load in row
+ *
+ * @param ctrl control bytes
+ * @param data packed values
+ * @param out
+ * @param groups maximum number of control bytes
+ * @param row bytes in row from data
+ * @param used return number of consumed data bytes
+ * @return Stream_LenType number of decoded groups
+ */
+__attribute__((target("ssse3")))
+static Stream_LenType unpackSsse3(const uint8_t* ctrl, const uint8_t* data, uint32_t* out, Stream_LenType groups, Stream_LenType row, Stream_LenType* used) {
+    Stream_LenType n = 0;
+    Stream_LenType g;
+
+    for (g = 0; g < groups && row - n >= 16; g++) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (data + n));
+        __m128i mask = _mm_loadu_si128((const __m128i*) PACKED_SHUFFLE[ctrl[g]]);
+        _mm_storeu_si128((__m128i*) (out + (g << 2)), _mm_shuffle_epi8(v, mask));
+        n += __packedGroupLen(ctrl[g]);
+    }
+    *used = n;
+    return g;
+}
+#endif // __STREAM_SIMD_X86
+/**
+ * @brief read array of uint32 written by Stream_writeUInt32ArrayPacked,
+ * nothing consumed if whole array is not available
+ *
+ * @param stream
+ * @param val
+ * @param len number of values
+ * @return Stream_Result
+ */
+Stream_Result Stream_readUInt32ArrayPacked(StreamBuffer* stream, uint32_t* val, Stream_LenType len) {
+    static const uint32_t MASK[4] = { 0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF };
+    Stream_LenType ctrlLen = (len + 3) >> 2;
+    Stream_LenType dataLen = 0;
+    Stream_LenType available;
+    Stream_LenType ctrlPos;
+    Stream_LenType pos;
+    Stream_LenType row;
+    Stream_LenType i;
+    uint32_t tmp;
+    uint8_t ctrl;
+    uint8_t n;
+    uint8_t j;
+#if __STREAM_SIMD_X86
+    uint8_t simd = __builtin_cpu_supports("ssse3") != 0;
+    Stream_LenType groups;
+    Stream_LenType used;
+#endif
+
+    __checkZeroLen(stream, len);
+    __mutexVarInit();
+    __mutexLock(stream);
+    available = __availableUnlocked(stream);
+    if (available < ctrlLen + len) {
+        __mutexUnlock(stream);
+        return Stream_NoAvailable;
+    }
+    ctrlPos = __getRPos(stream);
+    pos = ctrlPos;
+    for (i = 0; i < ctrlLen; i++) {
+        dataLen += __packedGroupLen(stream->Data[pos]);
+        if (++pos >= stream->Size) {
+            pos = 0;
+        }
+    }
+    // unused fields of last control byte are zero and counted as one byte
+    dataLen -= (ctrlLen << 2) - len;
+    if (available < ctrlLen + dataLen) {
+        __mutexUnlock(stream);
+        return Stream_NoAvailable;
+    }
+
+    row = __packedRow(stream, pos);
+    for (i = 0; i < len;) {
+#if __STREAM_SIMD_X86
+        if (simd && row >= 16 && len - i >= 4) {
+            groups = __packedRow(stream, ctrlPos);
+            if (groups > ((len - i) >> 2)) {
+                groups = (len - i) >> 2;
+            }
+            groups = unpackSsse3(&stream->Data[ctrlPos], &stream->Data[pos], &val[i], groups, row, &used);
+            i += groups << 2;
+            ctrlPos += groups;
+            if (ctrlPos >= stream->Size) {
+                ctrlPos -= stream->Size;
+            }
+            pos += used;
+            row -= used;
+            if (row <= 0) {
+                pos = 0;
+                row = __packedRow(stream, pos);
+            }
+            if (i >= len) {
+                break;
+            }
+        }
+#endif // __STREAM_SIMD_X86
+        ctrl = stream->Data[ctrlPos];
+        if (++ctrlPos >= stream->Size) {
+            ctrlPos = 0;
+        }
+        for (j = 0; j < 4 && i < len; j++, i++) {
+            n = (ctrl >> (j * 2)) & 3;
+            if (row >= 4) {
+                __loadUInt32LE(&stream->Data[pos], tmp);
+                tmp &= MASK[n];
+                pos += n + 1;
+                row -= n + 1;
+            }
+            else {
+                // value wrap around end of buffer
+                tmp = 0;
+                for (n = 0; n <= ((ctrl >> (j * 2)) & 3); n++) {
+                    tmp |= (uint32_t) stream->Data[pos] << (n * 8);
+                    if (++pos >= stream->Size) {
+                        pos = 0;
+                    }
+                }
+                row = __packedRow(stream, pos);
+            }
+            if (row <= 0) {
+                pos = 0;
+                row = __packedRow(stream, pos);
+            }
+            val[i] = tmp;
+        }
+    }
+    Stream_moveReadPos(stream, ctrlLen + dataLen);
+    __readLimit(stream, ctrlLen + dataLen);
+
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+#endif // STREAM_READ_ARRAY_PACKED
+#if STREAM_WRITE_RESERVE
+/**
+ * @brief reserve len bytes in one contiguous region at write position,
+ * caller write in place then call Stream_commit with used bytes,
+ * new reserve replace previous one that not committed
+ *
+ * @param stream
+ * @param len number of bytes to reserve
+ * @param ptr return address of reserved region, NULL on failure
+ * @return Stream_Result Stream_NoSpace if space is less than len,
+ *  Stream_NoContiguous if space is enough but wrap around end of buffer,
+ *  in STREAM_BIP mode only if neither tail nor start of buffer can hold len bytes
+ */
+Stream_Result Stream_reserve(StreamBuffer* stream, Stream_LenType len, uint8_t** ptr) {
+    *ptr = (uint8_t*) 0;
+    __checkZeroLen(stream, len);
+    __mutexVarInit();
+    __mutexLock(stream);
+    Stream_LenType wpos = __getWPos(stream);
+    Stream_LenType rpos = __getRPos(stream);
+
+    if (__spaceUnlocked(stream) < len) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    // same as Stream_directSpace
+    if (!__isMirrored(stream) &&
+        (__isOverflow(stream, wpos, rpos) ? rpos - wpos - __spaceGap : stream->Size - wpos - (__spaceGap && rpos == 0)) < len) {
+#if STREAM_BIP
+        if (wpos == rpos) {
+            // stream is empty, restart both regions from start of buffer
+            __setRPos(stream, 0);
+            wpos = 0;
+        }
+        else if (!__isOverflow(stream, wpos, rpos) && rpos >= len) {
+            // skip short tail, record watermark so readers wrap at end of data
+            stream->Size = wpos;
+            __setOverflow(stream, 1);
+            wpos = 0;
+        }
+        else {
+            __mutexUnlock(stream);
+            return Stream_NoContiguous;
+        }
+        __setWPos(stream, wpos);
+#else
+        __mutexUnlock(stream);
+        return Stream_NoContiguous;
+#endif // STREAM_BIP
+    }
+    *ptr = &stream->Data[wpos];
+    stream->Reserved = len;
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+/**
+ * @brief commit len bytes of reserved region and move write position, rest of reservation released
+ *
+ * @param stream
+ * @param len number of bytes written in reserved region, can be zero
+ * @return Stream_Result Stream_NoSpace if len is more than reserved bytes
+ */
+Stream_Result Stream_commit(StreamBuffer* stream, Stream_LenType len) {
+    if (len > stream->Reserved) {
+        return Stream_NoSpace;
+    }
+    // space already checked in Stream_reserve
+    __writeLimit(stream, len);
+    __mutexVarInit();
+    __mutexLock(stream);
+    Stream_LenType wpos = __getWPos(stream) + len;
+
+    if (wpos >= stream->Size) {
+        wpos = __wrapIndex(stream, wpos);
+        __setOverflow(stream, 1);
+    }
+    __setWPos(stream, wpos);
+    stream->Reserved = 0;
+
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+#endif // STREAM_WRITE_RESERVE
+#if STREAM_FRAME
+/**
+ * @brief encode frame header in stream byte order
+ *
+ * @param stream
+ * @param header output, FrameHeader bytes
+ * @param len payload length
+ */
+static void Stream_frameEncode(StreamBuffer* stream, uint8_t* header, uint32_t len) {
+    uint8_t width = stream->FrameHeader;
+    uint8_t i;
+
+    for (i = 0; i < width; i++) {
+#if STREAM_BYTE_ORDER
+        header[stream->Order == ByteOrder_BigEndian ? width - 1 - i : i] = (uint8_t) (len >> (i * 8));
+#else
+        header[i] = (uint8_t) (len >> (i * 8));
+#endif
+    }
+}
+/**
+ * @brief decode frame header that start at index of buffer, header can wrap around end of buffer
+ *
+ * @param stream
+ * @param index position of header in buffer
+ * @return uint32_t payload length
+ */
+static uint32_t Stream_frameDecode(StreamBuffer* stream, Stream_LenType index) {
+    uint8_t width = stream->FrameHeader;
+    uint32_t len = 0;
+    uint8_t i;
+
+    for (i = 0; i < width; i++) {
+#if STREAM_BYTE_ORDER
+        len |= (uint32_t) stream->Data[index] << ((stream->Order == ByteOrder_BigEndian ? width - 1 - i : i) * 8);
+#else
+        len |= (uint32_t) stream->Data[index] << (i * 8);
+#endif
+        if (++index >= stream->Size) {
+            index = 0;
+        }
+    }
+    return len;
+}
+/**
+ * @brief find complete frame at offset from RPos, caller must hold lock
+ *
+ * @param stream
+ * @param offset offset of frame header from RPos
+ * @param vec segments of payload, second one is empty if payload not wrap
+ * @param frameLen return length of frame with header
+ * @return Stream_Result Stream_NoAvailable if frame is not complete,
+ *  Stream_FrameTooLong if frame can never fit in buffer
+ */
+static Stream_Result Stream_frameAt(StreamBuffer* stream, Stream_LenType offset, Stream_IoVec vec[2], Stream_LenType* frameLen) {
+    Stream_LenType len = __frameAvailableUnlocked(stream) - offset;
+    uint32_t payload;
+
+    if (len < stream->FrameHeader) {
+        return Stream_NoAvailable;
+    }
+    len -= stream->FrameHeader;
+    payload = Stream_frameDecode(stream, __wrapIndex(stream, __getRPos(stream) + offset));
+    if (payload > (uint32_t) (Stream_getBufferSize(stream) - stream->FrameHeader)) {
+        return Stream_FrameTooLong;
+    }
+    if (payload > (uint32_t) len) {
+        return Stream_NoAvailable;
+    }
+
+    vec[0].iov_base = (void*) 0;
+    vec[0].iov_len = 0;
+    vec[1].iov_base = (void*) 0;
+    vec[1].iov_len = 0;
+    Stream_getReadVec(stream, offset + stream->FrameHeader, (Stream_LenType) payload, vec);
+    *frameLen = stream->FrameHeader + (Stream_LenType) payload;
+    return Stream_Ok;
+}
+/**
+ * @brief set width of frame header, header hold payload length
+ *
+ * @param stream
+ * @param len header width in bytes, 1, 2 or 4
+ * @return Stream_Result Stream_InFrame if a frame is open, Stream_BadArgument if len is invalid
+ */
+Stream_Result Stream_setFrameHeader(StreamBuffer* stream, uint8_t len) {
+    if (len != 1 && len != 2 && len != 4) {
+        return Stream_BadArgument;
+    }
+    if (stream->InFrame) {
+        return Stream_InFrame;
+    }
+    stream->FrameHeader = len;
+    return Stream_Ok;
+}
+/**
+ * @brief write header and payload as one frame, readers see whole frame or nothing
+ *
+ * @param stream
+ * @param val payload
+ * @param len payload length, can be zero
+ * @return Stream_Result
+ */
+Stream_Result Stream_writeFrame(StreamBuffer* stream, uint8_t* val, Stream_LenType len) {
+    uint8_t header[4];
+    Stream_Result res;
+
+    if ((uint32_t) len > __frameMaxLen(stream->FrameHeader)) {
+        return Stream_FrameTooLong;
+    }
+    __mutexVarInit();
+    __mutexLock(stream);
+    if (stream->InFrame) {
+        __mutexUnlock(stream);
+        return Stream_InFrame;
+    }
+    if (__spaceUnlocked(stream) < stream->FrameHeader + len) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+
+    Stream_frameEncode(stream, header, (uint32_t) len);
+    res = Stream_writeBytes(stream, header, stream->FrameHeader);
+    if (res == Stream_Ok && len > 0) {
+        res = Stream_writeBytes(stream, val, len);
+    }
+
+    __mutexUnlock(stream);
+    return res;
+}
+/**
+ * @brief open a frame, placeholder header written and payload can write with any write function,
+ * frame is hidden from frame readers until Stream_endFrame
+ *
+ * @param stream
+ * @return Stream_Result Stream_InFrame if a frame already open
+ */
+Stream_Result Stream_beginFrame(StreamBuffer* stream) {
+    Stream_Result res;
+    __mutexVarInit();
+    __mutexLock(stream);
+    if (stream->InFrame) {
+        __mutexUnlock(stream);
+        return Stream_InFrame;
+    }
+    stream->FrameStart = __getWPos(stream);
+    res = Stream_moveWritePos(stream, stream->FrameHeader);
+    stream->InFrame = res == Stream_Ok;
+    __mutexUnlock(stream);
+    return res;
+}
+/**
+ * @brief close open frame, payload length is bytes written after Stream_beginFrame
+ * and patched into header
+ *
+ * @param stream
+ * @return Stream_Result Stream_NoFrame if no frame is open,
+ *  Stream_FrameTooLong if payload not fit in header, frame stay open and can abort
+ */
+Stream_Result Stream_endFrame(StreamBuffer* stream) {
+    uint8_t header[4];
+    Stream_LenType index;
+    uint32_t len;
+    uint8_t i;
+    __mutexVarInit();
+    __mutexLock(stream);
+    if (!stream->InFrame) {
+        __mutexUnlock(stream);
+        return Stream_NoFrame;
+    }
+    // all bytes after FrameStart belong to open frame
+    len = (uint32_t) (__availableRealUnlocked(stream) - __frameDistance(stream, __getRPos(stream), stream->FrameStart) - stream->FrameHeader);
+    if (len > __frameMaxLen(stream->FrameHeader)) {
+        __mutexUnlock(stream);
+        return Stream_FrameTooLong;
+    }
+
+    Stream_frameEncode(stream, header, len);
+    index = stream->FrameStart;
+    for (i = 0; i < stream->FrameHeader; i++) {
+        stream->Data[index] = header[i];
+        if (++index >= stream->Size) {
+            index = 0;
+        }
+    }
+    stream->InFrame = 0;
+
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+/**
+ * @brief drop open frame and move write position back to its header
+ *
+ * @param stream
+ * @return Stream_Result Stream_NoFrame if no frame is open
+ */
+Stream_Result Stream_abortFrame(StreamBuffer* stream) {
+    __mutexVarInit();
+    __mutexLock(stream);
+    if (!stream->InFrame) {
+        __mutexUnlock(stream);
+        return Stream_NoFrame;
+    }
+    // frame readers never pass FrameStart, so only bytes before it remain
+    __setOverflow(stream, stream->FrameStart < __getRPos(stream));
+    __setWPos(stream, stream->FrameStart);
+    stream->InFrame = 0;
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+/**
+ * @brief return payload of next complete frame without copy, call Stream_popFrame after use
+ *
+ * @param stream
+ * @param vec one or two segments of payload, second one is empty if payload not wrap
+ * @return Stream_Result Stream_NoAvailable if there is no complete frame,
+ *  Stream_FrameTooLong if header length never fit in buffer, Stream_popFrame drop the header
+ */
+Stream_Result Stream_peekFrame(StreamBuffer* stream, Stream_IoVec vec[2]) {
+    Stream_LenType len;
+    Stream_Result res;
+    __mutexVarInit();
+    __mutexLock(stream);
+    res = Stream_frameAt(stream, 0, vec, &len);
+    __mutexUnlock(stream);
+    return res;
+}
+/**
+ * @brief drop next complete frame, a header with length that never fit in buffer
+ * is dropped alone so next frame readers can go on after it
+ *
+ * @param stream
+ * @return Stream_Result Stream_NoAvailable if there is no complete frame,
+ *  Stream_FrameTooLong if bad header dropped
+ */
+Stream_Result Stream_popFrame(StreamBuffer* stream) {
+    Stream_IoVec vec[2];
+    Stream_LenType len;
+    Stream_Result res;
+    __mutexVarInit();
+    __mutexLock(stream);
+    res = Stream_frameAt(stream, 0, vec, &len);
+    if (res == Stream_Ok) {
+        res = Stream_moveReadPos(stream, len);
+        __readLimit(stream, len);
+    }
+    else if (res == Stream_FrameTooLong) {
+        Stream_moveReadPos(stream, stream->FrameHeader);
+        __readLimit(stream, stream->FrameHeader);
+    }
+    __mutexUnlock(stream);
+    return res;
+}
+/**
+ * @brief take lock and start walking complete frames, lock held until Stream_endFrames
+ *
+ * @param stream
+ * @param iter
+ * @return Stream_Result
+ */
+Stream_Result Stream_beginFrames(StreamBuffer* stream, Stream_FrameIter* iter) {
+    __mutexVarInit();
+    __mutexLock(stream);
+    iter->Offset = 0;
+    iter->Count = 0;
+    return Stream_Ok;
+}
+/**
+ * @brief return payload of next complete frame in batch without copy
+ *
+ * @param stream
+ * @param iter
+ * @param vec one or two segments of payload, second one is empty if payload not wrap
+ * @return Stream_Result Stream_NoAvailable if there is no more complete frame,
+ *  Stream_FrameTooLong if header length never fit in buffer, end batch and call Stream_popFrame
+ */
+Stream_Result Stream_nextFrame(StreamBuffer* stream, Stream_FrameIter* iter, Stream_IoVec vec[2]) {
+    Stream_LenType len;
+    Stream_Result res = Stream_frameAt(stream, iter->Offset, vec, &len);
+
+    if (res == Stream_Ok) {
+        iter->Offset += len;
+        iter->Count++;
+    }
+    return res;
+}
+/**
+ * @brief drop frames visited by Stream_nextFrame and release lock
+ *
+ * @param stream
+ * @param iter
+ * @return Stream_Result
+ */
+Stream_Result Stream_endFrames(StreamBuffer* stream, Stream_FrameIter* iter) {
+    Stream_Result res = Stream_Ok;
+    __mutexVarInit();
+    if (iter->Offset > 0) {
+        res = Stream_moveReadPos(stream, iter->Offset);
+        __readLimit(stream, iter->Offset);
+    }
+    __mutexUnlock(stream);
+    return res;
+}
+#endif // STREAM_FRAME
+#if STREAM_WRITE_LOCK
+/**
+ * @brief lock the stream for writing
+ *
+ * @param stream
+ * @return Stream_Result
+ */
+Stream_Result Stream_lockWrite(StreamBuffer* stream, StreamBuffer* lock, Stream_LenType len) {
+    __mutexVarInit();
+    __mutexLock(stream);
+    Stream_LenType space = Stream_space(stream);
     if (space >= len && !stream->WriteLocked) {
         __memCopy(stream, lock, stream, sizeof(StreamBuffer));
         Stream_flipWrite(lock, len);
@@ -1488,8 +2672,8 @@ Stream_LenType Stream_lockWriteLen(StreamBuffer* stream, StreamBuffer* lock) {
         }
     }
     else if (stream->RPos == lock->RPos &&
-        stream->Overflow == 0 &&
-        lock->Overflow) {
+        __isOverflow(stream, stream->WPos, stream->RPos) == 0 &&
+        __isOverflow(lock, lock->WPos, lock->RPos)) {
 
         len = stream->Size;
     }
@@ -1576,8 +2760,8 @@ Stream_LenType Stream_lockReadLen(StreamBuffer* stream, StreamBuffer* lock) {
         }
     }
     else if (stream->WPos == lock->WPos &&
-        stream->Overflow != 0 &&
-        !lock->Overflow) {
+        __isOverflow(stream, stream->WPos, stream->RPos) != 0 &&
+        !__isOverflow(lock, lock->WPos, lock->RPos)) {
 
         len = stream->Size;
     }
@@ -1614,6 +2798,84 @@ Stream_Result Stream_lockReadCustom(void* stream, void* lock, Stream_LenType len
 }
 #endif // STREAM_READ_LOCK_CUSTOM
 #endif // STREAM_READ_LOCK
+#if STREAM_TRANSACTION
+/**
+ * @brief begin write transaction, take lock and check space for maxLen bytes once,
+ * writes of same thread until Stream_endWrite skip lock and use unlocked space check,
+ * other threads wait for lock, transactions can be nested
+ *
+ * @param stream
+ * @param maxLen maximum bytes that write in transaction
+ * @return Stream_Result Stream_NoSpace if space is less than maxLen, lock not held
+ */
+Stream_Result Stream_beginWrite(StreamBuffer* stream, Stream_LenType maxLen) {
+    __mutexVarInit();
+    __mutexLock(stream);
+    if (__spaceUnlocked(stream) < maxLen) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    if (stream->WriteTx++ == 0) {
+        __setTxOwner(stream, WriteOwner, __streamLockSelf());
+    }
+    return Stream_Ok;
+}
+/**
+ * @brief end write transaction and release lock
+ *
+ * @param stream
+ * @return Stream_Result Stream_NoTransaction if stream is not in write transaction of this thread
+ */
+Stream_Result Stream_endWrite(StreamBuffer* stream) {
+    __mutexVarInit();
+    if (stream->WriteTx == 0 || __isTxOther(stream, WriteOwner)) {
+        return Stream_NoTransaction;
+    }
+    if (--stream->WriteTx == 0) {
+        __setTxOwner(stream, WriteOwner, 0);
+    }
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+/**
+ * @brief begin read transaction, take lock and check available for maxLen bytes once,
+ * reads of same thread until Stream_endRead skip lock and use unlocked available check,
+ * other threads wait for lock, transactions can be nested
+ *
+ * @param stream
+ * @param maxLen maximum bytes that read in transaction
+ * @return Stream_Result Stream_NoAvailable if available is less than maxLen, lock not held
+ */
+Stream_Result Stream_beginRead(StreamBuffer* stream, Stream_LenType maxLen) {
+    __mutexVarInit();
+    __mutexLock(stream);
+    if (__availableUnlocked(stream) < maxLen) {
+        __mutexUnlock(stream);
+        return Stream_NoAvailable;
+    }
+    if (stream->ReadTx++ == 0) {
+        __setTxOwner(stream, ReadOwner, __streamLockSelf());
+    }
+    return Stream_Ok;
+}
+/**
+ * @brief end read transaction and release lock
+ *
+ * @param stream
+ * @return Stream_Result Stream_NoTransaction if stream is not in read transaction of this thread
+ */
+Stream_Result Stream_endRead(StreamBuffer* stream) {
+    __mutexVarInit();
+    if (stream->ReadTx == 0 || __isTxOther(stream, ReadOwner)) {
+        return Stream_NoTransaction;
+    }
+    if (--stream->ReadTx == 0) {
+        __setTxOwner(stream, ReadOwner, 0);
+    }
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+#endif // STREAM_TRANSACTION
 
 #if STREAM_ARGS
 /**
@@ -1696,7 +2958,7 @@ Stream_LenType Stream_findByteAt(StreamBuffer* stream, Stream_LenType offset, ui
     uint8_t* pEnd;
 
     if (Stream_available(stream) < offset) {
-        return -1;
+        return STREAM_NOT_FOUND;
     }
 
     __mutexVarInit();
@@ -1705,33 +2967,381 @@ Stream_LenType Stream_findByteAt(StreamBuffer* stream, Stream_LenType offset, ui
     tmpLen = Stream_directAvailableAt(stream, offset);
     pEnd = memchr(pStart, val, tmpLen);
     if (!pEnd && (tmpLen + offset) < Stream_available(stream)) {
+        // second segment start after first one
         pStart = stream->Data;
-        pEnd = memchr(pStart, val, stream->WPos);
+        offset += tmpLen;
+        pEnd = memchr(pStart, val, __getWPos(stream));
     }
 
     __mutexUnlock(stream);
-    return pEnd != NULL ? (Stream_LenType)(pEnd - pStart) + offset : -1;
+    return pEnd != NULL ? (Stream_LenType)(pEnd - pStart) + offset : STREAM_NOT_FOUND;
 }
 Stream_LenType Stream_findPatternAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* pat, Stream_LenType patLen)  {
     if (Stream_available(stream) < patLen) {
-        return -1;
+        return STREAM_NOT_FOUND;
+    }
+
+    while ((offset = Stream_findByteAt(stream, offset, *pat)) != STREAM_NOT_FOUND) {
+        if (Stream_compareAt(stream, offset, pat, patLen) == 0) {
+            break;
+        }
+        offset++;
+    }
+
+    return offset;
+}
+#if STREAM_FIND_COMPILED_AT
+/**
+ * @brief find maximal suffix of pattern for Two-Way critical factorization
+ *
+ * @param pat
+ * @param len
+ * @param reverse use reverse order of bytes
+ * @param period return period of suffix
+ * @return size_t start of maximal suffix minus one
+ */
+static size_t Stream_maxSuffix(const uint8_t* pat, size_t len, uint8_t reverse, size_t* period) {
+    size_t ip = (size_t) -1;
+    size_t jp = 0;
+    size_t k = 1;
+    size_t p = 1;
+    uint8_t a;
+    uint8_t b;
+
+    while (jp + k < len) {
+        a = pat[ip + k];
+        b = pat[jp + k];
+        if (a == b) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            }
+            else {
+                k++;
+            }
+        }
+        else if (reverse ? a < b : a > b) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        }
+        else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+
+    *period = p;
+    return ip;
+}
+/**
+ * @brief compile pattern for Stream_findCompiledAt, pattern bytes not copied
+ *
+ * @param pattern
+ * @param pat address of pattern, must be valid while pattern used
+ * @param patLen length of pattern
+ * @return Stream_Result
+ */
+Stream_Result Stream_compilePattern(Stream_Pattern* pattern, const uint8_t* pat, Stream_LenType patLen) {
+    size_t ms;
+    size_t msReverse;
+    size_t period;
+    size_t periodReverse;
+    Stream_LenType index;
+    Stream_LenType skip;
+
+    if (patLen <= 0) {
+        return Stream_ZeroLen;
+    }
+
+    pattern->Pattern = pat;
+    pattern->Len = patLen;
+    // skip table for last byte of window, bytes not in pattern skip whole pattern
+    memset(pattern->Skip, patLen < 255 ? patLen : 255, sizeof(pattern->Skip));
+    for (index = 0; index < patLen; index++) {
+        skip = patLen - 1 - index;
+        pattern->Skip[pat[index]] = skip < 255 ? (uint8_t) skip : 255;
+    }
+    // critical factorization is larger of two maximal suffixes
+    ms = Stream_maxSuffix(pat, patLen, 0, &period);
+    msReverse = Stream_maxSuffix(pat, patLen, 1, &periodReverse);
+    if (msReverse + 1 > ms + 1) {
+        ms = msReverse;
+        period = periodReverse;
+    }
+    pattern->Critical = (Stream_LenType) (ms + 1);
+    // periodic pattern remember matched prefix after shift
+    if (memcmp(pat, pat + period, pattern->Critical) == 0) {
+        pattern->Period = (Stream_LenType) period;
+        pattern->Memory = patLen - (Stream_LenType) period;
+    }
+    else {
+        pattern->Period = pattern->Critical > patLen - pattern->Critical + 1 ?
+                            pattern->Critical : patLen - pattern->Critical + 1;
+        pattern->Memory = 0;
+    }
+
+    return Stream_Ok;
+}
+/**
+ * @brief find compiled pattern in available bytes, scan both segments of ring buffer
+ * in linear time with single lock, match can cross end of buffer
+ *
+ * @param stream
+ * @param offset start offset from RPos
+ * @param pattern compiled pattern
+ * @return Stream_LenType index of pattern, STREAM_NOT_FOUND if not found
+ */
+Stream_LenType Stream_findCompiledAt(StreamBuffer* stream, Stream_LenType offset, const Stream_Pattern* pattern) {
+    #define __patternByte(IDX)      ((IDX) < seg ? pStart[(IDX)] : stream->Data[(IDX) - seg])
+
+    const uint8_t* pat = pattern->Pattern;
+    const uint8_t* pStart;
+    Stream_LenType patLen = pattern->Len;
+    Stream_LenType crit = pattern->Critical;
+    Stream_LenType result = STREAM_NOT_FOUND;
+    Stream_LenType mem = 0;
+    Stream_LenType pos = 0;
+    Stream_LenType seg;
+    Stream_LenType end;
+    Stream_LenType k;
+
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    end = Stream_available(stream);
+    if (end < offset || end - offset < patLen) {
+        __mutexUnlock(stream);
+        return STREAM_NOT_FOUND;
+    }
+    end -= offset + patLen;
+    pStart = Stream_getReadPtrAt(stream, offset);
+    seg = Stream_directAvailableAt(stream, offset);
+
+    while (pos <= end) {
+        // check last byte first, shift by skip table on mismatch
+        k = pattern->Skip[__patternByte(pos + patLen - 1)];
+        if (k != 0) {
+            pos += k < mem ? mem : k;
+            mem = 0;
+            continue;
+        }
+        // compare right half
+        for (k = crit > mem ? crit : mem; k < patLen && pat[k] == __patternByte(pos + k); k++);
+        if (k < patLen) {
+            pos += k - crit + 1;
+            mem = 0;
+            continue;
+        }
+        // compare left half
+        for (k = crit; k > mem && pat[k - 1] == __patternByte(pos + k - 1); k--);
+        if (k <= mem) {
+            result = pos + offset;
+            break;
+        }
+        pos += pattern->Period;
+        mem = pattern->Memory;
+    }
+
+    __mutexUnlock(stream);
+    return result;
+
+    #undef __patternByte
+}
+#endif // STREAM_FIND_COMPILED_AT
+#if STREAM_FIND_ANY_OF_AT
+/**
+ * @brief hold set of bytes for findAnyOfAt, bitmap for scalar code
+ * and nibble tables for vector code
+ */
+typedef struct {
+    uint8_t     Bits[32];
+    uint8_t     Low[16];            /**< bit of each high nibble that paired with low nibble */
+    uint8_t     High[16];           /**< bit assigned to each high nibble */
+    uint8_t     Nibble;             /**< nibble tables are exact, at most 8 different high nibbles */
+} Stream_ByteSet;
+
+static void Stream_byteSetInit(Stream_ByteSet* byteSet, const uint8_t* set, Stream_LenType setLen) {
+    uint8_t nextBit = 0;
+    uint8_t high;
+
+    memset(byteSet, 0, sizeof(Stream_ByteSet));
+    byteSet->Nibble = 1;
+
+    while (setLen-- > 0) {
+        byteSet->Bits[*set >> 3] |= 1 << (*set & 0x07);
+        high = *set >> 4;
+        if (byteSet->High[high] == 0) {
+            if (nextBit < 8) {
+                byteSet->High[high] = 1 << nextBit++;
+            }
+            else {
+                byteSet->Nibble = 0;
+            }
+        }
+        byteSet->Low[*set & 0x0F] |= byteSet->High[high];
+        set++;
+    }
+}
+#if __STREAM_SIMD_X86
+__attribute__((target("avx2")))
+static size_t memchrsetAvx2(const uint8_t* src, size_t len, const Stream_ByteSet* byteSet) {
+    __m256i low = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) byteSet->Low));
+    __m256i high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) byteSet->High));
+    __m256i mask = _mm256_set1_epi8(0x0F);
+    __m256i zero = _mm256_setzero_si256();
+    uint32_t bits;
+    size_t i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + i));
+        __m256i l = _mm256_shuffle_epi8(low, _mm256_and_si256(v, mask));
+        __m256i h = _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+        bits = ~(uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(l, h), zero));
+        if (bits != 0) {
+            return i + __builtin_ctz(bits);
+        }
+    }
+    return i;
+}
+__attribute__((target("ssse3")))
+static size_t memchrsetSsse3(const uint8_t* src, size_t len, const Stream_ByteSet* byteSet) {
+    __m128i low = _mm_loadu_si128((const __m128i*) byteSet->Low);
+    __m128i high = _mm_loadu_si128((const __m128i*) byteSet->High);
+    __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i zero = _mm_setzero_si128();
+    uint32_t bits;
+    size_t i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + i));
+        __m128i l = _mm_shuffle_epi8(low, _mm_and_si128(v, mask));
+        __m128i h = _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        bits = ~(uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(l, h), zero)) & 0xFFFF;
+        if (bits != 0) {
+            return i + __builtin_ctz(bits);
+        }
+    }
+    return i;
+}
+#endif // __STREAM_SIMD_X86
+/**
+ * @brief find first byte of src that is in byte set
+ *
+ * @param src
+ * @param len
+ * @param byteSet
+ * @return const uint8_t* address of found byte, NULL if not found
+ */
+static const uint8_t* Stream_memAnyOf(const uint8_t* src, Stream_LenType len, const Stream_ByteSet* byteSet) {
+    Stream_LenType index = 0;
+
+#if __STREAM_SIMD_X86
+    // vector code return index of found byte or start of remaining bytes
+    if (byteSet->Nibble && len >= 16) {
+        if (__builtin_cpu_supports("avx2")) {
+            index = (Stream_LenType) memchrsetAvx2(src, len, byteSet);
+        }
+        else if (__builtin_cpu_supports("ssse3")) {
+            index = (Stream_LenType) memchrsetSsse3(src, len, byteSet);
+        }
+    }
+#endif // __STREAM_SIMD_X86
+
+    for (; index < len; index++) {
+        if (byteSet->Bits[src[index] >> 3] & (1 << (src[index] & 0x07))) {
+            return &src[index];
+        }
+    }
+
+    return NULL;
+}
+/**
+ * @brief find first byte that is in set, scan buffer once for all bytes of set
+ *
+ * @param stream
+ * @param offset start offset from RPos
+ * @param set bytes to find, for example "\r\n"
+ * @param setLen number of bytes in set
+ * @return Stream_LenType index of found byte, STREAM_NOT_FOUND if not found
+ */
+Stream_LenType Stream_findAnyOfAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* set, Stream_LenType setLen) {
+    Stream_ByteSet byteSet;
+    Stream_LenType tmpLen;
+    Stream_LenType len;
+    const uint8_t* pStart;
+    const uint8_t* pEnd;
+
+    if (setLen == 1) {
+        return Stream_findByteAt(stream, offset, *set);
+    }
+
+    Stream_byteSetInit(&byteSet, set, setLen);
+
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    len = Stream_available(stream);
+    if (len <= offset) {
+        __mutexUnlock(stream);
+        return STREAM_NOT_FOUND;
     }
 
-    while ((offset = Stream_findByteAt(stream, offset, *pat)) != -1) {
-        if (Stream_compareAt(stream, offset, pat, patLen) == 0) {
-            break;
+    pStart = Stream_getReadPtrAt(stream, offset);
+    tmpLen = Stream_directAvailableAt(stream, offset);
+    pEnd = Stream_memAnyOf(pStart, tmpLen, &byteSet);
+    if (!pEnd && (tmpLen + offset) < len) {
+        // second segment start from beginning of buffer
+        offset += tmpLen;
+        pStart = stream->Data;
+        pEnd = Stream_memAnyOf(pStart, len - offset, &byteSet);
+    }
+
+    __mutexUnlock(stream);
+    return pEnd != NULL ? (Stream_LenType)(pEnd - pStart) + offset : STREAM_NOT_FOUND;
+}
+#endif // STREAM_FIND_ANY_OF_AT
+#if STREAM_READ_UNTIL_AT
+Stream_LenType Stream_readBytesUntilAt(StreamBuffer* stream, Stream_LenType offset, uint8_t end, uint8_t* val, Stream_LenType len) {
+    Stream_LenType tmpLen;
+    // find end byte
+    if ((tmpLen = Stream_findByteAt(stream, offset, end)) != STREAM_NOT_FOUND) {
+        tmpLen++;
+
+        if (len < tmpLen) {
+            tmpLen = len;
+        }
+
+        if (Stream_readBytes(stream, val, tmpLen) == Stream_Ok) {
+            return tmpLen;
+        }
+    }
+
+    return 0;
+}
+Stream_LenType Stream_readBytesUntilPatternAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* pat, Stream_LenType patLen, uint8_t* val, Stream_LenType len){
+    Stream_LenType tmpLen;
+    // find end byte
+    if ((tmpLen = Stream_findPatternAt(stream, offset, pat, patLen)) != STREAM_NOT_FOUND) {
+        tmpLen += patLen;
+
+        if (len < tmpLen) {
+            tmpLen = len;
+        }
+
+        if (Stream_readBytes(stream, val, tmpLen) == Stream_Ok) {
+            return tmpLen;
         }
-        offset++;
     }
 
-    return offset;
+    return 0;
 }
-#if STREAM_READ_UNTIL_AT
-Stream_LenType Stream_readBytesUntilAt(StreamBuffer* stream, Stream_LenType offset, uint8_t end, uint8_t* val, Stream_LenType len) {
+#if STREAM_FIND_COMPILED_AT
+Stream_LenType Stream_readBytesUntilCompiledAt(StreamBuffer* stream, Stream_LenType offset, const Stream_Pattern* pattern, uint8_t* val, Stream_LenType len) {
     Stream_LenType tmpLen;
-    // find end byte
-    if ((tmpLen = Stream_findByteAt(stream, offset, end)) >= 0) {
-        tmpLen++;
+    // find end pattern
+    if ((tmpLen = Stream_findCompiledAt(stream, offset, pattern)) != STREAM_NOT_FOUND) {
+        tmpLen += pattern->Len;
 
         if (len < tmpLen) {
             tmpLen = len;
@@ -1744,11 +3354,13 @@ Stream_LenType Stream_readBytesUntilAt(StreamBuffer* stream, Stream_LenType offs
 
     return 0;
 }
-Stream_LenType Stream_readBytesUntilPatternAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* pat, Stream_LenType patLen, uint8_t* val, Stream_LenType len){
+#endif // STREAM_FIND_COMPILED_AT
+#if STREAM_FIND_ANY_OF_AT
+Stream_LenType Stream_readBytesUntilAnyOfAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* set, Stream_LenType setLen, uint8_t* val, Stream_LenType len) {
     Stream_LenType tmpLen;
-    // find end byte
-    if ((tmpLen = Stream_findPatternAt(stream, offset, pat, patLen)) >= 0) {
-        tmpLen += patLen;
+    // find first end byte
+    if ((tmpLen = Stream_findAnyOfAt(stream, offset, set, setLen)) != STREAM_NOT_FOUND) {
+        tmpLen++;
 
         if (len < tmpLen) {
             tmpLen = len;
@@ -1761,8 +3373,399 @@ Stream_LenType Stream_readBytesUntilPatternAt(StreamBuffer* stream, Stream_LenTy
 
     return 0;
 }
+#endif // STREAM_FIND_ANY_OF_AT
+#endif // STREAM_READ_UNTIL_AT
+#if STREAM_FIND_RESUME
+/**
+ * @brief reset search state, next search start from RPos,
+ * must called after change pattern or reset stream
+ *
+ * @param state
+ */
+void Stream_searchReset(Stream_SearchState* state) {
+    state->ReadTotal = 0;
+    state->Scanned = 0;
+}
+/**
+ * @brief skip bytes that read after last search and return offset of first byte
+ * that must be scanned
+ *
+ * @param stream
+ * @param state
+ * @param len available bytes
+ * @return Stream_LenType
+ */
+static Stream_LenType Stream_searchBegin(StreamBuffer* stream, Stream_SearchState* state, Stream_LenType len) {
+    // difference of running totals, stay correct when whole buffer read between searches
+    size_t consumed = stream->ReadTotal - state->ReadTotal;
+
+    state->ReadTotal = stream->ReadTotal;
+    if (consumed > (size_t) state->Scanned || state->Scanned - (Stream_LenType) consumed > len) {
+        state->Scanned = 0;
+    }
+    else {
+        state->Scanned -= (Stream_LenType) consumed;
+    }
+
+    return state->Scanned;
+}
+/**
+ * @brief save progress of search, last (patLen - 1) bytes scanned again in next search
+ * because match can start in them
+ *
+ * @param state
+ * @param index result of search
+ * @param len available bytes before search
+ * @param patLen
+ * @return Stream_LenType index
+ */
+static Stream_LenType Stream_searchEnd(Stream_SearchState* state, Stream_LenType index, Stream_LenType len, Stream_LenType patLen) {
+    if (index != STREAM_NOT_FOUND) {
+        state->Scanned = index;
+    }
+    else if (len >= patLen && len - (patLen - 1) > state->Scanned) {
+        state->Scanned = len - (patLen - 1);
+    }
+
+    return index;
+}
+/**
+ * @brief find byte and continue from last scanned byte
+ *
+ * @param stream
+ * @param state
+ * @param val
+ * @return Stream_LenType index of byte, STREAM_NOT_FOUND if not found
+ */
+Stream_LenType Stream_findByteResume(StreamBuffer* stream, Stream_SearchState* state, uint8_t val) {
+    Stream_LenType len;
+    Stream_LenType index;
+    __mutexVarInit();
+    __mutexLock(stream);
+    // available bytes read before search, bytes write during search not marked as scanned
+    len = Stream_available(stream);
+    index = Stream_findByteAt(stream, Stream_searchBegin(stream, state, len), val);
+    Stream_searchEnd(state, index, len, 1);
+    __mutexUnlock(stream);
+    return index;
+}
+/**
+ * @brief find pattern and continue from last scanned byte,
+ * partial match at end of available bytes checked again in next search
+ *
+ * @param stream
+ * @param state
+ * @param pat
+ * @param patLen
+ * @return Stream_LenType index of pattern, STREAM_NOT_FOUND if not found
+ */
+Stream_LenType Stream_findPatternResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* pat, Stream_LenType patLen) {
+    Stream_LenType len;
+    Stream_LenType index;
+    __mutexVarInit();
+    __mutexLock(stream);
+    len = Stream_available(stream);
+    index = Stream_findPatternAt(stream, Stream_searchBegin(stream, state, len), pat, patLen);
+    Stream_searchEnd(state, index, len, patLen);
+    __mutexUnlock(stream);
+    return index;
+}
+#if STREAM_FIND_COMPILED_AT
+Stream_LenType Stream_findCompiledResume(StreamBuffer* stream, Stream_SearchState* state, const Stream_Pattern* pattern) {
+    Stream_LenType len;
+    Stream_LenType index;
+    __mutexVarInit();
+    __mutexLock(stream);
+    len = Stream_available(stream);
+    index = Stream_findCompiledAt(stream, Stream_searchBegin(stream, state, len), pattern);
+    Stream_searchEnd(state, index, len, pattern->Len);
+    __mutexUnlock(stream);
+    return index;
+}
+#endif // STREAM_FIND_COMPILED_AT
+#if STREAM_FIND_ANY_OF_AT
+Stream_LenType Stream_findAnyOfResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* set, Stream_LenType setLen) {
+    Stream_LenType len;
+    Stream_LenType index;
+    __mutexVarInit();
+    __mutexLock(stream);
+    len = Stream_available(stream);
+    index = Stream_findAnyOfAt(stream, Stream_searchBegin(stream, state, len), set, setLen);
+    Stream_searchEnd(state, index, len, 1);
+    __mutexUnlock(stream);
+    return index;
+}
+#endif // STREAM_FIND_ANY_OF_AT
+#if STREAM_READ_UNTIL_AT
+/**
+ * @brief read bytes up to end of found delimiter, limited to len
+ *
+ * @param stream
+ * @param index result of find
+ * @param endLen length of delimiter
+ * @param val
+ * @param len
+ * @return Stream_LenType number of read bytes
+ */
+static Stream_LenType Stream_readUntilIndex(StreamBuffer* stream, Stream_LenType index, Stream_LenType endLen, uint8_t* val, Stream_LenType len) {
+    if (index != STREAM_NOT_FOUND) {
+        index += endLen;
+
+        if (len < index) {
+            index = len;
+        }
+
+        if (Stream_readBytes(stream, val, index) == Stream_Ok) {
+            return index;
+        }
+    }
+
+    return 0;
+}
+Stream_LenType Stream_readBytesUntilResume(StreamBuffer* stream, Stream_SearchState* state, uint8_t end, uint8_t* val, Stream_LenType len) {
+    return Stream_readUntilIndex(stream, Stream_findByteResume(stream, state, end), 1, val, len);
+}
+Stream_LenType Stream_readBytesUntilPatternResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* pat, Stream_LenType patLen, uint8_t* val, Stream_LenType len) {
+    return Stream_readUntilIndex(stream, Stream_findPatternResume(stream, state, pat, patLen), patLen, val, len);
+}
+#if STREAM_FIND_COMPILED_AT
+Stream_LenType Stream_readBytesUntilCompiledResume(StreamBuffer* stream, Stream_SearchState* state, const Stream_Pattern* pattern, uint8_t* val, Stream_LenType len) {
+    return Stream_readUntilIndex(stream, Stream_findCompiledResume(stream, state, pattern), pattern->Len, val, len);
+}
+#endif // STREAM_FIND_COMPILED_AT
+#if STREAM_FIND_ANY_OF_AT
+Stream_LenType Stream_readBytesUntilAnyOfResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* set, Stream_LenType setLen, uint8_t* val, Stream_LenType len) {
+    return Stream_readUntilIndex(stream, Stream_findAnyOfResume(stream, state, set, setLen), 1, val, len);
+}
+#endif // STREAM_FIND_ANY_OF_AT
 #endif // STREAM_READ_UNTIL_AT
+#endif // STREAM_FIND_RESUME
 #endif // STREAM_FIND_AT
+/* ------------------------------------ VarInt APIs ---------------------------------- */
+#if STREAM_VAR_INT
+/**
+ * @brief encode value in LEB128, 7 bits per byte and high bit mark next byte
+ *
+ * @param buf output, at least STREAM_VAR_INT_MAX_LEN bytes
+ * @param val
+ * @return uint8_t number of encoded bytes
+ */
+static uint8_t Stream_varEncode(uint8_t* buf, Stream_VarUInt val) {
+    uint8_t len = 0;
+
+    while (val >= 0x80) {
+        buf[len++] = (uint8_t) val | 0x80;
+        val >>= 7;
+    }
+    buf[len++] = (uint8_t) val;
+    return len;
+}
+/**
+ * @brief decode LEB128 from contiguous window, no availability check per byte
+ *
+ * @param buf window
+ * @param n number of bytes in window
+ * @param maxLen maximum encoded length of value type, 5 for 32bit and 10 for 64bit
+ * @param val decoded value
+ * @param len number of decoded bytes
+ * @return Stream_Result Stream_NoAvailable if window end before last byte,
+ *  Stream_VarIntTooLong if value not fit in maxLen bytes
+ */
+static Stream_Result Stream_varDecode(const uint8_t* buf, uint8_t n, uint8_t maxLen, Stream_VarUInt* val, uint8_t* len) {
+    Stream_VarUInt res = 0;
+    uint8_t i;
+
+    for (i = 0; i < n; i++) {
+        res |= (Stream_VarUInt) (buf[i] & 0x7F) << (i * 7);
+        if ((buf[i] & 0x80) == 0) {
+            // last byte of max length only hold remaining high bits (4 for 32bit, 1 for 64bit)
+            if (i == maxLen - 1 && buf[i] >= (maxLen == 5 ? 0x10 : 0x02)) {
+                return Stream_VarIntTooLong;
+            }
+            *val = res;
+            *len = i + 1;
+            return Stream_Ok;
+        }
+    }
+    return n >= maxLen ? Stream_VarIntTooLong : Stream_NoAvailable;
+}
+/**
+ * @brief return number of bytes that value take in LEB128
+ *
+ * @param val
+ * @return uint8_t
+ */
+uint8_t Stream_varUIntLen(Stream_VarUInt val) {
+    uint8_t len = 1;
+
+    while (val >= 0x80) {
+        val >>= 7;
+        len++;
+    }
+    return len;
+}
+#endif // STREAM_VAR_INT
+#if STREAM_WRITE_VAR_INT
+/**
+ * @brief write value in LEB128, use Stream_writeVarInt32/64 for ZigZag signed values
+ *
+ * @param stream
+ * @param val
+ * @return Stream_Result
+ */
+Stream_Result Stream_writeVarUInt(StreamBuffer* stream, Stream_VarUInt val) {
+    uint8_t buf[STREAM_VAR_INT_MAX_LEN];
+
+    return Stream_writeBytes(stream, buf, Stream_varEncode(buf, val));
+}
+#endif // STREAM_WRITE_VAR_INT
+#if STREAM_READ_VAR_INT || STREAM_GET_AT_VAR_INT
+/**
+ * @brief decode varint at index from RPos directly from ring, caller must hold lock,
+ * when maxLen bytes are in row decode in place, otherwise copy available bytes
+ * around end of buffer into window
+ *
+ * @param stream
+ * @param index offset from RPos
+ * @param maxLen maximum encoded length of value type
+ * @param val
+ * @param len number of decoded bytes
+ * @return Stream_Result
+ */
+static Stream_Result Stream_getVarAt(StreamBuffer* stream, Stream_LenType index, uint8_t maxLen, Stream_VarUInt* val, uint8_t* len) {
+    uint8_t buf[STREAM_VAR_INT_MAX_LEN];
+    Stream_LenType available = __availableUnlocked(stream);
+    Stream_LenType pos;
+    Stream_LenType dirLen;
+    uint8_t n;
+
+    if (available <= index) {
+        return Stream_NoAvailable;
+    }
+    available -= index;
+    pos = __wrapIndex(stream, __getRPos(stream) + index);
+    dirLen = __isMirrored(stream) ? available : stream->Size - pos;
+    n = available < maxLen ? (uint8_t) available : maxLen;
+    if (dirLen >= n) {
+        // fast path, whole window in row
+        return Stream_varDecode(&stream->Data[pos], n, maxLen, val, len);
+    }
+    __memCopy(stream, buf, &stream->Data[pos], dirLen);
+    __memCopy(stream, &buf[dirLen], stream->Data, n - dirLen);
+    return Stream_varDecode(buf, n, maxLen, val, len);
+}
+#endif // STREAM_READ_VAR_INT || STREAM_GET_AT_VAR_INT
+#if STREAM_READ_VAR_INT
+/**
+ * @brief read varint and move RPos, nothing consumed on failure
+ *
+ * @param stream
+ * @param maxLen maximum encoded length of value type
+ * @param val
+ * @return Stream_Result
+ */
+static Stream_Result Stream_readVar(StreamBuffer* stream, uint8_t maxLen, Stream_VarUInt* val) {
+    Stream_Result res;
+    uint8_t len;
+    __mutexVarInit();
+    __mutexLock(stream);
+    res = Stream_getVarAt(stream, 0, maxLen, val, &len);
+    if (res == Stream_Ok) {
+        res = Stream_moveReadPos(stream, len);
+        __readLimit(stream, len);
+    }
+    __mutexUnlock(stream);
+    return res;
+}
+Stream_Result Stream_readVarUInt32(StreamBuffer* stream, uint32_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_readVar(stream, 5, &tmp);
+    *val = (uint32_t) tmp;
+    return res;
+}
+Stream_Result Stream_readVarInt32(StreamBuffer* stream, int32_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_readVar(stream, 5, &tmp);
+    *val = Stream_unZigZag32(tmp);
+    return res;
+}
+#if STREAM_UINT64
+Stream_Result Stream_readVarUInt64(StreamBuffer* stream, uint64_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_readVar(stream, 10, &tmp);
+    *val = (uint64_t) tmp;
+    return res;
+}
+Stream_Result Stream_readVarInt64(StreamBuffer* stream, int64_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_readVar(stream, 10, &tmp);
+    *val = Stream_unZigZag64(tmp);
+    return res;
+}
+#endif // STREAM_UINT64
+#endif // STREAM_READ_VAR_INT
+#if STREAM_GET_AT_VAR_INT
+/**
+ * @brief decode varint at index from RPos without move RPos
+ *
+ * @param stream
+ * @param index offset from RPos
+ * @param maxLen maximum encoded length of value type
+ * @param val
+ * @return Stream_Result
+ */
+static Stream_Result Stream_getVar(StreamBuffer* stream, Stream_LenType index, uint8_t maxLen, Stream_VarUInt* val) {
+    Stream_Result res;
+    uint8_t len;
+    __mutexVarInit();
+    __mutexLock(stream);
+    res = Stream_getVarAt(stream, index, maxLen, val, &len);
+    __mutexUnlock(stream);
+    return res;
+}
+Stream_Result Stream_getVarUInt32At(StreamBuffer* stream, Stream_LenType index, uint32_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_getVar(stream, index, 5, &tmp);
+    *val = (uint32_t) tmp;
+    return res;
+}
+Stream_Result Stream_getVarInt32At(StreamBuffer* stream, Stream_LenType index, int32_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_getVar(stream, index, 5, &tmp);
+    *val = Stream_unZigZag32(tmp);
+    return res;
+}
+#if STREAM_UINT64
+Stream_Result Stream_getVarUInt64At(StreamBuffer* stream, Stream_LenType index, uint64_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_getVar(stream, index, 10, &tmp);
+    *val = (uint64_t) tmp;
+    return res;
+}
+Stream_Result Stream_getVarInt64At(StreamBuffer* stream, Stream_LenType index, int64_t* val) {
+    Stream_VarUInt tmp = 0;
+    Stream_Result res = Stream_getVar(stream, index, 10, &tmp);
+    *val = Stream_unZigZag64(tmp);
+    return res;
+}
+#endif // STREAM_UINT64
+#endif // STREAM_GET_AT_VAR_INT
+#if STREAM_FIND_AT_VAR_INT
+/**
+ * @brief find encoded varint from offset, same as Stream_findPatternAt over LEB128 bytes of value
+ *
+ * @param stream
+ * @param offset
+ * @param val
+ * @return Stream_LenType
+ */
+Stream_LenType Stream_findVarUIntAt(StreamBuffer* stream, Stream_LenType offset, Stream_VarUInt val) {
+    uint8_t buf[STREAM_VAR_INT_MAX_LEN];
+    uint8_t len = Stream_varEncode(buf, val);
+
+    return Stream_findPatternAt(stream, offset, buf, len);
+}
+#endif // STREAM_FIND_AT_VAR_INT
 /* ------------------------------------ Transpose APIs ---------------------------------- */
 #if STREAM_TRANSPOSE
 /**
@@ -1792,7 +3795,7 @@ Stream_Result Stream_transposeAt(StreamBuffer* stream, Stream_LenType offset, St
         chunkLen = len;
     }
 
-    rpos = (stream->RPos + offset) % stream->Size;
+    rpos = __wrapIndex(stream, __getRPos(stream) + offset);
 
     while (len > 0) {
         dirLen = Stream_directAvailableAt(stream, offset);
@@ -1822,7 +3825,7 @@ Stream_Result Stream_transposeAt(StreamBuffer* stream, Stream_LenType offset, St
 
         len -= tmpLen;
         offset += tmpLen;
-        rpos = (rpos + tmpLen) % stream->Size;
+        rpos = __wrapIndex(stream, rpos + tmpLen);
     }
 
     __mutexUnlock(stream);
@@ -1847,7 +3850,8 @@ int8_t Stream_compareAt(StreamBuffer* stream, Stream_LenType index, const uint8_
       return 0;
     }
 
-    if (Stream_available(stream) - index < len) {
+    tmpLen = Stream_available(stream);
+    if (tmpLen < index || tmpLen - index < len) {
         return -2;
     }
 
@@ -1868,21 +3872,204 @@ int8_t Stream_compareAt(StreamBuffer* stream, Stream_LenType index, const uint8_
     __mutexUnlock(stream);
     return (int8_t) memcmp(Stream_getReadPtrAt(stream, index), val, len);
 }
-// TODO: need to implement with more performance
 #if STREAM_MEM_IO_BUILT_IN
+#if __STREAM_SIMD_X86
+/**
+ * @brief pshufb mask that reverse 16 bytes
+ */
+static const uint8_t MEM_REVERSE_MASK[16] = {
+    15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+};
+__attribute__((target("avx2")))
+static inline __m256i memreverse256(__m256i v, __m256i mask) {
+    // reverse bytes of each 128 bit lane then swap lanes
+    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, mask), 0x4E);
+}
+__attribute__((target("avx2")))
+static int memrcpyAvx2(uint8_t* dest, const uint8_t* src, int len) {
+    __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) MEM_REVERSE_MASK));
+    int i;
+
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + len - i - 32));
+        _mm256_storeu_si256((__m256i*) (dest + i), memreverse256(v, mask));
+    }
+    return i;
+}
+__attribute__((target("ssse3")))
+static int memrcpySsse3(uint8_t* dest, const uint8_t* src, int len) {
+    __m128i mask = _mm_loadu_si128((const __m128i*) MEM_REVERSE_MASK);
+    int i;
+
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + len - i - 16));
+        _mm_storeu_si128((__m128i*) (dest + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+__attribute__((target("avx2")))
+static int memreverseAvx2(uint8_t* arr, int len) {
+    __m256i mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) MEM_REVERSE_MASK));
+    int i;
+
+    for (i = 0; len - 2 * i >= 64; i += 32) {
+        __m256i lo = _mm256_loadu_si256((const __m256i*) (arr + i));
+        __m256i hi = _mm256_loadu_si256((const __m256i*) (arr + len - i - 32));
+        _mm256_storeu_si256((__m256i*) (arr + i), memreverse256(hi, mask));
+        _mm256_storeu_si256((__m256i*) (arr + len - i - 32), memreverse256(lo, mask));
+    }
+    return i;
+}
+__attribute__((target("ssse3")))
+static int memreverseSsse3(uint8_t* arr, int len) {
+    __m128i mask = _mm_loadu_si128((const __m128i*) MEM_REVERSE_MASK);
+    int i;
+
+    for (i = 0; len - 2 * i >= 32; i += 16) {
+        __m128i lo = _mm_loadu_si128((const __m128i*) (arr + i));
+        __m128i hi = _mm_loadu_si128((const __m128i*) (arr + len - i - 16));
+        _mm_storeu_si128((__m128i*) (arr + i), _mm_shuffle_epi8(hi, mask));
+        _mm_storeu_si128((__m128i*) (arr + len - i - 16), _mm_shuffle_epi8(lo, mask));
+    }
+    return i;
+}
+#endif // __STREAM_SIMD_X86
+/**
+ * @brief copy bytes in reverse order, dest and src must not overlap
+ *
+ * @param dest
+ * @param src
+ * @param len
+ */
 void memrcpy(void* dest, const void* src, int len) {
     uint8_t* pDest = (uint8_t*) dest;
-    const uint8_t* pSrc = (const uint8_t*) src + len - 1;
+    const uint8_t* pSrc = (const uint8_t*) src;
+
+#if defined(__GNUC__) || defined(__clang__)
+    // single value, compile to one bswap
+    switch (len) {
+        case 2: {
+            uint16_t tmp;
+            memcpy(&tmp, pSrc, sizeof(tmp));
+            tmp = __builtin_bswap16(tmp);
+            memcpy(pDest, &tmp, sizeof(tmp));
+            return;
+        }
+        case 4: {
+            uint32_t tmp;
+            memcpy(&tmp, pSrc, sizeof(tmp));
+            tmp = __builtin_bswap32(tmp);
+            memcpy(pDest, &tmp, sizeof(tmp));
+            return;
+        }
+        case 8: {
+            uint64_t tmp;
+            memcpy(&tmp, pSrc, sizeof(tmp));
+            tmp = __builtin_bswap64(tmp);
+            memcpy(pDest, &tmp, sizeof(tmp));
+            return;
+        }
+    }
+#endif
+
+#if __STREAM_SIMD_X86
+    if (len >= 16) {
+        int done = 0;
+        if (__builtin_cpu_supports("avx2")) {
+            done = memrcpyAvx2(pDest, pSrc, len);
+        }
+        else if (__builtin_cpu_supports("ssse3")) {
+            done = memrcpySsse3(pDest, pSrc, len);
+        }
+        // rest of dest is reverse of first part of src
+        pDest += done;
+        len -= done;
+    }
+#endif // __STREAM_SIMD_X86
+
+#if defined(__GNUC__) || defined(__clang__)
+    while (len >= 8) {
+        uint64_t tmp;
+        len -= 8;
+        memcpy(&tmp, pSrc + len, sizeof(tmp));
+        tmp = __builtin_bswap64(tmp);
+        memcpy(pDest, &tmp, sizeof(tmp));
+        pDest += sizeof(tmp);
+    }
+#endif
 
+    pSrc += len - 1;
     while (len-- > 0) {
         *pDest++ = *pSrc--;
     }
 }
+/**
+ * @brief reverse bytes of array in place
+ *
+ * @param arr
+ * @param len
+ */
 void memreverse(void* arr, int len) {
     uint8_t* pSrc = (uint8_t*) arr;
-    uint8_t* pDest = (uint8_t*) arr + len - 1;
+    uint8_t* pDest;
     uint8_t temp;
 
+#if defined(__GNUC__) || defined(__clang__)
+    switch (len) {
+        case 2: {
+            uint16_t tmp;
+            memcpy(&tmp, pSrc, sizeof(tmp));
+            tmp = __builtin_bswap16(tmp);
+            memcpy(pSrc, &tmp, sizeof(tmp));
+            return;
+        }
+        case 4: {
+            uint32_t tmp;
+            memcpy(&tmp, pSrc, sizeof(tmp));
+            tmp = __builtin_bswap32(tmp);
+            memcpy(pSrc, &tmp, sizeof(tmp));
+            return;
+        }
+        case 8: {
+            uint64_t tmp;
+            memcpy(&tmp, pSrc, sizeof(tmp));
+            tmp = __builtin_bswap64(tmp);
+            memcpy(pSrc, &tmp, sizeof(tmp));
+            return;
+        }
+    }
+#endif
+
+#if __STREAM_SIMD_X86
+    if (len >= 32) {
+        int done = 0;
+        if (__builtin_cpu_supports("avx2")) {
+            done = memreverseAvx2(pSrc, len);
+        }
+        else if (__builtin_cpu_supports("ssse3")) {
+            done = memreverseSsse3(pSrc, len);
+        }
+        // both ends are done, middle part remain
+        pSrc += done;
+        len -= done * 2;
+    }
+#endif // __STREAM_SIMD_X86
+
+#if defined(__GNUC__) || defined(__clang__)
+    while (len >= 16) {
+        uint64_t lo, hi;
+        memcpy(&lo, pSrc, sizeof(lo));
+        memcpy(&hi, pSrc + len - 8, sizeof(hi));
+        lo = __builtin_bswap64(lo);
+        hi = __builtin_bswap64(hi);
+        memcpy(pSrc, &hi, sizeof(hi));
+        memcpy(pSrc + len - 8, &lo, sizeof(lo));
+        pSrc += 8;
+        len -= 16;
+    }
+#endif
+
+    pDest = pSrc + len - 1;
     len >>= 1;
     while (len-- > 0) {
         temp = *pSrc;
@@ -1890,4 +4077,112 @@ void memreverse(void* arr, int len) {
         *pDest-- = temp;
     }
 }
+#if __STREAM_SIMD_X86
+/**
+ * @brief build pshufb mask that reverse bytes of each item in 16 byte lane
+ */
+static void memswapMask(uint8_t* mask, int itemLen) {
+    int i;
+    for (i = 0; i < 16; i++) {
+        mask[i] = (uint8_t) ((i / itemLen) * itemLen + (itemLen - 1 - i % itemLen));
+    }
+}
+__attribute__((target("avx2")))
+static int memswapcpyAvx2(uint8_t* dest, const uint8_t* src, int itemLen, int len) {
+    uint8_t maskBytes[16];
+    __m256i mask;
+    int i;
+
+    memswapMask(maskBytes, itemLen);
+    mask = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*) maskBytes));
+    for (i = 0; i + 32 <= len; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + i));
+        _mm256_storeu_si256((__m256i*) (dest + i), _mm256_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+__attribute__((target("ssse3")))
+static int memswapcpySsse3(uint8_t* dest, const uint8_t* src, int itemLen, int len) {
+    uint8_t maskBytes[16];
+    __m128i mask;
+    int i;
+
+    memswapMask(maskBytes, itemLen);
+    mask = _mm_loadu_si128((const __m128i*) maskBytes);
+    for (i = 0; i + 16 <= len; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + i));
+        _mm_storeu_si128((__m128i*) (dest + i), _mm_shuffle_epi8(v, mask));
+    }
+    return i;
+}
+#endif // __STREAM_SIMD_X86
+/**
+ * @brief copy array of items and reverse bytes of each item, use for change byte order
+ * of arrays, dest and src must not overlap
+ *
+ * @param dest
+ * @param src
+ * @param itemLen size of each item
+ * @param len number of items
+ */
+void memswapcpy(void* dest, const void* src, int itemLen, int len) {
+    uint8_t* pDest = (uint8_t*) dest;
+    const uint8_t* pSrc = (const uint8_t*) src;
+
+#if __STREAM_SIMD_X86
+    // items never cross vector lanes when itemLen divide 16
+    if (itemLen == 2 || itemLen == 4 || itemLen == 8 || itemLen == 16) {
+        int done = 0;
+        if (__builtin_cpu_supports("avx2")) {
+            done = memswapcpyAvx2(pDest, pSrc, itemLen, itemLen * len);
+        }
+        else if (__builtin_cpu_supports("ssse3")) {
+            done = memswapcpySsse3(pDest, pSrc, itemLen, itemLen * len);
+        }
+        pDest += done;
+        pSrc += done;
+        len -= done / itemLen;
+    }
+#endif // __STREAM_SIMD_X86
+
+#if defined(__GNUC__) || defined(__clang__)
+    switch (itemLen) {
+        case 2:
+            while (len-- > 0) {
+                uint16_t tmp;
+                memcpy(&tmp, pSrc, sizeof(tmp));
+                tmp = __builtin_bswap16(tmp);
+                memcpy(pDest, &tmp, sizeof(tmp));
+                pDest += sizeof(tmp);
+                pSrc += sizeof(tmp);
+            }
+            return;
+        case 4:
+            while (len-- > 0) {
+                uint32_t tmp;
+                memcpy(&tmp, pSrc, sizeof(tmp));
+                tmp = __builtin_bswap32(tmp);
+                memcpy(pDest, &tmp, sizeof(tmp));
+                pDest += sizeof(tmp);
+                pSrc += sizeof(tmp);
+            }
+            return;
+        case 8:
+            while (len-- > 0) {
+                uint64_t tmp;
+                memcpy(&tmp, pSrc, sizeof(tmp));
+                tmp = __builtin_bswap64(tmp);
+                memcpy(pDest, &tmp, sizeof(tmp));
+                pDest += sizeof(tmp);
+                pSrc += sizeof(tmp);
+            }
+            return;
+    }
+#endif
+    while (len-- > 0) {
+        memrcpy(pDest, pSrc, itemLen);
+        pDest += itemLen;
+        pSrc += itemLen;
+    }
+}
 #endif // STREAM_MEM_IO_BUILT_IN
@@ -22,6 +22,21 @@ extern "C" {
 #include "StreamConfig.h"
 #include "StreamBufferMacro.h"
 
+#if STREAM_SPSC
+    #include <stdatomic.h>
+#endif
+#if STREAM_TRANSACTION && STREAM_MUTEX_POSIX
+    #include "StreamLock.h"
+#endif
+#if STREAM_IO_VEC_POSIX
+    #include <sys/uio.h>
+#elif STREAM_IO_VEC
+    #include <stddef.h>
+#endif
+#if STREAM_FIND_RESUME
+    #include <stddef.h>
+#endif
+
 #define __STREAM_VER_STR(major, minor, fix)     #major "." #minor "." #fix
 #define _STREAM_VER_STR(major, minor, fix)      __STREAM_VER_STR(major, minor, fix)
 /**
@@ -36,13 +51,37 @@ extern "C" {
 /**
  * @brief use for disable limit
  */
-#define STREAM_NO_LIMIT                     -1
+#define STREAM_NO_LIMIT                     ((Stream_LenType) -1)
+/**
+ * @brief find functions return this value if nothing found
+ */
+#define STREAM_NOT_FOUND                    ((Stream_LenType) -1)
 
 /**
  * @brief default value for read function if cause error
  */
 #define STREAM_READ_DEFAULT_VALUE           0
 
+/**
+ * @brief check given size is power of two, usable in constant expressions
+ */
+#define STREAM_IS_POW2(SIZE)                ((SIZE) > 0 && (((SIZE) & ((SIZE) - 1)) == 0))
+/**
+ * @brief compile time assert, COND must be constant expression
+ * NAME must be unique identifier in current scope
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+    #define STREAM_STATIC_ASSERT(COND, NAME)    _Static_assert((COND), #NAME)
+#else
+    #define STREAM_STATIC_ASSERT(COND, NAME)    typedef char NAME[(COND) ? 1 : -1]
+#endif
+/**
+ * @brief declare buffer for stream with compile time power of two size check,
+ * required for STREAM_SIZE_POW2 mode, ex: static STREAM_BUFFER_POW2(rxBuff, 256);
+ */
+#define STREAM_BUFFER_POW2(NAME, SIZE)      uint8_t NAME[(SIZE)]; \
+                                            STREAM_STATIC_ASSERT(STREAM_IS_POW2(SIZE), NAME ##_SizeMustBePow2)
+
 /* Pre-Define Types */
 struct __StreamBuffer;
 typedef struct __StreamBuffer StreamBuffer;
@@ -72,6 +111,15 @@ typedef enum {
     Stream_ZeroLen          = 10,       /**< len parameter is zero */
     Stream_ReceiveFailed    = 11,       /**< failed in receive */
     Stream_TransmitFailed   = 12,       /**< failed in transmit */
+    Stream_MemoryError      = 13,       /**< failed to allocate or map memory */
+    Stream_NoTransaction    = 14,       /**< stream is not in transaction */
+    Stream_NoContiguous     = 15,       /**< there is enough space but not in one contiguous region */
+    Stream_NoFrame          = 16,       /**< there is no open frame */
+    Stream_InFrame          = 17,       /**< a frame is already open */
+    Stream_FrameTooLong     = 18,       /**< frame length not fit in header or buffer */
+    Stream_VarIntTooLong    = 19,       /**< varint encoding is longer than value type */
+    Stream_BadFrame         = 20,       /**< frame encoding is invalid */
+    Stream_BadArgument      = 21,       /**< argument is not valid */
     Stream_MutexError       = 0x40,     /**< mutex error */
     Stream_CustomError      = 0x80,     /**< can be used for custom errors */
 } Stream_Result;
@@ -122,6 +170,13 @@ typedef Stream_LenType (*Stream_MemSetFn)(void* src, uint8_t val, Stream_LenType
  */
 typedef Stream_LenType (*Stream_MemReverseFn)(void* src, Stream_LenType len);
 
+#if STREAM_SPSC
+/**
+ * @brief atomic position type for lock-free single producer/single consumer mode
+ */
+typedef _Atomic Stream_LenType Stream_AtomicLenType;
+#endif // STREAM_SPSC
+
 #if STREAM_MUTEX
 /**
  * @brief Initialize mutex object for stream
@@ -229,8 +284,16 @@ struct __StreamBuffer {
 #endif
     uint8_t*                    Data;                   /**< pointer to buffer */
     Stream_LenType              Size;                   /**< size of buffer */
+#if STREAM_BIP
+    Stream_LenType              Capacity;               /**< real size of buffer, Size hold watermark while reservation wrapped early */
+#endif // STREAM_BIP
+#if STREAM_SPSC
+    Stream_AtomicLenType        WPos;                   /**< write position, only producer change it */
+    Stream_AtomicLenType        RPos;                   /**< read position, only consumer change it */
+#else
     Stream_LenType              WPos;                   /**< write position */
     Stream_LenType              RPos;                   /**< read position */
+#endif // STREAM_SPSC
 #if STREAM_WRITE_LIMIT
     Stream_LenType              WriteLimit;             /**< limit for write operation */
 #endif // STREAM_WRITE_LIMIT
@@ -240,7 +303,27 @@ struct __StreamBuffer {
 #if STREAM_PENDING_BYTES
     Stream_LenType              PendingBytes;           /**< hold pending bytes for receive or transmit */
 #endif
+#if STREAM_TRANSACTION
+    uint8_t                     WriteTx;                /**< depth of write transaction, lock is held */
+    uint8_t                     ReadTx;                 /**< depth of read transaction, lock is held */
+#if STREAM_MUTEX_POSIX
+    _Atomic uintptr_t           WriteOwner;             /**< thread that began write transaction, 0 if none */
+    _Atomic uintptr_t           ReadOwner;              /**< thread that began read transaction, 0 if none */
+#endif // STREAM_MUTEX_POSIX
+#endif // STREAM_TRANSACTION
+#if STREAM_WRITE_RESERVE
+    Stream_LenType              Reserved;               /**< bytes reserved by Stream_reserve and not committed */
+#endif // STREAM_WRITE_RESERVE
+#if STREAM_FIND_RESUME
+    size_t                      ReadTotal;              /**< running count of read bytes, wraps around, use for resume search */
+#endif // STREAM_FIND_RESUME
+#if STREAM_FRAME
+    Stream_LenType              FrameStart;             /**< position of open frame header */
+    uint8_t                     FrameHeader;            /**< frame header width in bytes */
+#endif // STREAM_FRAME
+#if !STREAM_SPSC
     uint8_t                     Overflow        : 1;    /**< overflow flag */
+#endif // STREAM_SPSC
     uint8_t                     InReceive       : 1;    /**< stream is in receive mode */
     uint8_t                     InTransmit      : 1;    /**< stream is in transmit mode */
     uint8_t                     Order           : 1;    /**< byte order */
@@ -248,6 +331,12 @@ struct __StreamBuffer {
     uint8_t                     WriteLocked     : 1;    /**< stream write locked */
     uint8_t                     ReadLocked      : 1;    /**< stream write locked */
     uint8_t                     FlushMode       : 1;    /**< flush mode */
+#if STREAM_MIRRORED
+    uint8_t                     Mirrored        : 1;    /**< buffer mapped twice back to back */
+#endif // STREAM_MIRRORED
+#if STREAM_FRAME
+    uint8_t                     InFrame         : 1;    /**< frame opened by Stream_beginFrame */
+#endif // STREAM_FRAME
 };
 /**
  * @brief hold properties of cursor over stream
@@ -256,11 +345,64 @@ typedef struct {
     Stream_LenType          WPos;
     Stream_LenType          RPos;
 } Stream_Cursor;
+#if STREAM_IO_VEC
+#if STREAM_IO_VEC_POSIX
+    typedef struct iovec Stream_IoVec;
+#else
+/**
+ * @brief hold one contiguous segment of buffer, same fields as POSIX struct iovec
+ */
+typedef struct {
+    void*                   iov_base;
+    size_t                  iov_len;
+} Stream_IoVec;
+#endif // STREAM_IO_VEC_POSIX
+#endif // STREAM_IO_VEC
+#if STREAM_FRAME
+/**
+ * @brief hold position of batch frame iterator, frames visited by Stream_nextFrame
+ * are dropped in Stream_endFrames
+ */
+typedef struct {
+    Stream_LenType          Offset;             /**< offset of next frame from RPos */
+    Stream_LenType          Count;              /**< number of visited frames */
+} Stream_FrameIter;
+#endif // STREAM_FRAME
+#if STREAM_FIND_COMPILED_AT
+/**
+ * @brief hold compiled pattern for findCompiledAt functions,
+ * pattern bytes not copied and must be valid while Stream_Pattern used
+ */
+typedef struct {
+    const uint8_t*          Pattern;
+    Stream_LenType          Len;
+    Stream_LenType          Critical;       /**< critical position, start of right half */
+    Stream_LenType          Period;         /**< shift after full match of right half */
+    Stream_LenType          Memory;         /**< bytes of left half known to match after period shift, zero when pattern not periodic */
+    uint8_t                 Skip[256];      /**< bad character shift of last byte, limited to 255 */
+} Stream_Pattern;
+#endif // STREAM_FIND_COMPILED_AT
+#if STREAM_FIND_RESUME
+/**
+ * @brief hold progress of search between calls, bytes scanned before not scanned again
+ */
+typedef struct {
+    size_t                  ReadTotal;      /**< ReadTotal of stream in last search, use for skip read bytes */
+    Stream_LenType          Scanned;        /**< number of bytes from RPos that can not be start of match */
+} Stream_SearchState;
+#endif // STREAM_FIND_RESUME
 
 // -------------------------- General APIs ----------------------------
 void Stream_init(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size);
 void Stream_fromBuff(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size, Stream_LenType len);
 void Stream_deinit(StreamBuffer* stream);
+#if STREAM_SIZE_POW2
+    Stream_Result   Stream_initPow2(StreamBuffer* stream, uint8_t* buffer, Stream_LenType size);
+#endif // STREAM_SIZE_POW2
+#if STREAM_MIRRORED
+    Stream_Result   Stream_initMirrored(StreamBuffer* stream, Stream_LenType size);
+    uint8_t         Stream_isMirrored(StreamBuffer* stream);
+#endif // STREAM_MIRRORED
 
 #if STREAM_WRITE_LIMIT
     #define         Stream_space(STREAM)                                    Stream_spaceLimit((STREAM))
@@ -289,6 +431,7 @@ void Stream_deinit(StreamBuffer* stream);
 #elif STREAM_MEM_IO_BUILT_IN
     void memrcpy(void* dest, const void* src, int len);
     void memreverse(void* arr, int len);
+    void memswapcpy(void* dest, const void* src, int itemLen, int len);
 #endif
 
 #if STREAM_MUTEX
@@ -380,6 +523,38 @@ Stream_Result       Stream_moveReadPos(StreamBuffer* stream, Stream_LenType step
     Stream_LenType  Stream_getWriteLen(StreamBuffer* stream, Stream_Cursor* cursor);
 #endif // STREAM_CURSOR
 
+#if STREAM_IO_VEC
+    uint8_t         Stream_getReadVec(StreamBuffer* stream, Stream_LenType offset, Stream_LenType len, Stream_IoVec vec[2]);
+    uint8_t         Stream_getWriteVec(StreamBuffer* stream, Stream_LenType offset, Stream_LenType len, Stream_IoVec vec[2]);
+    #define         Stream_commitRead(STREAM, LEN)                          Stream_moveReadPos((STREAM), (LEN))
+    #define         Stream_commitWrite(STREAM, LEN)                         Stream_moveWritePos((STREAM), (LEN))
+#endif // STREAM_IO_VEC
+
+#if STREAM_WRITE_RESERVE
+    Stream_Result   Stream_reserve(StreamBuffer* stream, Stream_LenType len, uint8_t** ptr);
+    Stream_Result   Stream_commit(StreamBuffer* stream, Stream_LenType len);
+    #define         Stream_reservedLen(STREAM)                              ((STREAM)->Reserved)
+#if STREAM_BIP
+    #define         Stream_watermark(STREAM)                                ((STREAM)->Size)
+#endif // STREAM_BIP
+#endif // STREAM_WRITE_RESERVE
+
+#if STREAM_FRAME
+    Stream_Result   Stream_setFrameHeader(StreamBuffer* stream, uint8_t len);
+    #define         Stream_getFrameHeader(STREAM)                           ((STREAM)->FrameHeader)
+    Stream_Result   Stream_writeFrame(StreamBuffer* stream, uint8_t* val, Stream_LenType len);
+    Stream_Result   Stream_beginFrame(StreamBuffer* stream);
+    Stream_Result   Stream_endFrame(StreamBuffer* stream);
+    Stream_Result   Stream_abortFrame(StreamBuffer* stream);
+    #define         Stream_inFrame(STREAM)                                  ((STREAM)->InFrame)
+    Stream_Result   Stream_peekFrame(StreamBuffer* stream, Stream_IoVec vec[2]);
+    Stream_Result   Stream_popFrame(StreamBuffer* stream);
+    Stream_Result   Stream_beginFrames(StreamBuffer* stream, Stream_FrameIter* iter);
+    Stream_Result   Stream_nextFrame(StreamBuffer* stream, Stream_FrameIter* iter, Stream_IoVec vec[2]);
+    Stream_Result   Stream_endFrames(StreamBuffer* stream, Stream_FrameIter* iter);
+    #define         Stream_frameLen(VEC)                                    ((Stream_LenType) ((VEC)[0].iov_len + (VEC)[1].iov_len))
+#endif // STREAM_FRAME
+
 #if STREAM_WRITE_LOCK
     Stream_Result   Stream_lockWrite(StreamBuffer* stream, StreamBuffer* lock, Stream_LenType len);
     void            Stream_unlockWrite(StreamBuffer* stream, StreamBuffer* lock);
@@ -400,6 +575,15 @@ Stream_Result       Stream_moveReadPos(StreamBuffer* stream, Stream_LenType step
 #endif // STREAM_READ_LOCK_CUSTOM
 #endif // STREAM_READ_LOCK
 
+#if STREAM_TRANSACTION
+    Stream_Result   Stream_beginWrite(StreamBuffer* stream, Stream_LenType maxLen);
+    Stream_Result   Stream_endWrite(StreamBuffer* stream);
+    Stream_Result   Stream_beginRead(StreamBuffer* stream, Stream_LenType maxLen);
+    Stream_Result   Stream_endRead(StreamBuffer* stream);
+    #define         Stream_inWriteTransaction(STREAM)                       ((STREAM)->WriteTx != 0)
+    #define         Stream_inReadTransaction(STREAM)                        ((STREAM)->ReadTx != 0)
+#endif // STREAM_TRANSACTION
+
 #if STREAM_ARGS
     void            Stream_setArgs(StreamBuffer* stream, void* args);
     void*           Stream_getArgs(StreamBuffer* stream);
@@ -492,6 +676,9 @@ Stream_Result       Stream_writeArray(StreamBuffer* stream, void* val, Stream_Le
     #define         Stream_writeDoubleArray(STREAM, VAL, LEN)               Stream_writeArray((STREAM), (VAL), sizeof(double), LEN)
 #endif
 #endif // STREAM_WRITE_VALUE
+#if STREAM_WRITE_ARRAY_PACKED
+Stream_Result       Stream_writeUInt32ArrayPacked(StreamBuffer* stream, const uint32_t* val, Stream_LenType len);
+#endif // STREAM_WRITE_ARRAY_PACKED
 #endif // STREAM_WRITE_ARRAY
 /* --------------------------------------- Set API------------------------------------------ */
 #if STREAM_SET_AT
@@ -649,6 +836,10 @@ Stream_Result       Stream_readBytes(StreamBuffer* stream, uint8_t* val, Stream_
     Stream_Result   Stream_readStream(StreamBuffer* in, StreamBuffer* out, Stream_LenType len);
 #endif
 #endif // STREAM_READ
+/* ------------------------------------ Transfer APIs ---------------------------------- */
+#if STREAM_TRANSFER
+    Stream_Result   Stream_transfer(StreamBuffer* out, StreamBuffer* in, Stream_LenType len);
+#endif
 /* ------------------------------------ Read Value APIs ---------------------------------- */
 #if STREAM_READ_VALUE
 Stream_Value        Stream_readValue(StreamBuffer* stream, Stream_LenType len);
@@ -738,6 +929,9 @@ Stream_Result       Stream_readArray(StreamBuffer* stream, void* val, Stream_Len
     #define         Stream_readFloatArray(STREAM, VAL, LEN)                 Stream_readArray((STREAM), VAL, sizeof(float), LEN)
 #endif
 #endif // STREAM_READ_VALUE
+#if STREAM_READ_ARRAY_PACKED
+Stream_Result       Stream_readUInt32ArrayPacked(StreamBuffer* stream, uint32_t* val, Stream_LenType len);
+#endif // STREAM_READ_ARRAY_PACKED
 #endif // STREAM_READ_ARRAY
 /* ------------------------------------ General GetAt APIs ---------------------------------- */
 #if STREAM_GET_AT
@@ -943,6 +1137,13 @@ Stream_Result       Stream_getArrayAt(StreamBuffer* stream, Stream_LenType index
 #if STREAM_FIND_AT
 Stream_LenType      Stream_findByteAt(StreamBuffer* stream, Stream_LenType offset, uint8_t val);
 Stream_LenType      Stream_findPatternAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* pat, Stream_LenType patLen);
+#if STREAM_FIND_COMPILED_AT
+Stream_Result       Stream_compilePattern(Stream_Pattern* pattern, const uint8_t* pat, Stream_LenType patLen);
+Stream_LenType      Stream_findCompiledAt(StreamBuffer* stream, Stream_LenType offset, const Stream_Pattern* pattern);
+#endif // STREAM_FIND_COMPILED_AT
+#if STREAM_FIND_ANY_OF_AT
+Stream_LenType      Stream_findAnyOfAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* set, Stream_LenType setLen);
+#endif // STREAM_FIND_ANY_OF_AT
 #if STREAM_FIND_AT_VALUE
 Stream_LenType      Stream_findValueAt(StreamBuffer* stream, Stream_LenType offset, Stream_Value val, Stream_LenType len);
 #if STREAM_CHAR
@@ -976,6 +1177,12 @@ Stream_LenType      Stream_findValueAt(StreamBuffer* stream, Stream_LenType offs
 #if STREAM_FIND
 #define             Stream_findByte(STREAM, VAL)                            Stream_findByteAt((STREAM), 0, (VAL))
 #define             Stream_findPattern(STREAM, PAT, PAT_LEN)                Stream_findPatternAt((STREAM), 0, (PAT), (PAT_LEN))
+#if STREAM_FIND_COMPILED_AT
+    #define         Stream_findCompiled(STREAM, PAT)                        Stream_findCompiledAt((STREAM), 0, (PAT))
+#endif
+#if STREAM_FIND_ANY_OF_AT
+    #define         Stream_findAnyOf(STREAM, SET, SET_LEN)                  Stream_findAnyOfAt((STREAM), 0, (SET), (SET_LEN))
+#endif
 #if STREAM_FIND_AT_VALUE
     #define         Stream_findValue(STREAM, VAL, LEN)                      Stream_findValueAt((STREAM), 0, (VAL), (LEN))
 #if STREAM_CHAR
@@ -1005,16 +1212,119 @@ Stream_LenType      Stream_findValueAt(StreamBuffer* stream, Stream_LenType offs
 #endif
 #endif // STREAM_FIND_AT_VALUE
 #endif // STREAM_FIND_AT
+/* ------------------------------------ VarInt APIs ---------------------------------- */
+#if STREAM_VAR_INT
+#if STREAM_UINT64
+    typedef uint64_t Stream_VarUInt;
+    #define STREAM_VAR_INT_MAX_LEN                                                  10
+#else
+    typedef uint32_t Stream_VarUInt;
+    #define STREAM_VAR_INT_MAX_LEN                                                  5
+#endif // STREAM_UINT64
+#define             Stream_zigZag32(VAL)                                    (((uint32_t) (VAL) << 1) ^ (uint32_t) ((int32_t) (VAL) >> 31))
+#define             Stream_unZigZag32(VAL)                                  ((int32_t) (((uint32_t) (VAL) >> 1) ^ (0U - ((uint32_t) (VAL) & 1))))
+#if STREAM_UINT64
+    #define         Stream_zigZag64(VAL)                                    (((uint64_t) (VAL) << 1) ^ (uint64_t) ((int64_t) (VAL) >> 63))
+    #define         Stream_unZigZag64(VAL)                                  ((int64_t) (((uint64_t) (VAL) >> 1) ^ (0ULL - ((uint64_t) (VAL) & 1))))
+#endif // STREAM_UINT64
+uint8_t             Stream_varUIntLen(Stream_VarUInt val);
+#define             Stream_varInt32Len(VAL)                                 Stream_varUIntLen(Stream_zigZag32(VAL))
+#if STREAM_UINT64
+    #define         Stream_varInt64Len(VAL)                                 Stream_varUIntLen(Stream_zigZag64(VAL))
+#endif // STREAM_UINT64
+#endif // STREAM_VAR_INT
+#if STREAM_WRITE_VAR_INT
+Stream_Result       Stream_writeVarUInt(StreamBuffer* stream, Stream_VarUInt val);
+#define             Stream_writeVarUInt32(STREAM, VAL)                      Stream_writeVarUInt((STREAM), (uint32_t) (VAL))
+#define             Stream_writeVarInt32(STREAM, VAL)                       Stream_writeVarUInt((STREAM), Stream_zigZag32(VAL))
+#if STREAM_UINT64
+    #define         Stream_writeVarUInt64(STREAM, VAL)                      Stream_writeVarUInt((STREAM), (uint64_t) (VAL))
+    #define         Stream_writeVarInt64(STREAM, VAL)                       Stream_writeVarUInt((STREAM), Stream_zigZag64(VAL))
+#endif // STREAM_UINT64
+#endif // STREAM_WRITE_VAR_INT
+#if STREAM_READ_VAR_INT
+Stream_Result       Stream_readVarUInt32(StreamBuffer* stream, uint32_t* val);
+Stream_Result       Stream_readVarInt32(StreamBuffer* stream, int32_t* val);
+#if STREAM_UINT64
+    Stream_Result   Stream_readVarUInt64(StreamBuffer* stream, uint64_t* val);
+    Stream_Result   Stream_readVarInt64(StreamBuffer* stream, int64_t* val);
+#endif // STREAM_UINT64
+#endif // STREAM_READ_VAR_INT
+#if STREAM_GET_AT_VAR_INT
+Stream_Result       Stream_getVarUInt32At(StreamBuffer* stream, Stream_LenType index, uint32_t* val);
+Stream_Result       Stream_getVarInt32At(StreamBuffer* stream, Stream_LenType index, int32_t* val);
+#if STREAM_UINT64
+    Stream_Result   Stream_getVarUInt64At(StreamBuffer* stream, Stream_LenType index, uint64_t* val);
+    Stream_Result   Stream_getVarInt64At(StreamBuffer* stream, Stream_LenType index, int64_t* val);
+#endif // STREAM_UINT64
+#define             Stream_getVarUInt32(STREAM, VAL)                        Stream_getVarUInt32At((STREAM), 0, (VAL))
+#define             Stream_getVarInt32(STREAM, VAL)                         Stream_getVarInt32At((STREAM), 0, (VAL))
+#if STREAM_UINT64
+    #define         Stream_getVarUInt64(STREAM, VAL)                        Stream_getVarUInt64At((STREAM), 0, (VAL))
+    #define         Stream_getVarInt64(STREAM, VAL)                         Stream_getVarInt64At((STREAM), 0, (VAL))
+#endif // STREAM_UINT64
+#endif // STREAM_GET_AT_VAR_INT
+#if STREAM_FIND_AT_VAR_INT
+Stream_LenType      Stream_findVarUIntAt(StreamBuffer* stream, Stream_LenType offset, Stream_VarUInt val);
+#define             Stream_findVarUInt32At(STREAM, IDX, VAL)                Stream_findVarUIntAt((STREAM), IDX, (uint32_t) (VAL))
+#define             Stream_findVarInt32At(STREAM, IDX, VAL)                 Stream_findVarUIntAt((STREAM), IDX, Stream_zigZag32(VAL))
+#if STREAM_UINT64
+    #define         Stream_findVarUInt64At(STREAM, IDX, VAL)                Stream_findVarUIntAt((STREAM), IDX, (uint64_t) (VAL))
+    #define         Stream_findVarInt64At(STREAM, IDX, VAL)                 Stream_findVarUIntAt((STREAM), IDX, Stream_zigZag64(VAL))
+#endif // STREAM_UINT64
+#if STREAM_FIND
+    #define         Stream_findVarUInt32(STREAM, VAL)                       Stream_findVarUInt32At((STREAM), 0, (VAL))
+    #define         Stream_findVarInt32(STREAM, VAL)                        Stream_findVarInt32At((STREAM), 0, (VAL))
+#if STREAM_UINT64
+    #define         Stream_findVarUInt64(STREAM, VAL)                       Stream_findVarUInt64At((STREAM), 0, (VAL))
+    #define         Stream_findVarInt64(STREAM, VAL)                        Stream_findVarInt64At((STREAM), 0, (VAL))
+#endif // STREAM_UINT64
+#endif // STREAM_FIND
+#endif // STREAM_FIND_AT_VAR_INT
 /* ------------------------------------ Read Bytes Until At APIs ---------------------------------- */
 #if STREAM_READ_UNTIL_AT
 Stream_LenType      Stream_readBytesUntilAt(StreamBuffer* stream, Stream_LenType offset, uint8_t end, uint8_t* val, Stream_LenType len);
 Stream_LenType      Stream_readBytesUntilPatternAt(StreamBuffer* stream,  Stream_LenType offset, const uint8_t* pat, Stream_LenType patLen, uint8_t* val, Stream_LenType len);
+#if STREAM_FIND_COMPILED_AT
+Stream_LenType      Stream_readBytesUntilCompiledAt(StreamBuffer* stream, Stream_LenType offset, const Stream_Pattern* pattern, uint8_t* val, Stream_LenType len);
+#endif
+#if STREAM_FIND_ANY_OF_AT
+Stream_LenType      Stream_readBytesUntilAnyOfAt(StreamBuffer* stream, Stream_LenType offset, const uint8_t* set, Stream_LenType setLen, uint8_t* val, Stream_LenType len);
+#endif
 #endif // STREAM_READ_UNTIL_AT
 /* ------------------------------------ Read Bytes Until APIs ---------------------------------- */
 #if STREAM_READ_UNTIL
 #define             Stream_readBytesUntil(STREAM, END, VAL, LEN)            Stream_readBytesUntilAt((STREAM), 0, (END), (VAL), (LEN))
 #define             Stream_readBytesUntilPattern(STREAM, P, PLEN, VAL, LEN) Stream_readBytesUntilPatternAt((STREAM), 0, (P), (PLEN), (VAL), (LEN))
+#if STREAM_FIND_COMPILED_AT
+    #define         Stream_readBytesUntilCompiled(STREAM, P, VAL, LEN)      Stream_readBytesUntilCompiledAt((STREAM), 0, (P), (VAL), (LEN))
+#endif
+#if STREAM_FIND_ANY_OF_AT
+    #define         Stream_readBytesUntilAnyOf(STREAM, S, SLEN, VAL, LEN)   Stream_readBytesUntilAnyOfAt((STREAM), 0, (S), (SLEN), (VAL), (LEN))
+#endif
 #endif // STREAM_READ_UNTIL
+/* ------------------------------------ Find Resume APIs ---------------------------------- */
+#if STREAM_FIND_RESUME
+void                Stream_searchReset(Stream_SearchState* state);
+Stream_LenType      Stream_findByteResume(StreamBuffer* stream, Stream_SearchState* state, uint8_t val);
+Stream_LenType      Stream_findPatternResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* pat, Stream_LenType patLen);
+#if STREAM_FIND_COMPILED_AT
+Stream_LenType      Stream_findCompiledResume(StreamBuffer* stream, Stream_SearchState* state, const Stream_Pattern* pattern);
+#endif
+#if STREAM_FIND_ANY_OF_AT
+Stream_LenType      Stream_findAnyOfResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* set, Stream_LenType setLen);
+#endif
+#if STREAM_READ_UNTIL_AT
+Stream_LenType      Stream_readBytesUntilResume(StreamBuffer* stream, Stream_SearchState* state, uint8_t end, uint8_t* val, Stream_LenType len);
+Stream_LenType      Stream_readBytesUntilPatternResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* pat, Stream_LenType patLen, uint8_t* val, Stream_LenType len);
+#if STREAM_FIND_COMPILED_AT
+Stream_LenType      Stream_readBytesUntilCompiledResume(StreamBuffer* stream, Stream_SearchState* state, const Stream_Pattern* pattern, uint8_t* val, Stream_LenType len);
+#endif
+#if STREAM_FIND_ANY_OF_AT
+Stream_LenType      Stream_readBytesUntilAnyOfResume(StreamBuffer* stream, Stream_SearchState* state, const uint8_t* set, Stream_LenType setLen, uint8_t* val, Stream_LenType len);
+#endif
+#endif // STREAM_READ_UNTIL_AT
+#endif // STREAM_FIND_RESUME
 /* ------------------------------------ Transpose APIs ---------------------------------- */
 #if STREAM_TRANSPOSE_AT
     Stream_Result   Stream_transposeAt(StreamBuffer* stream, Stream_LenType offset, Stream_LenType len, uint8_t* tmpBuf, Stream_LenType chunkLen, Stream_TransposeFn transpose, void* args);
@@ -0,0 +1,385 @@
+#include "StreamCodec.h"
+
+#if STREAM_COBS || STREAM_SLIP
+
+#include <string.h>
+
+#include "StreamPrivate.h"
+
+/* word at a time byte search, a word has zero byte if (v - 0x01..01) & ~v & 0x80..80 */
+#define __WORD_ONES                                 ((size_t) -1 / 0xFF)
+#define __WORD_HIGHS                                (__WORD_ONES * 0x80)
+#define __hasZero(V)                                (((V) - __WORD_ONES) & ~(V) & __WORD_HIGHS)
+#define __vecLen(VEC, COUNT)                        ((Stream_LenType) (VEC)[0].iov_len + ((COUNT) > 1 ? (Stream_LenType) (VEC)[1].iov_len : 0))
+
+/**
+ * @brief return index of first byte equal to a or b, len if not found
+ */
+static Stream_LenType StreamCodec_find(const uint8_t* p, Stream_LenType len, uint8_t a, uint8_t b) {
+    const size_t wa = __WORD_ONES * a;
+    const size_t wb = __WORD_ONES * b;
+    Stream_LenType i = 0;
+    size_t v;
+
+    while (i < len && ((uintptr_t) (p + i) & (sizeof(size_t) - 1))) {
+        if (p[i] == a || p[i] == b) {
+            return i;
+        }
+        i++;
+    }
+    while (len - i >= (Stream_LenType) sizeof(size_t)) {
+        memcpy(&v, p + i, sizeof(size_t));
+        if (__hasZero(v ^ wa) || __hasZero(v ^ wb)) {
+            break;
+        }
+        i += sizeof(size_t);
+    }
+    while (i < len) {
+        if (p[i] == a || p[i] == b) {
+            return i;
+        }
+        i++;
+    }
+    return len;
+}
+/**
+ * @brief find a or b in [from, to) of segments, return to if not found
+ */
+static Stream_LenType StreamCodec_findVec(const Stream_IoVec* vec, Stream_LenType from, Stream_LenType to, uint8_t a, uint8_t b) {
+    Stream_LenType len0 = (Stream_LenType) vec[0].iov_len;
+    Stream_LenType end;
+    Stream_LenType idx;
+
+    if (from < len0) {
+        end = to < len0 ? to : len0;
+        idx = StreamCodec_find((const uint8_t*) vec[0].iov_base + from, end - from, a, b);
+        if (idx < end - from || end == to) {
+            return from + idx;
+        }
+        from = len0;
+    }
+    return from + StreamCodec_find((const uint8_t*) vec[1].iov_base + (from - len0), to - from, a, b);
+}
+/**
+ * @brief copy bytes from offset of segments
+ */
+static void StreamCodec_copyFrom(const Stream_IoVec* vec, Stream_LenType offset, uint8_t* dst, Stream_LenType len) {
+    Stream_LenType len0 = (Stream_LenType) vec[0].iov_len;
+    Stream_LenType n;
+
+    if (offset < len0) {
+        n = len0 - offset < len ? len0 - offset : len;
+        memcpy(dst, (const uint8_t*) vec[0].iov_base + offset, n);
+        dst += n;
+        len -= n;
+        offset = len0;
+    }
+    if (len > 0) {
+        memcpy(dst, (const uint8_t*) vec[1].iov_base + (offset - len0), len);
+    }
+}
+/**
+ * @brief copy bytes to offset of segments
+ */
+static void StreamCodec_copyTo(Stream_IoVec* vec, Stream_LenType offset, const uint8_t* src, Stream_LenType len) {
+    Stream_LenType len0 = (Stream_LenType) vec[0].iov_len;
+    Stream_LenType n;
+
+    if (offset < len0) {
+        n = len0 - offset < len ? len0 - offset : len;
+        memcpy((uint8_t*) vec[0].iov_base + offset, src, n);
+        src += n;
+        len -= n;
+        offset = len0;
+    }
+    if (len > 0) {
+        memcpy((uint8_t*) vec[1].iov_base + (offset - len0), src, len);
+    }
+}
+#define __getByte(VEC, OFF)                         ((OFF) < (Stream_LenType) (VEC)[0].iov_len ? ((const uint8_t*) (VEC)[0].iov_base)[(OFF)] : \
+                                                        ((const uint8_t*) (VEC)[1].iov_base)[(OFF) - (Stream_LenType) (VEC)[0].iov_len])
+#define __setByte(VEC, OFF, VAL)                    (*((OFF) < (Stream_LenType) (VEC)[0].iov_len ? (uint8_t*) (VEC)[0].iov_base + (OFF) : \
+                                                        (uint8_t*) (VEC)[1].iov_base + ((OFF) - (Stream_LenType) (VEC)[0].iov_len)) = (VAL))
+/**
+ * @brief find next non-empty frame ending with delimiter, empty frames are dropped,
+ * when buffer is full without delimiter frame can never complete, so its bytes are dropped
+ *
+ * @param frameLen return frame length without delimiter
+ * @return Stream_Result Stream_NoAvailable if there is no complete frame,
+ * Stream_FrameTooLong if frame is longer than buffer
+ */
+static Stream_Result StreamCodec_nextFrame(StreamBuffer* stream, Stream_IoVec vec[2], uint8_t delimiter, Stream_LenType* frameLen) {
+    Stream_LenType total;
+    uint8_t count;
+
+    for (;;) {
+        count = Stream_getReadVec(stream, 0, Stream_available(stream), vec);
+        if (count == 0) {
+            return Stream_NoAvailable;
+        }
+        total = __vecLen(vec, count);
+        *frameLen = StreamCodec_findVec(vec, 0, total, delimiter, delimiter);
+        if (*frameLen == total) {
+            if (Stream_spaceReal(stream) == 0) {
+                Stream_moveReadPos(stream, total);
+                __readLimit(stream, total);
+                return Stream_FrameTooLong;
+            }
+            return Stream_NoAvailable;
+        }
+        if (*frameLen > 0) {
+            return Stream_Ok;
+        }
+        Stream_moveReadPos(stream, 1);
+        __readLimit(stream, 1);
+    }
+}
+
+#if STREAM_COBS
+/**
+ * @brief encode bytes with COBS directly into space of stream, frame end with 0x00 delimiter,
+ * nothing written if whole frame not fit
+ *
+ * @param stream
+ * @param val
+ * @param len
+ * @return Stream_Result
+ */
+Stream_Result Stream_writeCobs(StreamBuffer* stream, const uint8_t* val, Stream_LenType len) {
+    Stream_IoVec vec[2];
+    Stream_LenType space;
+    Stream_LenType used = 0;
+    Stream_LenType run;
+    Stream_LenType n;
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    space = Stream_space(stream);
+    if (Stream_getWriteVec(stream, 0, space, vec) == 0) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    // each block is code byte and up to 254 non-zero bytes, zero byte is implied by code < 0xFF
+    for (;;) {
+        n = len < 254 ? len : 254;
+        run = StreamCodec_find(val, n, 0, 0);
+        if (space - used < run + 1) {
+            __mutexUnlock(stream);
+            return Stream_NoSpace;
+        }
+        __setByte(vec, used, (uint8_t) (run + 1));
+        StreamCodec_copyTo(vec, used + 1, val, run);
+        used += run + 1;
+        val += run;
+        len -= run;
+        if (run < n) {
+            // skip zero byte, next block follow it even at the end
+            val++;
+            len--;
+        }
+        else if (len == 0) {
+            break;
+        }
+    }
+    if (space - used < 1) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    __setByte(vec, used, 0x00);
+    used++;
+    Stream_moveWritePos(stream, used);
+    __writeLimit(stream, used);
+
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+/**
+ * @brief decode COBS frame from segments
+ */
+static Stream_Result StreamCodec_decodeCobs(const Stream_IoVec* vec, Stream_LenType frameLen, uint8_t* val, Stream_LenType size, Stream_LenType* len) {
+    Stream_LenType i = 0;
+    Stream_LenType out = 0;
+    Stream_LenType n;
+    uint8_t code;
+
+    while (i < frameLen) {
+        code = __getByte(vec, i);
+        n = code - 1;
+        i++;
+        if (frameLen - i < n) {
+            return Stream_BadFrame;
+        }
+        if (size - out < n) {
+            return Stream_FrameTooLong;
+        }
+        StreamCodec_copyFrom(vec, i, &val[out], n);
+        i += n;
+        out += n;
+        if (code != 0xFF && i < frameLen) {
+            if (out >= size) {
+                return Stream_FrameTooLong;
+            }
+            val[out++] = 0x00;
+        }
+    }
+    *len = out;
+    return Stream_Ok;
+}
+/**
+ * @brief decode next COBS frame into val, frame and its delimiter consumed even if it's invalid,
+ * empty frames (repeated delimiters) are skipped
+ *
+ * @param stream
+ * @param val
+ * @param size size of val
+ * @param len return decoded length
+ * @return Stream_Result Stream_NoAvailable if there is no complete frame,
+ * Stream_FrameTooLong if frame not fit in val or buffer is full without delimiter, Stream_BadFrame if encoding is invalid
+ */
+Stream_Result Stream_readCobsFrame(StreamBuffer* stream, uint8_t* val, Stream_LenType size, Stream_LenType* len) {
+    Stream_IoVec vec[2];
+    Stream_LenType frameLen;
+    Stream_Result res;
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    res = StreamCodec_nextFrame(stream, vec, 0x00, &frameLen);
+    if (res != Stream_Ok) {
+        __mutexUnlock(stream);
+        return res;
+    }
+    res = StreamCodec_decodeCobs(vec, frameLen, val, size, len);
+    Stream_moveReadPos(stream, frameLen + 1);
+    __readLimit(stream, frameLen + 1);
+
+    __mutexUnlock(stream);
+    return res;
+}
+#endif // STREAM_COBS
+
+#if STREAM_SLIP
+/**
+ * @brief encode bytes with SLIP directly into space of stream, frame end with END,
+ * nothing written if whole frame not fit
+ *
+ * @param stream
+ * @param val
+ * @param len
+ * @return Stream_Result
+ */
+Stream_Result Stream_writeSlip(StreamBuffer* stream, const uint8_t* val, Stream_LenType len) {
+    Stream_IoVec vec[2];
+    Stream_LenType space;
+    Stream_LenType used = 0;
+    Stream_LenType run;
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    space = Stream_space(stream);
+    if (Stream_getWriteVec(stream, 0, space, vec) == 0) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    while (len > 0) {
+        // copy run of normal bytes, then escape END or ESC
+        run = StreamCodec_find(val, len, STREAM_SLIP_END, STREAM_SLIP_ESC);
+        if (space - used < run) {
+            __mutexUnlock(stream);
+            return Stream_NoSpace;
+        }
+        StreamCodec_copyTo(vec, used, val, run);
+        used += run;
+        val += run;
+        len -= run;
+        if (len > 0) {
+            if (space - used < 2) {
+                __mutexUnlock(stream);
+                return Stream_NoSpace;
+            }
+            __setByte(vec, used, STREAM_SLIP_ESC);
+            __setByte(vec, used + 1, *val == STREAM_SLIP_END ? STREAM_SLIP_ESC_END : STREAM_SLIP_ESC_ESC);
+            used += 2;
+            val++;
+            len--;
+        }
+    }
+    if (space - used < 1) {
+        __mutexUnlock(stream);
+        return Stream_NoSpace;
+    }
+    __setByte(vec, used, STREAM_SLIP_END);
+    used++;
+    Stream_moveWritePos(stream, used);
+    __writeLimit(stream, used);
+
+    __mutexUnlock(stream);
+    return Stream_Ok;
+}
+/**
+ * @brief decode SLIP frame from segments
+ */
+static Stream_Result StreamCodec_decodeSlip(const Stream_IoVec* vec, Stream_LenType frameLen, uint8_t* val, Stream_LenType size, Stream_LenType* len) {
+    Stream_LenType i = 0;
+    Stream_LenType out = 0;
+    Stream_LenType run;
+    uint8_t c;
+
+    while (i < frameLen) {
+        run = StreamCodec_findVec(vec, i, frameLen, STREAM_SLIP_ESC, STREAM_SLIP_ESC) - i;
+        if (size - out < run) {
+            return Stream_FrameTooLong;
+        }
+        StreamCodec_copyFrom(vec, i, &val[out], run);
+        i += run;
+        out += run;
+        if (i < frameLen) {
+            if (frameLen - i < 2) {
+                return Stream_BadFrame;
+            }
+            c = __getByte(vec, i + 1);
+            if (c != STREAM_SLIP_ESC_END && c != STREAM_SLIP_ESC_ESC) {
+                return Stream_BadFrame;
+            }
+            if (out >= size) {
+                return Stream_FrameTooLong;
+            }
+            val[out++] = c == STREAM_SLIP_ESC_END ? STREAM_SLIP_END : STREAM_SLIP_ESC;
+            i += 2;
+        }
+    }
+    *len = out;
+    return Stream_Ok;
+}
+/**
+ * @brief decode next SLIP frame into val, frame and its END consumed even if it's invalid,
+ * empty frames (repeated END) are skipped
+ *
+ * @param stream
+ * @param val
+ * @param size size of val
+ * @param len return decoded length
+ * @return Stream_Result Stream_NoAvailable if there is no complete frame,
+ * Stream_FrameTooLong if frame not fit in val or buffer is full without delimiter, Stream_BadFrame if escape is invalid
+ */
+Stream_Result Stream_readSlipFrame(StreamBuffer* stream, uint8_t* val, Stream_LenType size, Stream_LenType* len) {
+    Stream_IoVec vec[2];
+    Stream_LenType frameLen;
+    Stream_Result res;
+    __mutexVarInit();
+    __mutexLock(stream);
+
+    res = StreamCodec_nextFrame(stream, vec, STREAM_SLIP_END, &frameLen);
+    if (res != Stream_Ok) {
+        __mutexUnlock(stream);
+        return res;
+    }
+    res = StreamCodec_decodeSlip(vec, frameLen, val, size, len);
+    Stream_moveReadPos(stream, frameLen + 1);
+    __readLimit(stream, frameLen + 1);
+
+    __mutexUnlock(stream);
+    return res;
+}
+#endif // STREAM_SLIP
+
+#endif // STREAM_COBS || STREAM_SLIP
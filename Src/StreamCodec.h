@@ -0,0 +1,68 @@
+/**
+ * @file StreamCodec.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement COBS and SLIP framing over StreamBuffer,
+ * encoder write directly into space of ring and decoder read frame directly from ring
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_CODEC_H_
+#define _STREAM_CODEC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_CODEC_VER_MAJOR    0
+#define STREAM_CODEC_VER_MINOR    1
+#define STREAM_CODEC_VER_FIX      0
+
+#include "StreamBuffer.h"
+
+#if STREAM_COBS || STREAM_SLIP
+
+#include <stdint.h>
+
+/**
+ * @brief show stream codec version in string format
+ */
+#define STREAM_CODEC_VER_STR                _STREAM_VER_STR(STREAM_CODEC_VER_MAJOR, STREAM_CODEC_VER_MINOR, STREAM_CODEC_VER_FIX)
+/**
+ * @brief show stream codec version in integer format, ex: 0.2.0 -> 200
+ */
+#define STREAM_CODEC_VER                    ((STREAM_CODEC_VER_MAJOR * 10000UL) + (STREAM_CODEC_VER_MINOR * 100UL) + (STREAM_CODEC_VER_FIX))
+
+#if STREAM_COBS
+/**
+ * @brief maximum encoded length of COBS frame with delimiter
+ */
+#define STREAM_COBS_MAX_LEN(LEN)            ((LEN) + (LEN) / 254 + 2)
+
+    Stream_Result   Stream_writeCobs(StreamBuffer* stream, const uint8_t* val, Stream_LenType len);
+    Stream_Result   Stream_readCobsFrame(StreamBuffer* stream, uint8_t* val, Stream_LenType size, Stream_LenType* len);
+#endif // STREAM_COBS
+
+#if STREAM_SLIP
+#define STREAM_SLIP_END                     0xC0
+#define STREAM_SLIP_ESC                     0xDB
+#define STREAM_SLIP_ESC_END                 0xDC
+#define STREAM_SLIP_ESC_ESC                 0xDD
+/**
+ * @brief maximum encoded length of SLIP frame with END
+ */
+#define STREAM_SLIP_MAX_LEN(LEN)            ((LEN) * 2 + 1)
+
+    Stream_Result   Stream_writeSlip(StreamBuffer* stream, const uint8_t* val, Stream_LenType len);
+    Stream_Result   Stream_readSlipFrame(StreamBuffer* stream, uint8_t* val, Stream_LenType size, Stream_LenType* len);
+#endif // STREAM_SLIP
+
+#endif // STREAM_COBS || STREAM_SLIP
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_CODEC_H_
@@ -106,13 +106,63 @@
 #ifndef STREAM_PENDING_BYTES
     #define STREAM_PENDING_BYTES                1
 #endif
+/**
+ * @brief large buffer mode, Stream_LenType become unsigned size_t
+ * so buffer size is not limited to 32KB, find functions return STREAM_NOT_FOUND
+ * and STREAM_NO_LIMIT is maximum value of Stream_LenType
+ */
+#ifndef STREAM_LEN_LARGE
+    #define STREAM_LEN_LARGE                    0
+#endif
 /**
  * @brief based on maximum size of buffer that you use for stream
  * you can change type of len variables
- * must be signed type
+ * can be signed or unsigned type, -1 casted to Stream_LenType is reserved
+ * for STREAM_NOT_FOUND and STREAM_NO_LIMIT
  */
 #ifndef STREAM_LEN_TYPE
-    typedef int16_t Stream_LenType;
+    #if STREAM_LEN_LARGE
+        #include <stddef.h>
+        typedef size_t Stream_LenType;
+    #else
+        typedef int16_t Stream_LenType;
+    #endif // STREAM_LEN_LARGE
+#endif
+/**
+ * @brief lock-free single producer/single consumer mode
+ * producer only change WPos and consumer only change RPos, both are C11 atomics
+ * with acquire/release ordering and there is no shared Overflow flag,
+ * so one byte of buffer always stay empty and usable capacity is Size - 1
+ * in this mode mutex is disabled by default, need C11 compiler
+ */
+#ifndef STREAM_SPSC
+    #define STREAM_SPSC                         0
+#endif
+/**
+ * @brief buffer size must be power of two, index wrap use (Size - 1) mask instead of modulo
+ * Stream_init reject other sizes and initialize stream with zero size in this mode,
+ * Stream_initPow2 also return Stream_BadArgument
+ * use STREAM_BUFFER_POW2 to declare static buffers with compile time size check
+ */
+#ifndef STREAM_SIZE_POW2
+    #define STREAM_SIZE_POW2                    0
+#endif
+/**
+ * @brief mirrored buffer support, Stream_initMirrored map same memory pages twice
+ * back to back, so read/write operations never split at end of buffer
+ * only supported on linux (memfd + mmap)
+ */
+#ifndef STREAM_MIRRORED
+    #define STREAM_MIRRORED                     0
+#endif
+/**
+ * @brief bip-buffer mode, Stream_reserve never split a region, when tail of buffer is too short
+ * reservation wrap to start of buffer and end of data (watermark) recorded as lap end,
+ * readers wrap at watermark, so Stream_getReadPtr/Stream_directAvailable return whole reserved records
+ * need STREAM_WRITE_RESERVE, not supported with STREAM_SPSC and STREAM_SIZE_POW2
+ */
+#ifndef STREAM_BIP
+    #define STREAM_BIP                          0
 #endif
 // ---------------------------- Write APIs ------------------------------
 /**
@@ -145,6 +195,12 @@
 #ifndef STREAM_WRITE_ARRAY
     #define STREAM_WRITE_ARRAY                  (1 && STREAM_WRITE)
 #endif
+/**
+ * @brief enable Stream_writeUInt32ArrayPacked, stream-vbyte layout, control bytes then 1 to 4 bytes per value
+ */
+#ifndef STREAM_WRITE_ARRAY_PACKED
+    #define STREAM_WRITE_ARRAY_PACKED           (1 && STREAM_WRITE_ARRAY && STREAM_UINT32)
+#endif
 /**
  * @brief enable write stream apis
  */
@@ -175,6 +231,13 @@
 #ifndef STREAM_WRITE_LOCK_CUSTOM
     #define STREAM_WRITE_LOCK_CUSTOM            (1 && STREAM_WRITE_LOCK)
 #endif
+/**
+ * @brief enable Stream_reserve/Stream_commit, reserve contiguous region of ring for
+ * write in place (ex: snprintf, encoders) and commit used bytes
+ */
+#ifndef STREAM_WRITE_RESERVE
+    #define STREAM_WRITE_RESERVE                (1 && STREAM_WRITE)
+#endif
 
 // ---------------------------- Read APIs -------------------------------
 /**
@@ -207,12 +270,25 @@
 #ifndef STREAM_READ_ARRAY
     #define STREAM_READ_ARRAY                   (1 && STREAM_READ)
 #endif
+/**
+ * @brief enable Stream_readUInt32ArrayPacked, SSSE3 shuffle decode when STREAM_MEM_SIMD enabled
+ */
+#ifndef STREAM_READ_ARRAY_PACKED
+    #define STREAM_READ_ARRAY_PACKED            (1 && STREAM_READ_ARRAY && STREAM_UINT32)
+#endif
 /**
  * @brief enable read stream apis
  */
 #ifndef STREAM_READ_STREAM
     #define STREAM_READ_STREAM                  (1 && STREAM_READ)
 #endif
+/**
+ * @brief enable Stream_transfer, copy bytes between two streams in single pass with both
+ * streams locked, Stream_writeStream and Stream_readStream need it
+ */
+#ifndef STREAM_TRANSFER
+    #define STREAM_TRANSFER                     (1 && (STREAM_WRITE_STREAM || STREAM_READ_STREAM))
+#endif
 /**
  * @brief enable flip read feature
  */
@@ -238,6 +314,16 @@
     #define STREAM_READ_LOCK_CUSTOM             (1 && STREAM_READ_LOCK)
 #endif
 
+/**
+ * @brief enable Stream_beginWrite/Stream_endWrite and Stream_beginRead/Stream_endRead,
+ * lock taken once for many typed writes or reads, only thread that began transaction can
+ * write (read) until end, other threads blocked by lock, thread identified by STREAM_MUTEX_POSIX,
+ * without it calls in transaction take lock again, so mutex must be recursive
+ */
+#ifndef STREAM_TRANSACTION
+    #define STREAM_TRANSACTION                  (1 && (STREAM_WRITE || STREAM_READ))
+#endif
+
 // ----------------------------- Set APIs -------------------------------
 /**
  * @brief enable setAt functions
@@ -365,6 +451,27 @@
 #ifndef STREAM_FIND_AT_VALUE
     #define STREAM_FIND_AT_VALUE                (1 && STREAM_FIND_AT && STREAM_VALUE)
 #endif
+/**
+ * @brief enable Stream_Pattern and findCompiledAt functions, pattern compiled once
+ * with Two-Way critical factorization and skip table, search is linear in stream length
+ */
+#ifndef STREAM_FIND_COMPILED_AT
+    #define STREAM_FIND_COMPILED_AT             (1 && STREAM_FIND_AT)
+#endif
+/**
+ * @brief enable findAnyOfAt functions, find first byte that is in given set of bytes,
+ * use SSSE3/AVX2 nibble lookup when STREAM_MEM_SIMD enabled
+ */
+#ifndef STREAM_FIND_ANY_OF_AT
+    #define STREAM_FIND_ANY_OF_AT               (1 && STREAM_FIND_AT)
+#endif
+/**
+ * @brief enable Stream_SearchState and find/readBytesUntil Resume functions,
+ * next search continue from last scanned byte instead of RPos
+ */
+#ifndef STREAM_FIND_RESUME
+    #define STREAM_FIND_RESUME                  (1 && STREAM_FIND_AT)
+#endif
 
 // ----------------------------- Find APIs ------------------------------
 /**
@@ -402,6 +509,39 @@
     #define STREAM_TRANSPOSE                    (1 && STREAM_TRANSPOSE_AT)
 #endif
 
+// --------------------------- VarInt APIs ------------------------------
+/**
+ * @brief enable LEB128 varint and ZigZag signed varint encoding,
+ * values up to 64bit when STREAM_UINT64 enabled else up to 32bit
+ */
+#ifndef STREAM_VAR_INT
+    #define STREAM_VAR_INT                      (1 && STREAM_UINT32)
+#endif
+/**
+ * @brief enable writeVar functions
+ */
+#ifndef STREAM_WRITE_VAR_INT
+    #define STREAM_WRITE_VAR_INT                (1 && STREAM_WRITE && STREAM_VAR_INT)
+#endif
+/**
+ * @brief enable readVar functions
+ */
+#ifndef STREAM_READ_VAR_INT
+    #define STREAM_READ_VAR_INT                 (1 && STREAM_READ && STREAM_VAR_INT)
+#endif
+/**
+ * @brief enable getVarAt functions
+ */
+#ifndef STREAM_GET_AT_VAR_INT
+    #define STREAM_GET_AT_VAR_INT               (1 && STREAM_GET_AT && STREAM_VAR_INT)
+#endif
+/**
+ * @brief enable findVarAt functions
+ */
+#ifndef STREAM_FIND_AT_VAR_INT
+    #define STREAM_FIND_AT_VAR_INT              (1 && STREAM_FIND_AT && STREAM_VAR_INT)
+#endif
+
 
 // -------------------------- ByteOrder APIs ----------------------------
 /**
@@ -427,6 +567,41 @@
     #define STREAM_CURSOR                       1
 #endif
 
+// --------------------------- IoVec APIs -------------------------------
+/**
+ * @brief enable getReadVec/getWriteVec functions, return one or two segments
+ * of buffer that cover a region for readv/writev and zero copy parsing
+ */
+#ifndef STREAM_IO_VEC
+    #define STREAM_IO_VEC                       1
+#endif
+/**
+ * @brief Stream_IoVec is same as POSIX struct iovec, so vectors can pass directly to readv/writev
+ */
+#ifndef STREAM_IO_VEC_POSIX
+    #if defined(__unix__) || defined(__APPLE__)
+        #define STREAM_IO_VEC_POSIX             (1 && STREAM_IO_VEC)
+    #else
+        #define STREAM_IO_VEC_POSIX             0
+    #endif
+#endif
+
+// ---------------------------- Frame APIs ------------------------------
+/**
+ * @brief enable length-prefixed frames, Stream_writeFrame, Stream_beginFrame/Stream_endFrame
+ * for encode in place, Stream_peekFrame/Stream_popFrame and Stream_beginFrames iterator,
+ * header byte order follow Stream_setByteOrder (little endian without STREAM_BYTE_ORDER)
+ */
+#ifndef STREAM_FRAME
+    #define STREAM_FRAME                        (1 && STREAM_WRITE && STREAM_READ && STREAM_IO_VEC && !STREAM_SPSC)
+#endif
+/**
+ * @brief default frame header width in bytes (1, 2 or 4), can change with Stream_setFrameHeader
+ */
+#ifndef STREAM_FRAME_HEADER_LEN
+    #define STREAM_FRAME_HEADER_LEN             2
+#endif
+
 // ---------------------------- MemIO APIs ------------------------------
 /* StreamBuffer Memory IO States */
 #define STREAM_MEM_IO_DEFAULT                   0
@@ -452,24 +627,69 @@
 #ifndef STREAM_MEM_REVERSE
     #define STREAM_MEM_REVERSE                  memreverse
 #endif
+#ifndef STREAM_MEM_SWAP_COPY
+    #define STREAM_MEM_SWAP_COPY                memswapcpy
+#endif
 /**
- * @brief Implement built in mem utils function for `memrcpy`, `memreverse
+ * @brief Implement built in mem utils function for `memrcpy`, `memreverse`, `memswapcpy`
  */
 #ifndef STREAM_MEM_IO_BUILT_IN
     #define STREAM_MEM_IO_BUILT_IN              (1 && (STREAM_MEM_IO == STREAM_MEM_IO_DEFAULT))
 #endif
+/**
+ * @brief use SSSE3/AVX2 kernels in built in mem utils on x86 with GCC/Clang,
+ * cpu features detect at runtime and scalar code used as fallback
+ */
+#ifndef STREAM_MEM_SIMD
+    #define STREAM_MEM_SIMD                     (1 && STREAM_MEM_IO_BUILT_IN)
+#endif
 
 // ---------------------------- Mutex APIs ------------------------------
 #define STREAM_MUTEX_NONE                       0
 #define STREAM_MUTEX_CUSTOM                     1
 #define STREAM_MUTEX_DRIVER                     2
 #define STREAM_MUTEX_GLOBAL_DRIVER              3
+#define STREAM_MUTEX_BUILT_IN                   4
 /**
  * @brief If you want mutex for thread safety
+ * in STREAM_SPSC mode default is STREAM_MUTEX_NONE
+ * STREAM_MUTEX_BUILT_IN inline lock selected by STREAM_MUTEX_BUILT_IN_LOCK into stream functions
+ * without driver, Stream_Mutex become lock object itself and Stream_init initialize it
  */
 #ifndef STREAM_MUTEX
+#if STREAM_SPSC
+    #define STREAM_MUTEX                        STREAM_MUTEX_NONE
+#else
     #define STREAM_MUTEX                        STREAM_MUTEX_DRIVER
 #endif
+#endif
+
+#define STREAM_MUTEX_LOCK_PTHREAD               0
+#define STREAM_MUTEX_LOCK_SPIN                  1
+#define STREAM_MUTEX_LOCK_ATOMIC                2
+/**
+ * @brief enable bundled recursive locks in StreamLock.h and mutex drivers in StreamMutex.h,
+ * pthread mutex, pthread spinlock and C11 atomic_flag spin-then-yield lock, need POSIX threads
+ */
+#ifndef STREAM_MUTEX_POSIX
+    #if defined(__unix__)
+        #define STREAM_MUTEX_POSIX              (1 && STREAM_MUTEX)
+    #else
+        #define STREAM_MUTEX_POSIX              0
+    #endif
+#endif
+/**
+ * @brief lock that inlined in STREAM_MUTEX_BUILT_IN mode
+ */
+#ifndef STREAM_MUTEX_BUILT_IN_LOCK
+    #define STREAM_MUTEX_BUILT_IN_LOCK          STREAM_MUTEX_LOCK_PTHREAD
+#endif
+/**
+ * @brief number of failed tries of atomic lock before yield thread
+ */
+#ifndef STREAM_MUTEX_SPIN_COUNT
+    #define STREAM_MUTEX_SPIN_COUNT             64
+#endif
 
 #if STREAM_MUTEX
     /**
@@ -488,8 +708,13 @@
      * @brief Stream Mutex object
      */
     #ifndef STREAM_MUTEX_TYPE
+    #if STREAM_MUTEX == STREAM_MUTEX_BUILT_IN
+        #include "StreamLock.h"
+        typedef StreamLock Stream_Mutex;
+    #else
         typedef void* Stream_Mutex;
     #endif
+    #endif
     /**
      * @brief mutex function not exists
      */
@@ -558,4 +783,99 @@
     #define ISTREAM_FULL_CALLBACK       1
 #endif
 
+/************************************************************************/
+/*                                StreamFd                              */
+/************************************************************************/
+
+/**
+ * @brief enable POSIX file descriptor driver for IStream/OStream,
+ * use non-blocking readv/writev over both segments of buffer
+ */
+#ifndef STREAM_FD
+    #define STREAM_FD                   (1 && STREAM_IO_VEC_POSIX && STREAM_DRIVER_ARGS && (ISTREAM || OSTREAM))
+#endif
+/**
+ * @brief enable zero-copy OStream transmit to pipes with vmsplice in StreamFd.h, Linux only,
+ * ring bytes stay referenced by pipe and released from OStream only after pipe reader consume them
+ */
+#ifndef STREAM_FD_SPLICE
+    #define STREAM_FD_SPLICE            0
+#endif
+/**
+ * @brief enable Linux io_uring driver for IStream/OStream in StreamUring.h,
+ * receive and flush post readv/writev requests and StreamUring_poll handle completions of many streams
+ */
+#ifndef STREAM_URING
+    #define STREAM_URING                0
+#endif
+/**
+ * @brief enable epoll event loop in StreamLoop.h, drive many fd streams (StreamFd) in single thread
+ */
+#ifndef STREAM_LOOP
+    #if defined(__linux__)
+        #define STREAM_LOOP             (1 && STREAM_FD && ISTREAM && OSTREAM)
+    #else
+        #define STREAM_LOOP             0
+    #endif
+#endif
+/**
+ * @brief maximum events handled by each StreamLoop_run
+ */
+#ifndef STREAM_LOOP_EVENTS
+    #define STREAM_LOOP_EVENTS          64
+#endif
+
+/************************************************************************/
+/*                               StreamCrc                              */
+/************************************************************************/
+
+/**
+ * @brief enable CRC32, CRC32C and CRC16 in StreamCrc.h, computed in place over both segments of buffer
+ */
+#ifndef STREAM_CRC
+    #define STREAM_CRC                  (1 && STREAM_IO_VEC)
+#endif
+/**
+ * @brief use slicing-by-8 tables for CRC32 and CRC32C (8KB), else one 1KB table per CRC
+ */
+#ifndef STREAM_CRC_SLICE8
+    #define STREAM_CRC_SLICE8           1
+#endif
+/**
+ * @brief use PCLMULQDQ folding for CRC32 and SSE4.2 crc32 instruction for CRC32C on x86,
+ * selected at run time when cpu support them
+ */
+#ifndef STREAM_CRC_SIMD
+    #define STREAM_CRC_SIMD             (1 && STREAM_MEM_SIMD)
+#endif
+
+/************************************************************************/
+/*                            StreamPipeline                            */
+/************************************************************************/
+
+/**
+ * @brief enable Stream_Filter and Stream_Pipeline in StreamPipeline.h,
+ * chain of length changing filters between ring buffers
+ */
+#ifndef STREAM_PIPELINE
+    #define STREAM_PIPELINE             (1 && STREAM_WRITE && STREAM_READ)
+#endif
+
+/************************************************************************/
+/*                              StreamCodec                             */
+/************************************************************************/
+
+/**
+ * @brief enable COBS framing in StreamCodec.h, encode into space of ring and decode frames from ring
+ */
+#ifndef STREAM_COBS
+    #define STREAM_COBS                 (1 && STREAM_IO_VEC && STREAM_WRITE && STREAM_READ)
+#endif
+/**
+ * @brief enable SLIP (RFC 1055) framing in StreamCodec.h, encode into space of ring and decode frames from ring
+ */
+#ifndef STREAM_SLIP
+    #define STREAM_SLIP                 (1 && STREAM_IO_VEC && STREAM_WRITE && STREAM_READ)
+#endif
+
 #endif // _STREAM_CONFIG_H_
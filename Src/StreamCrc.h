@@ -0,0 +1,93 @@
+/**
+ * @file StreamCrc.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement CRC32, CRC32C and CRC16 over memory and over stream bytes in place,
+ * both segments of buffer processed without copy
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_CRC_H_
+#define _STREAM_CRC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_CRC_VER_MAJOR    0
+#define STREAM_CRC_VER_MINOR    1
+#define STREAM_CRC_VER_FIX      0
+
+#include "StreamBuffer.h"
+
+#if STREAM_CRC
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief show stream crc version in string format
+ */
+#define STREAM_CRC_VER_STR                  _STREAM_VER_STR(STREAM_CRC_VER_MAJOR, STREAM_CRC_VER_MINOR, STREAM_CRC_VER_FIX)
+/**
+ * @brief show stream crc version in integer format, ex: 0.2.0 -> 200
+ */
+#define STREAM_CRC_VER                      ((STREAM_CRC_VER_MAJOR * 10000UL) + (STREAM_CRC_VER_MINOR * 100UL) + (STREAM_CRC_VER_FIX))
+
+/**
+ * @brief CRC16 parameters, poly, init, xorOut, reflected, ex: StreamCrc_initCrc16(&model, STREAM_CRC16_MODBUS);
+ */
+#define STREAM_CRC16_MODBUS                 0x8005, 0xFFFF, 0x0000, 1
+#define STREAM_CRC16_CCITT_FALSE            0x1021, 0xFFFF, 0x0000, 0
+#define STREAM_CRC16_XMODEM                 0x1021, 0x0000, 0x0000, 0
+#define STREAM_CRC16_KERMIT                 0x1021, 0x0000, 0x0000, 1
+/**
+ * @brief CRC16 model with its lookup table, filled by StreamCrc_initCrc16
+ */
+typedef struct {
+    uint16_t                Table[256];
+    uint16_t                Init;           /**< initial register, reflected if model is reflected */
+    uint16_t                XorOut;
+    uint8_t                 Reflected;
+} StreamCrc16;
+
+void            StreamCrc_initCrc16(StreamCrc16* model, uint16_t poly, uint16_t init, uint16_t xorOut, uint8_t reflected);
+/**
+ * @brief CRC16 of empty data, start value of running checksum
+ */
+#define         StreamCrc_crc16Empty(MODEL)                                 ((uint16_t) ((MODEL)->Init ^ (MODEL)->XorOut))
+
+/**
+ * @brief running checksum, pass crc of previous bytes and get crc of previous and new bytes,
+ * start with 0 for CRC32/CRC32C and StreamCrc_crc16Empty for CRC16
+ */
+uint32_t        StreamCrc_crc32(uint32_t crc, const void* data, size_t len);
+uint32_t        StreamCrc_crc32c(uint32_t crc, const void* data, size_t len);
+uint16_t        StreamCrc_crc16(const StreamCrc16* model, uint16_t crc, const void* data, size_t len);
+/**
+ * @brief crc of A followed by B from crc of A, crc of B and length of B,
+ * ex: chunks checksummed separately in different threads
+ */
+uint32_t        StreamCrc_crc32Combine(uint32_t crc1, uint32_t crc2, size_t len2);
+uint32_t        StreamCrc_crc32cCombine(uint32_t crc1, uint32_t crc2, size_t len2);
+
+/**
+ * @brief update running crc with len bytes from offset of available bytes, nothing read from stream,
+ * ex: crc of each chunk after IStream_handle, Stream_crc32At(&stream, checked, newBytes, &crc)
+ */
+Stream_Result   Stream_crc32At(StreamBuffer* stream, Stream_LenType offset, Stream_LenType len, uint32_t* crc);
+Stream_Result   Stream_crc32cAt(StreamBuffer* stream, Stream_LenType offset, Stream_LenType len, uint32_t* crc);
+Stream_Result   Stream_crc16At(StreamBuffer* stream, const StreamCrc16* model, Stream_LenType offset, Stream_LenType len, uint16_t* crc);
+#define         Stream_crc32(STREAM, LEN, CRC)                              Stream_crc32At((STREAM), 0, (LEN), (CRC))
+#define         Stream_crc32c(STREAM, LEN, CRC)                             Stream_crc32cAt((STREAM), 0, (LEN), (CRC))
+#define         Stream_crc16(STREAM, MODEL, LEN, CRC)                       Stream_crc16At((STREAM), (MODEL), 0, (LEN), (CRC))
+
+#endif // STREAM_CRC
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_CRC_H_
@@ -0,0 +1,295 @@
+#include "StreamFd.h"
+
+#if STREAM_FD
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if STREAM_FD_SPLICE
+    #if !defined(__linux__)
+        #error "STREAM_FD_SPLICE need Linux"
+    #endif
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #ifndef SPLICE_F_NONBLOCK
+        #define SPLICE_F_NONBLOCK                   0x02
+    #endif
+#endif
+
+#include "StreamPrivate.h"
+
+/**
+ * @brief set file descriptor to non-blocking mode
+ *
+ * @param fd
+ * @return int 0 on success
+ */
+static int StreamFd_setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+#if ISTREAM
+/**
+ * @brief read from fd into both segments of space with single readv,
+ * EAGAIN keep stream in receive mode until IStream_handleFd called
+ *
+ * @param stream
+ * @return Stream_Result
+ */
+static Stream_Result IStream_readFd(StreamIn* stream) {
+    Stream_IoVec vec[2];
+    uint8_t count;
+    ssize_t len;
+
+    count = Stream_getWriteVec(&stream->Buffer, 0, Stream_space(&stream->Buffer), vec);
+    if (count == 0) {
+        stream->Buffer.InReceive = 0;
+        return Stream_NoSpace;
+    }
+    // IStream_handle limit received bytes to pending bytes, so cover both segments
+    stream->Buffer.PendingBytes = (Stream_LenType) (vec[0].iov_len + (count > 1 ? vec[1].iov_len : 0));
+
+    do {
+        len = readv(IStream_getFd(stream), vec, count);
+    } while (len < 0 && errno == EINTR);
+
+    if (len > 0) {
+        return IStream_handle(stream, (Stream_LenType) len);
+    }
+    else if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return Stream_Ok;
+    }
+
+    // end of file or error, errno show reason
+    stream->Buffer.InReceive = 0;
+    return Stream_ReceiveFailed;
+}
+/**
+ * @brief receive function of fd driver, buff and len ignored and both segments filled
+ */
+static Stream_Result IStream_receiveFd(StreamIn* stream, uint8_t* buff, Stream_LenType len) {
+    return IStream_readFd(stream);
+}
+/**
+ * @brief initialize input stream over file descriptor, fd changed to non-blocking mode,
+ * call IStream_receive to start receive
+ *
+ * @param stream
+ * @param fd file descriptor, ex: pipe, socket, tty
+ * @param buff
+ * @param size
+ * @return Stream_Result Stream_ReceiveFailed if fd can not change to non-blocking mode
+ */
+Stream_Result IStream_initFd(StreamIn* stream, int fd, uint8_t* buff, Stream_LenType size) {
+    IStream_init(stream, IStream_receiveFd, buff, size);
+    IStream_setDriverArgs(stream, (void*) (intptr_t) fd);
+    return StreamFd_setNonBlocking(fd) == 0 ? Stream_Ok : Stream_ReceiveFailed;
+}
+/**
+ * @brief call when fd is readable, ex: after poll/epoll, read all pending bytes
+ * until EAGAIN or buffer full
+ *
+ * @param stream
+ * @return Stream_Result Stream_Ok, Stream_NoSpace when buffer is full, Stream_ReceiveFailed on end of file or error
+ */
+Stream_Result IStream_handleFd(StreamIn* stream) {
+    Stream_Result res;
+    __mutexVarInit();
+    __mutexLock(&stream->Buffer);
+
+    res = stream->Buffer.InReceive ? IStream_readFd(stream) : IStream_receive(stream);
+
+    __mutexUnlock(&stream->Buffer);
+    return res;
+}
+#endif // ISTREAM
+
+#if OSTREAM
+/**
+ * @brief write both segments of available bytes to fd with single writev,
+ * EAGAIN keep stream in transmit mode until OStream_handleFd called
+ *
+ * @param stream
+ * @return Stream_Result
+ */
+static Stream_Result OStream_writeFd(StreamOut* stream) {
+    Stream_IoVec vec[2];
+    Stream_Result res;
+    uint8_t count;
+    ssize_t len;
+
+    count = Stream_getReadVec(&stream->Buffer, 0, Stream_available(&stream->Buffer), vec);
+    if (count == 0) {
+        stream->Buffer.InTransmit = 0;
+        return Stream_Ok;
+    }
+    // OStream_handle limit transmitted bytes to pending bytes, so cover both segments
+    stream->Buffer.PendingBytes = (Stream_LenType) (vec[0].iov_len + (count > 1 ? vec[1].iov_len : 0));
+
+    do {
+        len = writev(OStream_getFd(stream), vec, count);
+    } while (len < 0 && errno == EINTR);
+
+    if (len > 0) {
+        res = OStream_handle(stream, (Stream_LenType) len);
+        // all bytes flushed
+        return res == Stream_NoAvailable ? Stream_Ok : res;
+    }
+    else if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return Stream_Ok;
+    }
+
+    stream->Buffer.InTransmit = 0;
+    return Stream_TransmitFailed;
+}
+/**
+ * @brief transmit function of fd driver, buff and len ignored and both segments written
+ */
+static Stream_Result OStream_transmitFd(StreamOut* stream, uint8_t* buff, Stream_LenType len) {
+    return OStream_writeFd(stream);
+}
+/**
+ * @brief initialize output stream over file descriptor, fd changed to non-blocking mode,
+ * call OStream_flush to start transmit, writing to closed pipe or socket raise SIGPIPE
+ *
+ * @param stream
+ * @param fd file descriptor, ex: pipe, socket, tty
+ * @param buff
+ * @param size
+ * @return Stream_Result Stream_TransmitFailed if fd can not change to non-blocking mode
+ */
+Stream_Result OStream_initFd(StreamOut* stream, int fd, uint8_t* buff, Stream_LenType size) {
+    OStream_init(stream, OStream_transmitFd, buff, size);
+    OStream_setDriverArgs(stream, (void*) (intptr_t) fd);
+    return StreamFd_setNonBlocking(fd) == 0 ? Stream_Ok : Stream_TransmitFailed;
+}
+/**
+ * @brief call when fd is writable, ex: after poll/epoll, write pending bytes until EAGAIN
+ * or stream is empty
+ *
+ * @param stream
+ * @return Stream_Result Stream_Ok, Stream_TransmitFailed on error
+ */
+Stream_Result OStream_handleFd(StreamOut* stream) {
+    Stream_Result res;
+    __mutexVarInit();
+    __mutexLock(&stream->Buffer);
+
+    if (stream->Buffer.InTransmit) {
+        res = OStream_writeFd(stream);
+    }
+    else {
+        res = OStream_flush(stream);
+        if (res == Stream_NoAvailable) {
+            res = Stream_Ok;
+        }
+    }
+
+    __mutexUnlock(&stream->Buffer);
+    return res;
+}
+#endif // OSTREAM
+
+#if OSTREAM && STREAM_FD_SPLICE
+/**
+ * @brief hand available bytes after bytes already in pipe to pipe with vmsplice, pipe keep
+ * reference to ring pages, so bytes stay in stream (pending) until reader consume them
+ *
+ * @param stream
+ * @return Stream_Result
+ */
+static Stream_Result OStream_spliceFd(StreamOut* stream) {
+    OStream_Splice* splice = OStream_getSplice(stream);
+    Stream_LenType available = Stream_available(&stream->Buffer);
+    Stream_IoVec vec[2];
+    uint8_t count;
+    long len;
+
+    if (available > splice->InPipe) {
+        count = Stream_getReadVec(&stream->Buffer, splice->InPipe, available - splice->InPipe, vec);
+        do {
+            len = syscall(SYS_vmsplice, splice->Fd, vec, (unsigned long) count, SPLICE_F_NONBLOCK);
+        } while (len < 0 && errno == EINTR);
+
+        if (len > 0) {
+            splice->InPipe += (Stream_LenType) len;
+        }
+        else if (len == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            stream->Buffer.InTransmit = 0;
+            return Stream_TransmitFailed;
+        }
+    }
+    // OStream_handle limit released bytes to pending bytes
+    stream->Buffer.PendingBytes = splice->InPipe;
+    return Stream_Ok;
+}
+/**
+ * @brief transmit function of splice driver, buff and len ignored and both segments spliced
+ */
+static Stream_Result OStream_transmitSplice(StreamOut* stream, uint8_t* buff, Stream_LenType len) {
+    return OStream_spliceFd(stream);
+}
+/**
+ * @brief initialize output stream over write side of pipe with zero-copy vmsplice transmit,
+ * fd changed to non-blocking mode, call OStream_flush to start transmit and OStream_handleSplice
+ * to release bytes consumed by reader, only this stream must write into pipe and
+ * bytes in stream must not change in place after flush (ex: Stream_setAt)
+ *
+ * @param stream
+ * @param splice state of stream, must be valid while stream used
+ * @param fd write side of pipe
+ * @param buff
+ * @param size
+ * @return Stream_Result Stream_TransmitFailed if fd can not change to non-blocking mode
+ */
+Stream_Result OStream_initSplice(StreamOut* stream, OStream_Splice* splice, int fd, uint8_t* buff, Stream_LenType size) {
+    splice->Fd = fd;
+    splice->InPipe = 0;
+    OStream_init(stream, OStream_transmitSplice, buff, size);
+    OStream_setDriverArgs(stream, splice);
+    return StreamFd_setNonBlocking(fd) == 0 ? Stream_Ok : Stream_TransmitFailed;
+}
+/**
+ * @brief release bytes consumed by pipe reader with OStream_handle, then splice new bytes,
+ * call periodically or when pipe is writable, ex: after poll/epoll
+ *
+ * @param stream
+ * @return Stream_Result Stream_Ok, Stream_TransmitFailed on error
+ */
+Stream_Result OStream_handleSplice(StreamOut* stream) {
+    OStream_Splice* splice = OStream_getSplice(stream);
+    Stream_Result res;
+    int queued;
+    __mutexVarInit();
+    __mutexLock(&stream->Buffer);
+
+    if (!stream->Buffer.InTransmit) {
+        res = OStream_flush(stream);
+    }
+    else if (ioctl(splice->Fd, FIONREAD, &queued) != 0) {
+        stream->Buffer.InTransmit = 0;
+        res = Stream_TransmitFailed;
+    }
+    else if ((Stream_LenType) queued < splice->InPipe) {
+        // reader consumed oldest bytes, pages can reuse
+        Stream_LenType released = splice->InPipe - (Stream_LenType) queued;
+        splice->InPipe = (Stream_LenType) queued;
+        res = OStream_handle(stream, released);
+    }
+    else {
+        res = OStream_spliceFd(stream);
+    }
+
+    __mutexUnlock(&stream->Buffer);
+    // all bytes released
+    return res == Stream_NoAvailable ? Stream_Ok : res;
+}
+#endif // OSTREAM && STREAM_FD_SPLICE
+
+#endif // STREAM_FD
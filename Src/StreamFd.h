@@ -0,0 +1,71 @@
+/**
+ * @file StreamFd.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement POSIX file descriptor driver for InputStream and OutputStream
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_FD_H_
+#define _STREAM_FD_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_FD_VER_MAJOR    0
+#define STREAM_FD_VER_MINOR    1
+#define STREAM_FD_VER_FIX      0
+
+#include "StreamBuffer.h"
+#include "InputStream.h"
+#include "OutputStream.h"
+
+#if STREAM_FD
+
+#include <stdint.h>
+
+/**
+ * @brief show stream fd version in string format
+ */
+#define STREAM_FD_VER_STR                   _STREAM_VER_STR(STREAM_FD_VER_MAJOR, STREAM_FD_VER_MINOR, STREAM_FD_VER_FIX)
+/**
+ * @brief show stream fd version in integer format, ex: 0.2.0 -> 200
+ */
+#define STREAM_FD_VER                       ((STREAM_FD_VER_MAJOR * 10000UL) + (STREAM_FD_VER_MINOR * 100UL) + (STREAM_FD_VER_FIX))
+
+#if ISTREAM
+    Stream_Result   IStream_initFd(StreamIn* stream, int fd, uint8_t* buff, Stream_LenType size);
+    Stream_Result   IStream_handleFd(StreamIn* stream);
+    #define         IStream_getFd(STREAM)                                   ((int) (intptr_t) IStream_getDriverArgs((STREAM)))
+#endif // ISTREAM
+
+#if OSTREAM
+    Stream_Result   OStream_initFd(StreamOut* stream, int fd, uint8_t* buff, Stream_LenType size);
+    Stream_Result   OStream_handleFd(StreamOut* stream);
+    #define         OStream_getFd(STREAM)                                   ((int) (intptr_t) OStream_getDriverArgs((STREAM)))
+#endif // OSTREAM
+
+#if OSTREAM && STREAM_FD_SPLICE
+/**
+ * @brief hold state of OStream over pipe with vmsplice, must be valid while stream used
+ */
+typedef struct {
+    int                     Fd;             /**< write side of pipe */
+    Stream_LenType          InPipe;         /**< bytes referenced by pipe and not consumed by reader yet */
+} OStream_Splice;
+
+    Stream_Result   OStream_initSplice(StreamOut* stream, OStream_Splice* splice, int fd, uint8_t* buff, Stream_LenType size);
+    Stream_Result   OStream_handleSplice(StreamOut* stream);
+    #define         OStream_getSplice(STREAM)                               ((OStream_Splice*) OStream_getDriverArgs((STREAM)))
+#endif // OSTREAM && STREAM_FD_SPLICE
+
+#endif // STREAM_FD
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_FD_H_
@@ -0,0 +1,172 @@
+/**
+ * @file StreamLock.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement recursive locks for stream mutex, pthread mutex,
+ * pthread spinlock and C11 atomic_flag spin-then-yield lock,
+ * used by StreamMutex.h drivers and inlined in STREAM_MUTEX_BUILT_IN mode
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_LOCK_H_
+#define _STREAM_LOCK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "StreamConfig.h"
+
+#if STREAM_MUTEX_POSIX
+
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+/**
+ * @brief pthread mutex with PTHREAD_MUTEX_RECURSIVE type
+ */
+typedef pthread_mutex_t StreamLock_Pthread;
+/**
+ * @brief pthread spinlock, owner and depth make it recursive
+ */
+typedef struct {
+    pthread_spinlock_t      Lock;
+    _Atomic uintptr_t       Owner;          /**< owner thread, 0 when unlocked */
+    uint32_t                Depth;          /**< nested lock count of owner */
+} StreamLock_Spin;
+/**
+ * @brief atomic_flag lock, spin STREAM_MUTEX_SPIN_COUNT times then yield thread,
+ * owner and depth make it recursive
+ */
+typedef struct {
+    atomic_flag             Flag;
+    _Atomic uintptr_t       Owner;          /**< owner thread, 0 when unlocked */
+    uint32_t                Depth;          /**< nested lock count of owner */
+} StreamLock_Atomic;
+
+#define __streamLockSelf()                  ((uintptr_t) pthread_self())
+/* only owner thread can see its own id in Owner, other threads never match it */
+#define __streamLockIsOwner(L, SELF)        (atomic_load_explicit(&(L)->Owner, memory_order_relaxed) == (SELF))
+
+static inline int StreamLock_pthreadInit(StreamLock_Pthread* lock) {
+    pthread_mutexattr_t attr;
+    int res;
+    // stream functions lock again in nested calls, so mutex must be recursive
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    res = pthread_mutex_init(lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+    return res;
+}
+static inline int StreamLock_pthreadLock(StreamLock_Pthread* lock) {
+    return pthread_mutex_lock(lock);
+}
+static inline int StreamLock_pthreadUnlock(StreamLock_Pthread* lock) {
+    return pthread_mutex_unlock(lock);
+}
+static inline int StreamLock_pthreadDeInit(StreamLock_Pthread* lock) {
+    return pthread_mutex_destroy(lock);
+}
+
+static inline int StreamLock_spinInit(StreamLock_Spin* lock) {
+    atomic_init(&lock->Owner, 0);
+    lock->Depth = 0;
+    return pthread_spin_init(&lock->Lock, PTHREAD_PROCESS_PRIVATE);
+}
+static inline int StreamLock_spinLock(StreamLock_Spin* lock) {
+    uintptr_t self = __streamLockSelf();
+    int res;
+
+    if (__streamLockIsOwner(lock, self)) {
+        lock->Depth++;
+        return 0;
+    }
+    if ((res = pthread_spin_lock(&lock->Lock))) {
+        return res;
+    }
+    atomic_store_explicit(&lock->Owner, self, memory_order_relaxed);
+    lock->Depth = 1;
+    return 0;
+}
+static inline int StreamLock_spinUnlock(StreamLock_Spin* lock) {
+    if (--lock->Depth) {
+        return 0;
+    }
+    atomic_store_explicit(&lock->Owner, 0, memory_order_relaxed);
+    return pthread_spin_unlock(&lock->Lock);
+}
+static inline int StreamLock_spinDeInit(StreamLock_Spin* lock) {
+    return pthread_spin_destroy(&lock->Lock);
+}
+
+static inline int StreamLock_atomicInit(StreamLock_Atomic* lock) {
+    atomic_flag_clear_explicit(&lock->Flag, memory_order_relaxed);
+    atomic_init(&lock->Owner, 0);
+    lock->Depth = 0;
+    return 0;
+}
+static inline int StreamLock_atomicLock(StreamLock_Atomic* lock) {
+    uintptr_t self = __streamLockSelf();
+    unsigned spin = 0;
+
+    if (__streamLockIsOwner(lock, self)) {
+        lock->Depth++;
+        return 0;
+    }
+    while (atomic_flag_test_and_set_explicit(&lock->Flag, memory_order_acquire)) {
+        if (++spin >= STREAM_MUTEX_SPIN_COUNT) {
+            spin = 0;
+            sched_yield();
+        }
+    }
+    atomic_store_explicit(&lock->Owner, self, memory_order_relaxed);
+    lock->Depth = 1;
+    return 0;
+}
+static inline int StreamLock_atomicUnlock(StreamLock_Atomic* lock) {
+    if (--lock->Depth) {
+        return 0;
+    }
+    atomic_store_explicit(&lock->Owner, 0, memory_order_relaxed);
+    atomic_flag_clear_explicit(&lock->Flag, memory_order_release);
+    return 0;
+}
+static inline int StreamLock_atomicDeInit(StreamLock_Atomic* lock) {
+    (void) lock;
+    return 0;
+}
+
+/* lock selected for STREAM_MUTEX_BUILT_IN */
+#if   STREAM_MUTEX_BUILT_IN_LOCK == STREAM_MUTEX_LOCK_PTHREAD
+    typedef StreamLock_Pthread StreamLock;
+    #define StreamLock_init(L)                  StreamLock_pthreadInit((L))
+    #define StreamLock_lock(L)                  StreamLock_pthreadLock((L))
+    #define StreamLock_unlock(L)                StreamLock_pthreadUnlock((L))
+    #define StreamLock_deinit(L)                StreamLock_pthreadDeInit((L))
+#elif STREAM_MUTEX_BUILT_IN_LOCK == STREAM_MUTEX_LOCK_SPIN
+    typedef StreamLock_Spin StreamLock;
+    #define StreamLock_init(L)                  StreamLock_spinInit((L))
+    #define StreamLock_lock(L)                  StreamLock_spinLock((L))
+    #define StreamLock_unlock(L)                StreamLock_spinUnlock((L))
+    #define StreamLock_deinit(L)                StreamLock_spinDeInit((L))
+#elif STREAM_MUTEX_BUILT_IN_LOCK == STREAM_MUTEX_LOCK_ATOMIC
+    typedef StreamLock_Atomic StreamLock;
+    #define StreamLock_init(L)                  StreamLock_atomicInit((L))
+    #define StreamLock_lock(L)                  StreamLock_atomicLock((L))
+    #define StreamLock_unlock(L)                StreamLock_atomicUnlock((L))
+    #define StreamLock_deinit(L)                StreamLock_atomicDeInit((L))
+#else
+    #error "STREAM_MUTEX_BUILT_IN_LOCK is invalid!"
+#endif
+
+#endif // STREAM_MUTEX_POSIX
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_LOCK_H_
@@ -0,0 +1,207 @@
+#include "StreamLoop.h"
+
+#if STREAM_LOOP
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+
+/**
+ * @brief update epoll events of connection, EPOLLOUT only armed while output has pending bytes
+ *
+ * @param conn
+ * @param op EPOLL_CTL_ADD or EPOLL_CTL_MOD
+ * @return int 0 on success
+ */
+static int StreamLoop_ctl(StreamLoop_Conn* conn, int op) {
+    struct epoll_event ev;
+
+    ev.events = EPOLLET | EPOLLRDHUP;
+    if (conn->In) {
+        ev.events |= EPOLLIN;
+    }
+    if (conn->WaitWrite) {
+        ev.events |= EPOLLOUT;
+    }
+    ev.data.ptr = conn;
+    return epoll_ctl(conn->Loop->Fd, op, conn->Fd, &ev);
+}
+/**
+ * @brief remove connection and call close callback
+ *
+ * @param conn
+ */
+static void StreamLoop_close(StreamLoop_Conn* conn) {
+    StreamLoop_remove(conn);
+    if (conn->onClose) {
+        conn->onClose(conn);
+    }
+}
+/**
+ * @brief create epoll instance
+ *
+ * @param loop
+ * @return Stream_Result Stream_CustomError if epoll_create1 failed, errno show reason
+ */
+Stream_Result StreamLoop_init(StreamLoop* loop) {
+    loop->Count = 0;
+    loop->Fd = epoll_create1(EPOLL_CLOEXEC);
+    return loop->Fd >= 0 ? Stream_Ok : Stream_CustomError;
+}
+/**
+ * @brief close epoll instance, registered fds are not closed
+ *
+ * @param loop
+ */
+void StreamLoop_deinit(StreamLoop* loop) {
+    if (loop->Fd >= 0) {
+        close(loop->Fd);
+    }
+    loop->Fd = -1;
+    loop->Count = 0;
+}
+/**
+ * @brief register fd streams in loop in edge-triggered mode and start receive,
+ * in and out must use same fd, ex: socket, for pipes add each side as separate connection
+ *
+ * @param loop
+ * @param conn
+ * @param in initialized with IStream_initFd, can be NULL
+ * @param out initialized with OStream_initFd, can be NULL
+ * @return Stream_Result
+ */
+Stream_Result StreamLoop_add(StreamLoop* loop, StreamLoop_Conn* conn, StreamIn* in, StreamOut* out) {
+    if (!in && !out) {
+        return Stream_CustomError;
+    }
+    conn->Loop = loop;
+    conn->In = in;
+    conn->Out = out;
+    conn->onClose = 0;
+    conn->Args = 0;
+    conn->Fd = in ? IStream_getFd(in) : OStream_getFd(out);
+    conn->WaitWrite = 0;
+    conn->Closed = 0;
+    if (in && out && OStream_getFd(out) != conn->Fd) {
+        return Stream_CustomError;
+    }
+
+    if (StreamLoop_ctl(conn, EPOLL_CTL_ADD) != 0) {
+        return Stream_CustomError;
+    }
+    loop->Count++;
+    // edge-triggered, bytes received before register must read now
+    if (in) {
+        IStream_handleFd(in);
+    }
+    return Stream_Ok;
+}
+/**
+ * @brief remove connection from loop, fd is not closed and close callback not called
+ *
+ * @param conn
+ * @return Stream_Result
+ */
+Stream_Result StreamLoop_remove(StreamLoop_Conn* conn) {
+    if (conn->Closed) {
+        return Stream_Ok;
+    }
+    conn->Closed = 1;
+    conn->Loop->Count--;
+    return epoll_ctl(conn->Loop->Fd, EPOLL_CTL_DEL, conn->Fd, NULL) == 0 ? Stream_Ok : Stream_CustomError;
+}
+/**
+ * @brief read fd until EAGAIN or buffer full, onReceive callback called for each read,
+ * must call after read from full buffer outside of onReceive, no more edge come for bytes in fd
+ *
+ * @param conn
+ * @return Stream_Result Stream_Ok, Stream_NoSpace when buffer is full, Stream_ReceiveFailed on end of file or error
+ */
+Stream_Result StreamLoop_receive(StreamLoop_Conn* conn) {
+    Stream_Result res;
+
+    if (conn->Closed || !conn->In) {
+        return Stream_NoReceive;
+    }
+    res = IStream_handleFd(conn->In);
+    if (res == Stream_ReceiveFailed) {
+        StreamLoop_close(conn);
+    }
+    return res;
+}
+/**
+ * @brief write pending bytes until EAGAIN, arm EPOLLOUT only while bytes left in output,
+ * flush callback called when all bytes written
+ *
+ * @param conn
+ * @return Stream_Result Stream_Ok, Stream_TransmitFailed on error
+ */
+Stream_Result StreamLoop_flush(StreamLoop_Conn* conn) {
+    Stream_Result res;
+    uint8_t waitWrite;
+
+    if (conn->Closed || !conn->Out) {
+        return Stream_NoTransmit;
+    }
+    res = OStream_handleFd(conn->Out);
+    if (res != Stream_Ok) {
+        StreamLoop_close(conn);
+        return res;
+    }
+
+    waitWrite = OStream_pendingBytes(conn->Out) != 0;
+    if (conn->WaitWrite != waitWrite) {
+        conn->WaitWrite = waitWrite;
+        if (StreamLoop_ctl(conn, EPOLL_CTL_MOD) != 0) {
+            StreamLoop_close(conn);
+            return Stream_TransmitFailed;
+        }
+    }
+    return Stream_Ok;
+}
+/**
+ * @brief wait for events and handle them, connections closed by end of file or error
+ * removed and close callback called, connection can be freed in close callback,
+ * must not call in parallel with other functions of same loop
+ *
+ * @param loop
+ * @param timeout in milliseconds, -1 for wait forever, 0 for no wait
+ * @return int number of handled events, -1 on error
+ */
+int StreamLoop_run(StreamLoop* loop, int timeout) {
+    struct epoll_event events[STREAM_LOOP_EVENTS];
+    StreamLoop_Conn* conn;
+    uint32_t ev;
+    int count;
+    int i;
+
+    count = epoll_wait(loop->Fd, events, STREAM_LOOP_EVENTS, timeout);
+    if (count < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        conn = (StreamLoop_Conn*) events[i].data.ptr;
+        ev = events[i].events;
+
+        // read remaining bytes before hangup, end of file close connection,
+        // conn can be freed in onClose, so it's not touched after close
+        if (conn->In && (ev & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+            if (StreamLoop_receive(conn) == Stream_ReceiveFailed) {
+                continue;
+            }
+        }
+        if (conn->Out && !conn->Closed && (ev & (EPOLLOUT | EPOLLHUP | EPOLLERR))) {
+            if (StreamLoop_flush(conn) != Stream_Ok) {
+                continue;
+            }
+        }
+        if (!conn->Closed && (ev & EPOLLERR)) {
+            StreamLoop_close(conn);
+        }
+    }
+
+    return count;
+}
+
+#endif // STREAM_LOOP
@@ -0,0 +1,87 @@
+/**
+ * @file StreamLoop.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement epoll event loop for fd streams (StreamFd)
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_LOOP_H_
+#define _STREAM_LOOP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_LOOP_VER_MAJOR    0
+#define STREAM_LOOP_VER_MINOR    1
+#define STREAM_LOOP_VER_FIX      0
+
+#include "StreamFd.h"
+
+#if STREAM_LOOP
+
+/**
+ * @brief show stream loop version in string format
+ */
+#define STREAM_LOOP_VER_STR                 _STREAM_VER_STR(STREAM_LOOP_VER_MAJOR, STREAM_LOOP_VER_MINOR, STREAM_LOOP_VER_FIX)
+/**
+ * @brief show stream loop version in integer format, ex: 0.2.0 -> 200
+ */
+#define STREAM_LOOP_VER                     ((STREAM_LOOP_VER_MAJOR * 10000UL) + (STREAM_LOOP_VER_MINOR * 100UL) + (STREAM_LOOP_VER_FIX))
+
+typedef struct __StreamLoop_Conn StreamLoop_Conn;
+
+/**
+ * @brief call when connection closed by end of file or error and removed from loop,
+ * fd is not closed by loop, connection can be freed here, loop not touch it after callback
+ */
+typedef void (*StreamLoop_OnCloseFn)(StreamLoop_Conn* conn);
+
+/**
+ * @brief hold epoll instance
+ */
+typedef struct {
+    int                     Fd;             /**< epoll file descriptor */
+    uint32_t                Count;          /**< number of registered connections */
+} StreamLoop;
+
+/**
+ * @brief hold one fd with its input and output streams, must be valid while registered
+ */
+struct __StreamLoop_Conn {
+    StreamLoop*             Loop;
+    StreamIn*               In;             /**< initialized with IStream_initFd, can be NULL */
+    StreamOut*              Out;            /**< initialized with OStream_initFd, can be NULL */
+    StreamLoop_OnCloseFn    onClose;
+    void*                   Args;           /**< user arguments */
+    int                     Fd;
+    uint8_t                 WaitWrite;      /**< EPOLLOUT armed, output has pending bytes */
+    uint8_t                 Closed;
+};
+
+Stream_Result       StreamLoop_init(StreamLoop* loop);
+void                StreamLoop_deinit(StreamLoop* loop);
+int                 StreamLoop_run(StreamLoop* loop, int timeout);
+
+Stream_Result       StreamLoop_add(StreamLoop* loop, StreamLoop_Conn* conn, StreamIn* in, StreamOut* out);
+Stream_Result       StreamLoop_remove(StreamLoop_Conn* conn);
+Stream_Result       StreamLoop_receive(StreamLoop_Conn* conn);
+Stream_Result       StreamLoop_flush(StreamLoop_Conn* conn);
+
+#define             StreamLoop_onClose(CONN, FN)                            ((CONN)->onClose = (FN))
+#define             StreamLoop_setArgs(CONN, ARGS)                          ((CONN)->Args = (ARGS))
+#define             StreamLoop_getArgs(CONN)                                ((CONN)->Args)
+#define             StreamLoop_isClosed(CONN)                               ((CONN)->Closed)
+#define             StreamLoop_waitWrite(CONN)                              ((CONN)->WaitWrite)
+#define             StreamLoop_count(LOOP)                                  ((LOOP)->Count)
+
+#endif // STREAM_LOOP
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_LOOP_H_
@@ -0,0 +1,103 @@
+#include "StreamMutex.h"
+
+#if STREAM_MUTEX_POSIX && !defined(STREAM_MUTEX_TYPE) && (STREAM_MUTEX == STREAM_MUTEX_CUSTOM || STREAM_MUTEX == STREAM_MUTEX_DRIVER || STREAM_MUTEX == STREAM_MUTEX_GLOBAL_DRIVER)
+
+#include <stdlib.h>
+
+/* lock object allocated in init and released in deinit */
+static Stream_MutexResult StreamMutex_pthreadInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    StreamLock_Pthread* lock = (StreamLock_Pthread*) malloc(sizeof(StreamLock_Pthread));
+    Stream_MutexResult res;
+    if (!lock) {
+        return STREAM_MUTEX_NO_Function;
+    }
+    if ((res = StreamLock_pthreadInit(lock))) {
+        free(lock);
+        return res;
+    }
+    *mutex = lock;
+    return 0;
+}
+static Stream_MutexResult StreamMutex_pthreadLock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return StreamLock_pthreadLock((StreamLock_Pthread*) *mutex);
+}
+static Stream_MutexResult StreamMutex_pthreadUnlock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return StreamLock_pthreadUnlock((StreamLock_Pthread*) *mutex);
+}
+static Stream_MutexResult StreamMutex_pthreadDeInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    Stream_MutexResult res = StreamLock_pthreadDeInit((StreamLock_Pthread*) *mutex);
+    free(*mutex);
+    *mutex = (Stream_Mutex) 0;
+    return res;
+}
+static Stream_MutexResult StreamMutex_spinInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    StreamLock_Spin* lock = (StreamLock_Spin*) malloc(sizeof(StreamLock_Spin));
+    Stream_MutexResult res;
+    if (!lock) {
+        return STREAM_MUTEX_NO_Function;
+    }
+    if ((res = StreamLock_spinInit(lock))) {
+        free(lock);
+        return res;
+    }
+    *mutex = lock;
+    return 0;
+}
+static Stream_MutexResult StreamMutex_spinLock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return StreamLock_spinLock((StreamLock_Spin*) *mutex);
+}
+static Stream_MutexResult StreamMutex_spinUnlock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return StreamLock_spinUnlock((StreamLock_Spin*) *mutex);
+}
+static Stream_MutexResult StreamMutex_spinDeInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    Stream_MutexResult res = StreamLock_spinDeInit((StreamLock_Spin*) *mutex);
+    free(*mutex);
+    *mutex = (Stream_Mutex) 0;
+    return res;
+}
+static Stream_MutexResult StreamMutex_atomicInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    StreamLock_Atomic* lock = (StreamLock_Atomic*) malloc(sizeof(StreamLock_Atomic));
+    Stream_MutexResult res;
+    if (!lock) {
+        return STREAM_MUTEX_NO_Function;
+    }
+    if ((res = StreamLock_atomicInit(lock))) {
+        free(lock);
+        return res;
+    }
+    *mutex = lock;
+    return 0;
+}
+static Stream_MutexResult StreamMutex_atomicLock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return StreamLock_atomicLock((StreamLock_Atomic*) *mutex);
+}
+static Stream_MutexResult StreamMutex_atomicUnlock(StreamBuffer* stream, Stream_Mutex* mutex) {
+    return StreamLock_atomicUnlock((StreamLock_Atomic*) *mutex);
+}
+static Stream_MutexResult StreamMutex_atomicDeInit(StreamBuffer* stream, Stream_Mutex* mutex) {
+    Stream_MutexResult res = StreamLock_atomicDeInit((StreamLock_Atomic*) *mutex);
+    free(*mutex);
+    *mutex = (Stream_Mutex) 0;
+    return res;
+}
+
+const Stream_MutexDriver STREAM_MUTEX_PTHREAD_DRIVER = {
+    StreamMutex_pthreadInit,
+    StreamMutex_pthreadLock,
+    StreamMutex_pthreadUnlock,
+    StreamMutex_pthreadDeInit,
+};
+const Stream_MutexDriver STREAM_MUTEX_SPIN_DRIVER = {
+    StreamMutex_spinInit,
+    StreamMutex_spinLock,
+    StreamMutex_spinUnlock,
+    StreamMutex_spinDeInit,
+};
+const Stream_MutexDriver STREAM_MUTEX_ATOMIC_DRIVER = {
+    StreamMutex_atomicInit,
+    StreamMutex_atomicLock,
+    StreamMutex_atomicUnlock,
+    StreamMutex_atomicDeInit,
+};
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file StreamMutex.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement bundled mutex drivers for StreamBuffer over StreamLock.h locks
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_MUTEX_H_
+#define _STREAM_MUTEX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_MUTEX_VER_MAJOR    0
+#define STREAM_MUTEX_VER_MINOR    1
+#define STREAM_MUTEX_VER_FIX      0
+
+#include "StreamBuffer.h"
+#include "StreamLock.h"
+
+/**
+ * @brief show stream mutex version in string format
+ */
+#define STREAM_MUTEX_VER_STR                _STREAM_VER_STR(STREAM_MUTEX_VER_MAJOR, STREAM_MUTEX_VER_MINOR, STREAM_MUTEX_VER_FIX)
+/**
+ * @brief show stream mutex version in integer format, ex: 0.2.0 -> 200
+ */
+#define STREAM_MUTEX_VER                    ((STREAM_MUTEX_VER_MAJOR * 10000UL) + (STREAM_MUTEX_VER_MINOR * 100UL) + (STREAM_MUTEX_VER_FIX))
+
+#if STREAM_MUTEX_POSIX && !defined(STREAM_MUTEX_TYPE) && (STREAM_MUTEX == STREAM_MUTEX_CUSTOM || STREAM_MUTEX == STREAM_MUTEX_DRIVER || STREAM_MUTEX == STREAM_MUTEX_GLOBAL_DRIVER)
+
+/**
+ * @brief recursive drivers, init allocate lock object and store it in Stream_Mutex,
+ * deinit release it, ex: Stream_setMutex(&stream, &STREAM_MUTEX_ATOMIC_DRIVER); Stream_mutexInit(&stream);
+ */
+extern const Stream_MutexDriver STREAM_MUTEX_PTHREAD_DRIVER;
+extern const Stream_MutexDriver STREAM_MUTEX_SPIN_DRIVER;
+extern const Stream_MutexDriver STREAM_MUTEX_ATOMIC_DRIVER;
+
+#endif
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_MUTEX_H_
@@ -0,0 +1,142 @@
+#include "StreamPipeline.h"
+
+#if STREAM_PIPELINE
+
+/* state of filter after run */
+#define __FILTER_DONE                               0   /**< input empty, in flush nothing pending */
+#define __FILTER_FULL                               1   /**< output ring is full */
+#define __FILTER_WAIT                               2   /**< input left but filter need more bytes */
+
+/**
+ * @brief initialize filter
+ *
+ * @param filter
+ * @param process
+ * @param out output ring, must be initialized
+ * @param args filter state
+ */
+void Stream_filterInit(Stream_Filter* filter, Stream_FilterFn process, StreamBuffer* out, void* args) {
+    filter->Process = process;
+    filter->Out = out;
+    filter->Args = args;
+}
+/**
+ * @brief initialize pipeline, output of each filter is input of next filter
+ *
+ * @param pipe
+ * @param in input ring of first filter
+ * @param filters array of initialized filters
+ * @param count number of filters
+ */
+void Stream_pipelineInit(Stream_Pipeline* pipe, StreamBuffer* in, Stream_Filter* filters, uint8_t count) {
+    pipe->In = in;
+    pipe->Filters = filters;
+    pipe->Count = count;
+}
+/**
+ * @brief call filter over segments of in and space of out until output is full or filter stop progress,
+ * filter called with empty input too, so it can write bytes that not fit before
+ */
+static Stream_Result Stream_filterRun(Stream_Filter* filter, StreamBuffer* in, uint8_t flush, uint8_t* state, uint8_t* progress) {
+    Stream_FilterIo io;
+    Stream_LenType len;
+    Stream_Result res;
+
+    for (;;) {
+        // direct lengths ignore limits, so clamp them
+        io.InLen = Stream_directAvailable(in);
+        len = Stream_available(in);
+        if (io.InLen > len) {
+            io.InLen = len;
+        }
+        io.OutLen = Stream_directSpace(filter->Out);
+        len = Stream_space(filter->Out);
+        if (io.OutLen > len) {
+            io.OutLen = len;
+        }
+        io.Flush = flush && io.InLen == 0;
+
+        if (io.OutLen == 0) {
+            *state = io.InLen || io.Flush ? __FILTER_FULL : __FILTER_DONE;
+            break;
+        }
+
+        io.In = Stream_getReadPtr(in);
+        io.Out = Stream_getWritePtr(filter->Out);
+        io.Consumed = 0;
+        io.Produced = 0;
+        if ((res = filter->Process(filter, &io)) != Stream_Ok) {
+            return res;
+        }
+        if (io.Consumed == 0 && io.Produced == 0) {
+            *state = io.InLen ? __FILTER_WAIT : __FILTER_DONE;
+            break;
+        }
+        if (io.Consumed) {
+            Stream_moveReadPos(in, io.Consumed);
+        }
+        if (io.Produced) {
+            Stream_moveWritePos(filter->Out, io.Produced);
+        }
+        *progress = 1;
+    }
+    return Stream_Ok;
+}
+/**
+ * @brief run filters in order until none of them can progress,
+ * flush reach each filter only after filters before it flushed
+ */
+static Stream_Result Stream_pipelineStep(Stream_Pipeline* pipe, uint8_t flush) {
+    StreamBuffer* in;
+    Stream_Result res;
+    uint8_t progress;
+    uint8_t flushed;
+    uint8_t state;
+    uint8_t full;
+    uint8_t wait;
+    uint8_t i;
+
+    do {
+        progress = 0;
+        full = 0;
+        wait = 0;
+        flushed = flush;
+        in = pipe->In;
+        for (i = 0; i < pipe->Count; i++) {
+            if ((res = Stream_filterRun(&pipe->Filters[i], in, flushed, &state, &progress)) != Stream_Ok) {
+                return res;
+            }
+            full |= state == __FILTER_FULL;
+            wait |= state == __FILTER_WAIT;
+            flushed = flushed && state == __FILTER_DONE;
+            in = pipe->Filters[i].Out;
+        }
+    } while (progress);
+
+    return full ? Stream_NoSpace : wait ? Stream_NoAvailable : Stream_Ok;
+}
+/**
+ * @brief move bytes from input ring through filters as far as space of rings allow,
+ * when output ring is full bytes stay in previous rings and finally in input ring,
+ * call again after output consumed, ex: after OStream_flush
+ *
+ * @param pipe
+ * @return Stream_Result Stream_Ok all bytes passed, Stream_NoSpace a ring is full,
+ * Stream_NoAvailable filter wait for more input, or error of filter
+ */
+Stream_Result Stream_pipelineRun(Stream_Pipeline* pipe) {
+    return Stream_pipelineStep(pipe, 0);
+}
+/**
+ * @brief same as Stream_pipelineRun, then let each filter write its pending bytes,
+ * call again while it return Stream_NoSpace
+ *
+ * @param pipe
+ * @return Stream_Result Stream_Ok all filters flushed, Stream_NoSpace a ring is full,
+ * Stream_NoAvailable filter wait for more input, or error of filter
+ */
+Stream_Result Stream_pipelineFlush(Stream_Pipeline* pipe) {
+    return Stream_pipelineStep(pipe, 1);
+}
+
+#endif // STREAM_PIPELINE
@@ -0,0 +1,93 @@
+/**
+ * @file StreamPipeline.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement chain of length changing filters between ring buffers,
+ * each filter consume bytes of its input ring and produce bytes in its output ring in place,
+ * pipeline run filters only as far as space of next ring allow
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_PIPELINE_H_
+#define _STREAM_PIPELINE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_PIPELINE_VER_MAJOR    0
+#define STREAM_PIPELINE_VER_MINOR    1
+#define STREAM_PIPELINE_VER_FIX      0
+
+#include "StreamBuffer.h"
+
+#if STREAM_PIPELINE
+
+#include <stdint.h>
+
+/**
+ * @brief show stream pipeline version in string format
+ */
+#define STREAM_PIPELINE_VER_STR             _STREAM_VER_STR(STREAM_PIPELINE_VER_MAJOR, STREAM_PIPELINE_VER_MINOR, STREAM_PIPELINE_VER_FIX)
+/**
+ * @brief show stream pipeline version in integer format, ex: 0.2.0 -> 200
+ */
+#define STREAM_PIPELINE_VER                 ((STREAM_PIPELINE_VER_MAJOR * 10000UL) + (STREAM_PIPELINE_VER_MINOR * 100UL) + (STREAM_PIPELINE_VER_FIX))
+
+struct __Stream_Filter;
+typedef struct __Stream_Filter Stream_Filter;
+
+/**
+ * @brief one step of filter, In and Out point into rings, filter set Consumed and Produced
+ */
+typedef struct {
+    const uint8_t*          In;
+    uint8_t*                Out;
+    Stream_LenType          InLen;          /**< bytes in row at In */
+    Stream_LenType          OutLen;         /**< space in row at Out, never 0 */
+    Stream_LenType          Consumed;       /**< bytes of In used by filter, 0 before call */
+    Stream_LenType          Produced;       /**< bytes written to Out by filter, 0 before call */
+    uint8_t                 Flush;          /**< input ended, InLen is 0 and filter must write its pending bytes */
+} Stream_FilterIo;
+/**
+ * @brief process bytes, filter must make progress with any OutLen,
+ * bytes that not fit in Out stay in filter state and written in next call, InLen can be 0,
+ * return anything except Stream_Ok stop pipeline and returned to caller
+ */
+typedef Stream_Result (*Stream_FilterFn)(Stream_Filter* filter, Stream_FilterIo* io);
+/**
+ * @brief hold properties of filter, Out is input of next filter
+ */
+struct __Stream_Filter {
+    Stream_FilterFn         Process;
+    StreamBuffer*           Out;            /**< output ring, last filter can use OStream buffer */
+    void*                   Args;           /**< filter state */
+};
+/**
+ * @brief hold properties of pipeline, In -> Filters[0] -> Filters[0].Out -> ... -> Filters[Count - 1].Out
+ */
+typedef struct {
+    StreamBuffer*           In;
+    Stream_Filter*          Filters;
+    uint8_t                 Count;
+} Stream_Pipeline;
+
+void            Stream_filterInit(Stream_Filter* filter, Stream_FilterFn process, StreamBuffer* out, void* args);
+#define         Stream_filterGetArgs(FILTER)                                ((FILTER)->Args)
+#define         Stream_filterGetOut(FILTER)                                 ((FILTER)->Out)
+
+void            Stream_pipelineInit(Stream_Pipeline* pipe, StreamBuffer* in, Stream_Filter* filters, uint8_t count);
+Stream_Result   Stream_pipelineRun(Stream_Pipeline* pipe);
+Stream_Result   Stream_pipelineFlush(Stream_Pipeline* pipe);
+#define         Stream_pipelineGetIn(PIPE)                                  ((PIPE)->In)
+#define         Stream_pipelineGetOut(PIPE)                                 ((PIPE)->Filters[(PIPE)->Count - 1].Out)
+
+#endif // STREAM_PIPELINE
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_PIPELINE_H_
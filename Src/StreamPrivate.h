@@ -0,0 +1,44 @@
+/**
+ * @file StreamPrivate.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief private lock and limit macros shared by driver and codec modules,
+ * include only from source files after StreamBuffer.h
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_PRIVATE_H_
+#define _STREAM_PRIVATE_H_
+
+#if STREAM_MUTEX
+#if STREAM_MUTEX_CHECK_RESULT
+    #define __mutexVarInit()                        Stream_MutexResult mutexError
+    #define __mutexLock(S)                          if ((mutexError = Stream_mutexLock((S)))) { return Stream_MutexError | mutexError; }
+    #define __mutexUnlock(S)                        if ((mutexError = Stream_mutexUnlock((S)))) { return Stream_MutexError | mutexError; }
+#else
+    #define __mutexVarInit()
+    #define __mutexLock(S)                          Stream_mutexLock((S))
+    #define __mutexUnlock(S)                        Stream_mutexUnlock((S))
+#endif
+#else
+    #define __mutexVarInit()
+    #define __mutexLock(S)
+    #define __mutexUnlock(S)
+#endif
+
+// same as StreamBuffer.c, functions that move position directly must use up limit
+#if STREAM_WRITE_LIMIT
+    #define __writeLimit(S, LEN)                    if (Stream_isWriteLimited((S))) { (S)->WriteLimit -= (LEN); }
+#else
+    #define __writeLimit(S, LEN)
+#endif
+
+#if STREAM_READ_LIMIT
+    #define __readLimit(S, LEN)                     if (Stream_isReadLimited((S))) { (S)->ReadLimit -= (LEN); }
+#else
+    #define __readLimit(S, LEN)
+#endif
+
+#endif // _STREAM_PRIVATE_H_
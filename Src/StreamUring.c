@@ -0,0 +1,341 @@
+#include "StreamUring.h"
+
+#if STREAM_URING
+
+#if !STREAM_IO_VEC_POSIX || !STREAM_DRIVER_ARGS || !defined(__linux__)
+    #error "STREAM_URING need Linux, STREAM_IO_VEC_POSIX and STREAM_DRIVER_ARGS"
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "StreamPrivate.h"
+
+#define __sqes(U)                                   ((struct io_uring_sqe*) (U)->Sqes)
+#define __cqes(U)                                   ((struct io_uring_cqe*) (U)->Cqes)
+#define __ioBuffer(IO)                              ((IO)->Output ? &((StreamOut*) (IO)->Stream)->Buffer : &((StreamIn*) (IO)->Stream)->Buffer)
+
+static int StreamUring_setup(unsigned entries, struct io_uring_params* params) {
+    return (int) syscall(__NR_io_uring_setup, entries, params);
+}
+static int StreamUring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return (int) syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, NULL, 0);
+}
+/**
+ * @brief create io_uring instance and map submission and completion rings
+ *
+ * @param uring
+ * @param entries number of submission entries, kernel round up to power of 2
+ * @return Stream_Result Stream_CustomError if io_uring not supported, errno show reason
+ */
+Stream_Result StreamUring_init(StreamUring* uring, unsigned entries) {
+    struct io_uring_params params;
+    uint8_t* sq;
+    uint8_t* cq;
+
+    memset(uring, 0, sizeof(StreamUring));
+    memset(&params, 0, sizeof(params));
+    uring->Fd = StreamUring_setup(entries, &params);
+    if (uring->Fd < 0) {
+        return Stream_CustomError;
+    }
+
+    uring->SqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    uring->CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    // new kernels map both rings with single mmap
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (uring->CqRingSize > uring->SqRingSize) {
+            uring->SqRingSize = uring->CqRingSize;
+        }
+        uring->CqRingSize = 0;
+    }
+
+    sq = mmap(NULL, uring->SqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->Fd, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) {
+        close(uring->Fd);
+        return Stream_CustomError;
+    }
+    uring->SqRing = sq;
+
+    if (uring->CqRingSize) {
+        cq = mmap(NULL, uring->CqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->Fd, IORING_OFF_CQ_RING);
+        if (cq == MAP_FAILED) {
+            munmap(sq, uring->SqRingSize);
+            close(uring->Fd);
+            return Stream_CustomError;
+        }
+        uring->CqRing = cq;
+    }
+    else {
+        cq = sq;
+    }
+
+    uring->SqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    uring->Sqes = mmap(NULL, uring->SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, uring->Fd, IORING_OFF_SQES);
+    if (uring->Sqes == MAP_FAILED) {
+        StreamUring_deinit(uring);
+        return Stream_CustomError;
+    }
+
+    uring->SqHead = (unsigned*) (sq + params.sq_off.head);
+    uring->SqTail = (unsigned*) (sq + params.sq_off.tail);
+    uring->SqMask = (unsigned*) (sq + params.sq_off.ring_mask);
+    uring->SqEntries = (unsigned*) (sq + params.sq_off.ring_entries);
+    uring->SqArray = (unsigned*) (sq + params.sq_off.array);
+    uring->CqHead = (unsigned*) (cq + params.cq_off.head);
+    uring->CqTail = (unsigned*) (cq + params.cq_off.tail);
+    uring->CqMask = (unsigned*) (cq + params.cq_off.ring_mask);
+    uring->Cqes = cq + params.cq_off.cqes;
+    return Stream_Ok;
+}
+/**
+ * @brief unmap rings and close io_uring, requests in flight are canceled by kernel
+ *
+ * @param uring
+ */
+void StreamUring_deinit(StreamUring* uring) {
+    if (uring->Sqes && uring->Sqes != MAP_FAILED) {
+        munmap(uring->Sqes, uring->SqesSize);
+    }
+    if (uring->CqRing) {
+        munmap(uring->CqRing, uring->CqRingSize);
+    }
+    if (uring->SqRing) {
+        munmap(uring->SqRing, uring->SqRingSize);
+    }
+    if (uring->Fd >= 0) {
+        close(uring->Fd);
+    }
+    memset(uring, 0, sizeof(StreamUring));
+    uring->Fd = -1;
+}
+/**
+ * @brief submit queued requests to kernel without wait
+ *
+ * @param uring
+ * @return int number of submitted requests, -1 on error
+ */
+int StreamUring_submit(StreamUring* uring) {
+    int ret;
+
+    if (uring->Queued == 0) {
+        return 0;
+    }
+    do {
+        ret = StreamUring_enter(uring->Fd, uring->Queued, 0, 0);
+    } while (ret < 0 && errno == EINTR);
+
+    if (ret > 0) {
+        uring->Queued -= (unsigned) ret;
+    }
+    return ret;
+}
+/**
+ * @brief queue readv/writev request for both segments of stream,
+ * request submitted on next StreamUring_poll or when submission ring is full
+ *
+ * @param io
+ * @return Stream_Result
+ */
+static Stream_Result StreamUring_queue(StreamUring_Io* io) {
+    StreamUring* uring = io->Uring;
+    StreamBuffer* buf = __ioBuffer(io);
+    struct io_uring_sqe* sqe;
+    unsigned tail;
+    unsigned index;
+
+    if (io->Output) {
+        io->Count = Stream_getReadVec(buf, 0, Stream_available(buf), io->Vec);
+    }
+    else {
+        io->Count = Stream_getWriteVec(buf, 0, Stream_space(buf), io->Vec);
+    }
+    // IStream_handle/OStream_handle limit bytes to pending bytes, so cover both segments
+    buf->PendingBytes = (Stream_LenType) (io->Vec[0].iov_len + (io->Count > 1 ? io->Vec[1].iov_len : 0));
+
+    tail = *uring->SqTail;
+    if (tail - __atomic_load_n(uring->SqHead, __ATOMIC_ACQUIRE) >= *uring->SqEntries) {
+        if (StreamUring_submit(uring) <= 0) {
+            // nothing queued, let next receive/flush retry
+            buf->PendingBytes = 0;
+            if (io->Output) {
+                buf->InTransmit = 0;
+                return Stream_TransmitFailed;
+            }
+            else {
+                buf->InReceive = 0;
+                return Stream_ReceiveFailed;
+            }
+        }
+    }
+
+    index = tail & *uring->SqMask;
+    sqe = &__sqes(uring)[index];
+    memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->opcode = io->Output ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = io->Fd;
+    sqe->addr = (uint64_t) (uintptr_t) io->Vec;
+    sqe->len = io->Count;
+    // current file position, required for pipes and sockets
+    sqe->off = (uint64_t) -1;
+    sqe->user_data = (uint64_t) (uintptr_t) io;
+    uring->SqArray[index] = index;
+    __atomic_store_n(uring->SqTail, tail + 1, __ATOMIC_RELEASE);
+    uring->Queued++;
+    return Stream_Ok;
+}
+/**
+ * @brief handle one completion of stream, successful request queue next one
+ *
+ * @param io
+ * @param res result of readv/writev, negative errno on error
+ * @return Stream_Result
+ */
+static Stream_Result StreamUring_complete(StreamUring_Io* io, int32_t res) {
+    StreamBuffer* buf = __ioBuffer(io);
+    Stream_Result ret;
+    __mutexVarInit();
+    __mutexLock(buf);
+
+    if (res > 0) {
+        if (io->Output) {
+            ret = OStream_handle((StreamOut*) io->Stream, (Stream_LenType) res);
+            // all bytes flushed
+            if (ret == Stream_NoAvailable) {
+                ret = Stream_Ok;
+            }
+        }
+        else {
+            ret = IStream_handle((StreamIn*) io->Stream, (Stream_LenType) res);
+        }
+    }
+    else if (res == -EAGAIN || res == -EINTR) {
+        ret = StreamUring_queue(io);
+    }
+    else {
+        // end of file or error
+        io->Error = -res;
+        io->Closed = 1;
+        if (io->Output) {
+            buf->InTransmit = 0;
+            ret = Stream_TransmitFailed;
+        }
+        else {
+            buf->InReceive = 0;
+            ret = Stream_ReceiveFailed;
+        }
+    }
+
+    __mutexUnlock(buf);
+    return ret;
+}
+/**
+ * @brief submit queued requests and wait for at least waitNr completions with single
+ * io_uring_enter, then handle all completions, must not call in parallel with
+ * other functions of same uring
+ *
+ * @param uring
+ * @param waitNr minimum completions to wait for, 0 for no wait
+ * @return int number of handled completions, -1 on error
+ */
+int StreamUring_poll(StreamUring* uring, unsigned waitNr) {
+    struct io_uring_cqe* cqe;
+    unsigned head;
+    int count = 0;
+    int ret;
+
+    if (uring->Queued || waitNr) {
+        do {
+            ret = StreamUring_enter(uring->Fd, uring->Queued, waitNr, waitNr ? IORING_ENTER_GETEVENTS : 0);
+        } while (ret < 0 && errno == EINTR);
+        if (ret < 0) {
+            return -1;
+        }
+        uring->Queued -= (unsigned) ret;
+    }
+
+    head = *uring->CqHead;
+    while (head != __atomic_load_n(uring->CqTail, __ATOMIC_ACQUIRE)) {
+        StreamUring_Io* io;
+        int32_t res;
+
+        cqe = &__cqes(uring)[head & *uring->CqMask];
+        io = (StreamUring_Io*) (uintptr_t) cqe->user_data;
+        res = cqe->res;
+        // release entry before handle, handler may queue new request
+        __atomic_store_n(uring->CqHead, ++head, __ATOMIC_RELEASE);
+
+        StreamUring_complete(io, res);
+        count++;
+    }
+
+    return count;
+}
+
+#if ISTREAM
+/**
+ * @brief receive function of uring driver, buff and len ignored and both segments filled
+ */
+static Stream_Result IStream_receiveUring(StreamIn* stream, uint8_t* buff, Stream_LenType len) {
+    return StreamUring_queue((StreamUring_Io*) IStream_getDriverArgs(stream));
+}
+/**
+ * @brief initialize input stream over file descriptor and io_uring, fd can be blocking,
+ * call IStream_receive to start receive and again after read when buffer was full
+ *
+ * @param stream
+ * @param io context of stream, must be valid while stream used
+ * @param uring
+ * @param fd file descriptor, ex: pipe, socket, file
+ * @param buff
+ * @param size
+ * @return Stream_Result
+ */
+Stream_Result IStream_initUring(StreamIn* stream, StreamUring_Io* io, StreamUring* uring, int fd, uint8_t* buff, Stream_LenType size) {
+    memset(io, 0, sizeof(StreamUring_Io));
+    io->Uring = uring;
+    io->Stream = stream;
+    io->Fd = fd;
+    io->Output = 0;
+    IStream_init(stream, IStream_receiveUring, buff, size);
+    IStream_setDriverArgs(stream, io);
+    return Stream_Ok;
+}
+#endif // ISTREAM
+
+#if OSTREAM
+/**
+ * @brief transmit function of uring driver, buff and len ignored and both segments written
+ */
+static Stream_Result OStream_transmitUring(StreamOut* stream, uint8_t* buff, Stream_LenType len) {
+    return StreamUring_queue((StreamUring_Io*) OStream_getDriverArgs(stream));
+}
+/**
+ * @brief initialize output stream over file descriptor and io_uring, fd can be blocking,
+ * call OStream_flush to start transmit
+ *
+ * @param stream
+ * @param io context of stream, must be valid while stream used
+ * @param uring
+ * @param fd file descriptor, ex: pipe, socket, file
+ * @param buff
+ * @param size
+ * @return Stream_Result
+ */
+Stream_Result OStream_initUring(StreamOut* stream, StreamUring_Io* io, StreamUring* uring, int fd, uint8_t* buff, Stream_LenType size) {
+    memset(io, 0, sizeof(StreamUring_Io));
+    io->Uring = uring;
+    io->Stream = stream;
+    io->Fd = fd;
+    io->Output = 1;
+    OStream_init(stream, OStream_transmitUring, buff, size);
+    OStream_setDriverArgs(stream, io);
+    return Stream_Ok;
+}
+#endif // OSTREAM
+
+#endif // STREAM_URING
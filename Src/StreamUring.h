@@ -0,0 +1,97 @@
+/**
+ * @file StreamUring.h
+ * @author Ali Mirghasemi (ali.mirghasemi1376@gmail.com)
+ * @brief this library implement Linux io_uring driver for InputStream and OutputStream
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef _STREAM_URING_H_
+#define _STREAM_URING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STREAM_URING_VER_MAJOR    0
+#define STREAM_URING_VER_MINOR    1
+#define STREAM_URING_VER_FIX      0
+
+#include "StreamBuffer.h"
+#include "InputStream.h"
+#include "OutputStream.h"
+
+#if STREAM_URING
+
+/**
+ * @brief show stream uring version in string format
+ */
+#define STREAM_URING_VER_STR                _STREAM_VER_STR(STREAM_URING_VER_MAJOR, STREAM_URING_VER_MINOR, STREAM_URING_VER_FIX)
+/**
+ * @brief show stream uring version in integer format, ex: 0.2.0 -> 200
+ */
+#define STREAM_URING_VER                    ((STREAM_URING_VER_MAJOR * 10000UL) + (STREAM_URING_VER_MINOR * 100UL) + (STREAM_URING_VER_FIX))
+
+/**
+ * @brief hold io_uring instance, shared between many streams,
+ * rings are mapped from kernel and used without liburing
+ */
+typedef struct {
+    unsigned*               SqHead;
+    unsigned*               SqTail;
+    unsigned*               SqMask;
+    unsigned*               SqEntries;
+    unsigned*               SqArray;
+    void*                   Sqes;           /**< struct io_uring_sqe array */
+    unsigned*               CqHead;
+    unsigned*               CqTail;
+    unsigned*               CqMask;
+    void*                   Cqes;           /**< struct io_uring_cqe array */
+    void*                   SqRing;
+    void*                   CqRing;
+    size_t                  SqRingSize;
+    size_t                  CqRingSize;
+    size_t                  SqesSize;
+    unsigned                Queued;         /**< requests queued and not submitted yet */
+    int                     Fd;             /**< io_uring file descriptor */
+} StreamUring;
+
+/**
+ * @brief hold state of one stream over io_uring, must be valid while request is in flight
+ */
+typedef struct {
+    StreamUring*            Uring;
+    void*                   Stream;         /**< StreamIn or StreamOut */
+    Stream_IoVec            Vec[2];         /**< segments of request, kernel read them at submit */
+    int                     Fd;
+    int                     Error;          /**< errno of last failed request, 0 for end of file */
+    uint8_t                 Count;          /**< number of segments in Vec */
+    uint8_t                 Output;         /**< 1 for OStream, 0 for IStream */
+    uint8_t                 Closed;         /**< end of file or request failed, Error show reason */
+} StreamUring_Io;
+
+Stream_Result       StreamUring_init(StreamUring* uring, unsigned entries);
+void                StreamUring_deinit(StreamUring* uring);
+int                 StreamUring_submit(StreamUring* uring);
+int                 StreamUring_poll(StreamUring* uring, unsigned waitNr);
+
+#define             StreamUring_isClosed(IO)                                ((IO)->Closed)
+#define             StreamUring_getError(IO)                                ((IO)->Error)
+
+#if ISTREAM
+    Stream_Result   IStream_initUring(StreamIn* stream, StreamUring_Io* io, StreamUring* uring, int fd, uint8_t* buff, Stream_LenType size);
+#endif // ISTREAM
+
+#if OSTREAM
+    Stream_Result   OStream_initUring(StreamOut* stream, StreamUring_Io* io, StreamUring* uring, int fd, uint8_t* buff, Stream_LenType size);
+#endif // OSTREAM
+
+#endif // STREAM_URING
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif // _STREAM_URING_H_
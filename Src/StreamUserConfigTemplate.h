@@ -72,13 +72,48 @@
  * @brief If you want to use IStream/OStream you must enable this feature
  */
 //#define STREAM_PENDING_BYTES                1
+/**
+ * @brief large buffer mode, Stream_LenType become unsigned size_t
+ * so buffer size is not limited to 32KB, find functions return STREAM_NOT_FOUND
+ * and STREAM_NO_LIMIT is maximum value of Stream_LenType
+ */
+//#define STREAM_LEN_LARGE                    0
 /**
  * @brief based on maximum size of buffer that you use for stream
  * you can change type of len variables
- * must be signed type
+ * can be signed or unsigned type, -1 casted to Stream_LenType is reserved
+ * for STREAM_NOT_FOUND and STREAM_NO_LIMIT
  */
 //#define STREAM_LEN_TYPE
 //typedef int16_t Stream_LenType;
+/**
+ * @brief lock-free single producer/single consumer mode
+ * producer only change WPos and consumer only change RPos, both are C11 atomics
+ * with acquire/release ordering and there is no shared Overflow flag,
+ * so one byte of buffer always stay empty and usable capacity is Size - 1
+ * in this mode mutex is disabled by default, need C11 compiler
+ */
+//#define STREAM_SPSC                         0
+/**
+ * @brief buffer size must be power of two, index wrap use (Size - 1) mask instead of modulo
+ * Stream_init reject other sizes and initialize stream with zero size in this mode,
+ * Stream_initPow2 also return Stream_BadArgument
+ * use STREAM_BUFFER_POW2 to declare static buffers with compile time size check
+ */
+//#define STREAM_SIZE_POW2                    0
+/**
+ * @brief mirrored buffer support, Stream_initMirrored map same memory pages twice
+ * back to back, so read/write operations never split at end of buffer
+ * only supported on linux (memfd + mmap)
+ */
+//#define STREAM_MIRRORED                     0
+/**
+ * @brief bip-buffer mode, Stream_reserve never split a region, when tail of buffer is too short
+ * reservation wrap to start of buffer and end of data (watermark) recorded as lap end,
+ * readers wrap at watermark, so Stream_getReadPtr/Stream_directAvailable return whole reserved records
+ * need STREAM_WRITE_RESERVE, not supported with STREAM_SPSC and STREAM_SIZE_POW2
+ */
+//#define STREAM_BIP                          0
 // ---------------------------- Write APIs ------------------------------
 /**
  * @brief Enable Write operations
@@ -100,6 +135,10 @@
  * @brief enable write array apis
  */
 //#define STREAM_WRITE_ARRAY                  (1 && STREAM_WRITE)
+/**
+ * @brief enable Stream_writeUInt32ArrayPacked, stream-vbyte layout, control bytes then 1 to 4 bytes per value
+ */
+//#define STREAM_WRITE_ARRAY_PACKED           (1 && STREAM_WRITE_ARRAY && STREAM_UINT32)
 /**
  * @brief enable write stream apis
  */
@@ -120,6 +159,11 @@
  * @brief enable write lock feature for custom data types
  */
 //#define STREAM_WRITE_LOCK_CUSTOM            (1 && STREAM_WRITE_LOCK)
+/**
+ * @brief enable Stream_reserve/Stream_commit, reserve contiguous region of ring for
+ * write in place (ex: snprintf, encoders) and commit used bytes
+ */
+//#define STREAM_WRITE_RESERVE                (1 && STREAM_WRITE)
 
 // ---------------------------- Read APIs -------------------------------
 /**
@@ -142,10 +186,19 @@
  * @brief enable read array apis
  */
 //#define STREAM_READ_ARRAY                   (1 && STREAM_READ)
+/**
+ * @brief enable Stream_readUInt32ArrayPacked, SSSE3 shuffle decode when STREAM_MEM_SIMD enabled
+ */
+//#define STREAM_READ_ARRAY_PACKED            (1 && STREAM_READ_ARRAY && STREAM_UINT32)
 /**
  * @brief enable read stream apis
  */
 //#define STREAM_READ_STREAM                  (1 && STREAM_READ)
+/**
+ * @brief enable Stream_transfer, copy bytes between two streams in single pass with both
+ * streams locked, Stream_writeStream and Stream_readStream need it
+ */
+//#define STREAM_TRANSFER                     (1 && (STREAM_WRITE_STREAM || STREAM_READ_STREAM))
 /**
  * @brief enable flip read feature
  */
@@ -163,6 +216,14 @@
  */
 //#define STREAM_READ_LOCK_CUSTOM             (1 && STREAM_READ_LOCK)
 
+/**
+ * @brief enable Stream_beginWrite/Stream_endWrite and Stream_beginRead/Stream_endRead,
+ * lock taken once for many typed writes or reads, only thread that began transaction can
+ * write (read) until end, other threads blocked by lock, thread identified by STREAM_MUTEX_POSIX,
+ * without it calls in transaction take lock again, so mutex must be recursive
+ */
+//#define STREAM_TRANSACTION                  (1 && (STREAM_WRITE || STREAM_READ))
+
 // ----------------------------- Set APIs -------------------------------
 /**
  * @brief enable setAt functions
@@ -250,6 +311,21 @@
  * @brief enable findValueAt functions
  */
 //#define STREAM_FIND_AT_VALUE                (1 && STREAM_FIND_AT && STREAM_VALUE)
+/**
+ * @brief enable Stream_Pattern and findCompiledAt functions, pattern compiled once
+ * with Two-Way critical factorization and skip table, search is linear in stream length
+ */
+//#define STREAM_FIND_COMPILED_AT             (1 && STREAM_FIND_AT)
+/**
+ * @brief enable findAnyOfAt functions, find first byte that is in given set of bytes,
+ * use SSSE3/AVX2 nibble lookup when STREAM_MEM_SIMD enabled
+ */
+//#define STREAM_FIND_ANY_OF_AT               (1 && STREAM_FIND_AT)
+/**
+ * @brief enable Stream_SearchState and find/readBytesUntil Resume functions,
+ * next search continue from last scanned byte instead of RPos
+ */
+//#define STREAM_FIND_RESUME                  (1 && STREAM_FIND_AT)
 
 // ----------------------------- Find APIs ------------------------------
 /**
@@ -277,6 +353,29 @@
  */
 //#define STREAM_TRANSPOSE                    (1 && STREAM_TRANSPOSE_AT)
 
+// --------------------------- VarInt APIs ------------------------------
+/**
+ * @brief enable LEB128 varint and ZigZag signed varint encoding,
+ * values up to 64bit when STREAM_UINT64 enabled else up to 32bit
+ */
+//#define STREAM_VAR_INT                      (1 && STREAM_UINT32)
+/**
+ * @brief enable writeVar functions
+ */
+//#define STREAM_WRITE_VAR_INT                (1 && STREAM_WRITE && STREAM_VAR_INT)
+/**
+ * @brief enable readVar functions
+ */
+//#define STREAM_READ_VAR_INT                 (1 && STREAM_READ && STREAM_VAR_INT)
+/**
+ * @brief enable getVarAt functions
+ */
+//#define STREAM_GET_AT_VAR_INT               (1 && STREAM_GET_AT && STREAM_VAR_INT)
+/**
+ * @brief enable findVarAt functions
+ */
+//#define STREAM_FIND_AT_VAR_INT              (1 && STREAM_FIND_AT && STREAM_VAR_INT)
+
 
 // -------------------------- ByteOrder APIs ----------------------------
 /**
@@ -296,6 +395,29 @@
  */
 //#define STREAM_CURSOR                       1
 
+// --------------------------- IoVec APIs -------------------------------
+/**
+ * @brief enable getReadVec/getWriteVec functions, return one or two segments
+ * of buffer that cover a region for readv/writev and zero copy parsing
+ */
+//#define STREAM_IO_VEC                       1
+/**
+ * @brief Stream_IoVec is same as POSIX struct iovec, so vectors can pass directly to readv/writev
+ */
+//#define STREAM_IO_VEC_POSIX                 (1 && STREAM_IO_VEC)
+
+// ---------------------------- Frame APIs ------------------------------
+/**
+ * @brief enable length-prefixed frames, Stream_writeFrame, Stream_beginFrame/Stream_endFrame
+ * for encode in place, Stream_peekFrame/Stream_popFrame and Stream_beginFrames iterator,
+ * header byte order follow Stream_setByteOrder (little endian without STREAM_BYTE_ORDER)
+ */
+//#define STREAM_FRAME                        (1 && STREAM_WRITE && STREAM_READ && STREAM_IO_VEC && !STREAM_SPSC)
+/**
+ * @brief default frame header width in bytes (1, 2 or 4), can change with Stream_setFrameHeader
+ */
+//#define STREAM_FRAME_HEADER_LEN             2
+
 // ---------------------------- MemIO APIs ------------------------------
 /**
  * @brief This features help you to override memcpy, memrcpy, memset and etc with your custom functions
@@ -306,16 +428,38 @@
 //#define STREAM_MEM_COPY_REVERSE             memrcpy
 //#define STREAM_MEM_SET                      memset
 //#define STREAM_MEM_REVERSE                  memreverse
+//#define STREAM_MEM_SWAP_COPY                memswapcpy
 /**
- * @brief Implement built in mem utils function for `memrcpy`, `memreverse
+ * @brief Implement built in mem utils function for `memrcpy`, `memreverse`, `memswapcpy`
  */
 //#define STREAM_MEM_IO_BUILT_IN              (1 && (STREAM_MEM_IO == STREAM_MEM_IO_DEFAULT))
+/**
+ * @brief use SSSE3/AVX2 kernels in built in mem utils on x86 with GCC/Clang,
+ * cpu features detect at runtime and scalar code used as fallback
+ */
+//#define STREAM_MEM_SIMD                     (1 && STREAM_MEM_IO_BUILT_IN)
 
 // ---------------------------- Mutex APIs ------------------------------
 /**
  * @brief If you want mutex for thread safety
+ * in STREAM_SPSC mode default is STREAM_MUTEX_NONE
+ * STREAM_MUTEX_BUILT_IN inline lock selected by STREAM_MUTEX_BUILT_IN_LOCK into stream functions
+ * without driver, Stream_Mutex become lock object itself and Stream_init initialize it
  */
 //#define STREAM_MUTEX                        STREAM_MUTEX_DRIVER
+/**
+ * @brief enable bundled recursive locks in StreamLock.h and mutex drivers in StreamMutex.h,
+ * pthread mutex, pthread spinlock and C11 atomic_flag spin-then-yield lock, need POSIX threads
+ */
+//#define STREAM_MUTEX_POSIX              (1 && STREAM_MUTEX)
+/**
+ * @brief lock that inlined in STREAM_MUTEX_BUILT_IN mode
+ */
+//#define STREAM_MUTEX_BUILT_IN_LOCK      STREAM_MUTEX_LOCK_PTHREAD
+/**
+ * @brief number of failed tries of atomic lock before yield thread
+ */
+//#define STREAM_MUTEX_SPIN_COUNT         64
 /**
  * @brief Mutex check result for every functions
  */
@@ -379,4 +523,74 @@
  */
 //#define ISTREAM_FULL_CALLBACK       1
 
+/************************************************************************/
+/*                                StreamFd                              */
+/************************************************************************/
+
+/**
+ * @brief enable POSIX file descriptor driver for IStream/OStream,
+ * use non-blocking readv/writev over both segments of buffer
+ */
+//#define STREAM_FD                   (1 && STREAM_IO_VEC_POSIX && STREAM_DRIVER_ARGS && (ISTREAM || OSTREAM))
+/**
+ * @brief enable zero-copy OStream transmit to pipes with vmsplice in StreamFd.h, Linux only,
+ * ring bytes stay referenced by pipe and released from OStream only after pipe reader consume them
+ */
+//#define STREAM_FD_SPLICE            0
+/**
+ * @brief enable Linux io_uring driver for IStream/OStream in StreamUring.h,
+ * receive and flush post readv/writev requests and StreamUring_poll handle completions of many streams
+ */
+//#define STREAM_URING                0
+/**
+ * @brief enable epoll event loop in StreamLoop.h, drive many fd streams (StreamFd) in single thread,
+ * only for Linux
+ */
+//#define STREAM_LOOP                 (1 && STREAM_FD && ISTREAM && OSTREAM)
+/**
+ * @brief maximum events handled by each StreamLoop_run
+ */
+//#define STREAM_LOOP_EVENTS          64
+
+/************************************************************************/
+/*                               StreamCrc                              */
+/************************************************************************/
+
+/**
+ * @brief enable CRC32, CRC32C and CRC16 in StreamCrc.h, computed in place over both segments of buffer
+ */
+//#define STREAM_CRC                  (1 && STREAM_IO_VEC)
+/**
+ * @brief use slicing-by-8 tables for CRC32 and CRC32C (8KB), else one 1KB table per CRC
+ */
+//#define STREAM_CRC_SLICE8           1
+/**
+ * @brief use PCLMULQDQ folding for CRC32 and SSE4.2 crc32 instruction for CRC32C on x86,
+ * selected at run time when cpu support them
+ */
+//#define STREAM_CRC_SIMD             (1 && STREAM_MEM_SIMD)
+
+/************************************************************************/
+/*                            StreamPipeline                            */
+/************************************************************************/
+
+/**
+ * @brief enable Stream_Filter and Stream_Pipeline in StreamPipeline.h,
+ * chain of length changing filters between ring buffers
+ */
+//#define STREAM_PIPELINE             (1 && STREAM_WRITE && STREAM_READ)
+
+/************************************************************************/
+/*                              StreamCodec                             */
+/************************************************************************/
+
+/**
+ * @brief enable COBS framing in StreamCodec.h, encode into space of ring and decode frames from ring
+ */
+//#define STREAM_COBS                 (1 && STREAM_IO_VEC && STREAM_WRITE && STREAM_READ)
+/**
+ * @brief enable SLIP (RFC 1055) framing in StreamCodec.h, encode into space of ring and decode frames from ring
+ */
+//#define STREAM_SLIP                 (1 && STREAM_IO_VEC && STREAM_WRITE && STREAM_READ)
+
 #endif // _STREAM_USER_CONFIG_H_